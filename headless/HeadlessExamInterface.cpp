@@ -0,0 +1,109 @@
+#include "stdafx.h"
+#include "HeadlessExamInterface.h"
+#include "HeadlessWorld.h"
+
+HeadlessExamInterface::HeadlessExamInterface(HeadlessWorld* pWorld)
+	: m_pWorld{ pWorld }
+{
+}
+
+#pragma region World
+WorldInfo HeadlessExamInterface::World_GetInfo() const
+{
+	return m_pWorld->GetWorldInfo();
+}
+
+StatisticsInfo HeadlessExamInterface::World_GetStats() const
+{
+	return m_pWorld->GetStats();
+}
+
+bool HeadlessExamInterface::Fov_GetHouseByIndex(UINT index, HouseInfo& houseInfo) const
+{
+	return m_pWorld->GetHouseInFOV(index, houseInfo);
+}
+
+bool HeadlessExamInterface::Fov_GetEntityByIndex(UINT index, EntityInfo& enemyInfo) const
+{
+	return m_pWorld->GetEntityInFOV(index, enemyInfo);
+}
+
+AgentInfo HeadlessExamInterface::Agent_GetInfo() const
+{
+	return m_pWorld->GetAgentInfo();
+}
+
+bool HeadlessExamInterface::Enemy_GetInfo(EntityInfo entity, EnemyInfo& enemy)
+{
+	return m_pWorld->GetEnemyInfo(entity, enemy);
+}
+
+Elite::Vector2 HeadlessExamInterface::NavMesh_GetClosestPathPoint(Elite::Vector2 goal) const
+{
+	return m_pWorld->GetClosestPathPoint(goal);
+}
+#pragma endregion
+
+#pragma region Inventory
+bool HeadlessExamInterface::Inventory_AddItem(UINT slotId, ItemInfo item)
+{
+	return m_pWorld->AddInventoryItem(slotId, item);
+}
+
+bool HeadlessExamInterface::Inventory_UseItem(UINT slotId)
+{
+	return m_pWorld->UseInventoryItem(slotId);
+}
+
+bool HeadlessExamInterface::Inventory_RemoveItem(UINT slotId)
+{
+	return m_pWorld->RemoveInventoryItem(slotId);
+}
+
+bool HeadlessExamInterface::Inventory_GetItem(UINT slotId, ItemInfo& item)
+{
+	return m_pWorld->GetInventoryItem(slotId, item);
+}
+
+UINT HeadlessExamInterface::Inventory_GetCapacity() const
+{
+	return m_pWorld->GetInventoryCapacity();
+}
+#pragma endregion
+
+#pragma region Items
+bool HeadlessExamInterface::Item_GetInfo(EntityInfo entity, ItemInfo& item)
+{
+	return m_pWorld->GetItemInfo(entity, item);
+}
+
+bool HeadlessExamInterface::Item_Grab(EntityInfo entity, ItemInfo& item)
+{
+	return m_pWorld->GrabItem(entity, item);
+}
+
+bool HeadlessExamInterface::Item_Destroy(EntityInfo entity)
+{
+	return m_pWorld->DestroyItem(entity);
+}
+
+int HeadlessExamInterface::Weapon_GetAmmo(ItemInfo& item)
+{
+	return item.Type == eItemType::PISTOL ? m_pWorld->GetItemValue(item) : -1;
+}
+
+int HeadlessExamInterface::Medkit_GetHealth(ItemInfo& item)
+{
+	return item.Type == eItemType::MEDKIT ? m_pWorld->GetItemValue(item) : -1;
+}
+
+int HeadlessExamInterface::Food_GetEnergy(ItemInfo& item)
+{
+	return item.Type == eItemType::FOOD ? m_pWorld->GetItemValue(item) : -1;
+}
+
+bool HeadlessExamInterface::PurgeZone_GetInfo(EntityInfo entity, PurgeZoneInfo& zone)
+{
+	return m_pWorld->GetPurgeZoneInfo(entity, zone);
+}
+#pragma endregion
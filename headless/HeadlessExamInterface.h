@@ -0,0 +1,84 @@
+#pragma once
+#include "IExamInterface.h"
+
+class HeadlessWorld;
+
+//IExamInterface implementation that forwards every query to a HeadlessWorld
+//rendering, debug and input calls are no-ops since there is no window
+class HeadlessExamInterface final : public IExamInterface
+{
+public:
+	explicit HeadlessExamInterface(HeadlessWorld* pWorld);
+	~HeadlessExamInterface() = default;
+
+	bool IsShutdownRequested() const { return m_IsShutdownRequested; }
+
+	//WORLD & ENTITIES
+	WorldInfo World_GetInfo() const override;
+	StatisticsInfo World_GetStats() const override;
+
+	bool Fov_GetHouseByIndex(UINT index, HouseInfo& houseInfo) const override;
+	bool Fov_GetEntityByIndex(UINT index, EntityInfo& enemyInfo) const override;
+
+	AgentInfo Agent_GetInfo() const override;
+	bool Enemy_GetInfo(EntityInfo entity, EnemyInfo& enemy) override;
+
+	//NAVMESH
+	Elite::Vector2 NavMesh_GetClosestPathPoint(Elite::Vector2 goal) const override;
+
+	//INVENTORY
+	bool Inventory_AddItem(UINT slotId, ItemInfo item) override;
+	bool Inventory_UseItem(UINT slotId) override;
+	bool Inventory_RemoveItem(UINT slotId) override;
+	bool Inventory_GetItem(UINT slotId, ItemInfo& item) override;
+	UINT Inventory_GetCapacity() const override;
+
+	bool Item_GetInfo(EntityInfo entity, ItemInfo& item) override;
+	bool Item_Grab(EntityInfo entity, ItemInfo& item) override;
+	bool Item_Destroy(EntityInfo entity) override;
+
+	int Weapon_GetAmmo(ItemInfo& item) override;
+	int Medkit_GetHealth(ItemInfo& item) override;
+	int Food_GetEnergy(ItemInfo& item) override;
+
+	//PURGEZONE
+	bool PurgeZone_GetInfo(EntityInfo entity, PurgeZoneInfo& zone) override;
+
+	//DEBUG
+	Elite::Vector2 Debug_ConvertScreenToWorld(Elite::Vector2 screenPos) const override { return screenPos; }
+	Elite::Vector2 Debug_ConvertWorldToScreen(Elite::Vector2 worldPos) const override { return worldPos; }
+
+	//INPUT
+	bool Input_IsKeyboardKeyDown(Elite::InputScancode key) const override { return false; }
+	bool Input_IsKeyboardKeyUp(Elite::InputScancode key) const override { return false; }
+	bool Input_IsMouseButtonDown(Elite::InputMouseButton button) const override { return false; }
+	bool Input_IsMouseButtonUp(Elite::InputMouseButton button) const override { return false; }
+	Elite::MouseData Input_GetMouseData(Elite::InputType type, Elite::InputMouseButton button = Elite::InputMouseButton(0)) const override { return Elite::MouseData{}; }
+
+	//EVENT
+	void RequestShutdown() const override { m_IsShutdownRequested = true; }
+
+	//RENDERER
+	void Draw_Polygon(const Elite::Vector2* points, int count, const Elite::Vector3& color, float depth) override {}
+	void Draw_SolidPolygon(const Elite::Vector2* points, int count, const Elite::Vector3& color, float depth, bool triangulate = false) override {}
+	void Draw_Circle(const Elite::Vector2& center, float radius, const Elite::Vector3& color, float depth) override {}
+	void Draw_SolidCircle(const Elite::Vector2& center, float32 radius, const Elite::Vector2& axis, const Elite::Vector3& color, float depth) override {}
+	void Draw_Segment(const Elite::Vector2& p1, const Elite::Vector2& p2, const Elite::Vector3& color, float depth) override {}
+	void Draw_Direction(const Elite::Vector2& p, Elite::Vector2 dir, float length, const Elite::Vector3& color, float depth = 0.9f) override {}
+	void Draw_Transform(const b2Transform& xf, float depth) override {}
+	void Draw_Point(const Elite::Vector2& p, float size, const Elite::Vector3& color, float depth) override {}
+	float NextDepthSlice() override { return 0.f; }
+
+	//the non-virtual overloads are hidden by the overrides above, pull them back in
+	using IBaseInterface::Draw_Polygon;
+	using IBaseInterface::Draw_SolidPolygon;
+	using IBaseInterface::Draw_Circle;
+	using IBaseInterface::Draw_SolidCircle;
+	using IBaseInterface::Draw_Segment;
+	using IBaseInterface::Draw_Transform;
+	using IBaseInterface::Draw_Point;
+
+private:
+	HeadlessWorld* m_pWorld;
+	mutable bool m_IsShutdownRequested = false;
+};
@@ -0,0 +1,105 @@
+#include "stdafx.h"
+#include "HeadlessHost.h"
+#include "HeadlessWorld.h"
+#include "HeadlessExamInterface.h"
+#include "IExamPlugin.h"
+#include "RecordingExamInterface.h"
+#include "ReplayFile.h"
+
+//plugin entry point, same one the framework looks up in the dll
+extern "C" IPluginBase* Register();
+
+HeadlessHost::HeadlessHost(const HeadlessRunSettings& settings)
+	: m_Settings{ settings }
+{
+	m_pPlugin = static_cast<IExamPlugin*>(Register());
+	m_pPlugin->DllInit();
+
+	//apply the overrides before and after, so the plugin sees the same seed the world uses
+	GameDebugParams params{};
+	ApplyOverrides(params);
+	m_pPlugin->InitGameDebugParams(params);
+	ApplyOverrides(params);
+	m_Params = params;
+
+	m_pWorld = new HeadlessWorld(params);
+	m_pInterface = new HeadlessExamInterface(m_pWorld);
+
+	IExamInterface* pPluginInterface{ m_pInterface };
+	if (!m_Settings.RecordFile.empty())
+	{
+		m_pReplayWriter = new ReplayWriter();
+		if (m_pReplayWriter->Open(m_Settings.RecordFile, params.Seed, params.LevelFile))
+		{
+			m_pRecordingInterface = new RecordingExamInterface(m_pInterface, m_pReplayWriter);
+			pPluginInterface = m_pRecordingInterface;
+		}
+		else
+		{
+			SAFE_DELETE(m_pReplayWriter);
+		}
+	}
+
+	PluginInfo info{};
+	m_pPlugin->Initialize(pPluginInterface, info);
+	if (m_pRecordingInterface)
+	{
+		m_pRecordingInterface->EndFrame(0.f, SteeringPlugin_Output{});
+	}
+}
+
+HeadlessHost::~HeadlessHost()
+{
+	m_pPlugin->DllShutdown();
+	delete m_pPlugin;
+	delete m_pRecordingInterface;
+	//writes out the last chunk if Run didn't
+	delete m_pReplayWriter;
+	delete m_pInterface;
+	delete m_pWorld;
+}
+
+HeadlessRunResult HeadlessHost::Run()
+{
+	HeadlessRunResult result{};
+	const float dt{ m_Settings.DeltaTime };
+	while (IsRunning(result.FramesSimulated))
+	{
+		const SteeringPlugin_Output steering{ m_pPlugin->UpdateSteering(dt) };
+		if (m_pRecordingInterface)
+		{
+			m_pRecordingInterface->EndFrame(dt, steering);
+		}
+		m_pWorld->Step(dt, steering);
+		++result.FramesSimulated;
+	}
+
+	//the episode is over, get the last chunk out
+	if (m_pReplayWriter)
+	{
+		m_pReplayWriter->Close();
+	}
+
+	result.Seed = m_Params.Seed;
+	result.LevelFile = m_Params.LevelFile;
+	result.Stats = m_pWorld->GetStats();
+	result.AgentDied = m_pWorld->IsEpisodeOver();
+	return result;
+}
+
+bool HeadlessHost::IsRunning(int framesSimulated) const
+{
+	return framesSimulated < m_Settings.MaxFrames && !m_pWorld->IsEpisodeOver() && !m_pInterface->IsShutdownRequested();
+}
+
+void HeadlessHost::ApplyOverrides(GameDebugParams& params) const
+{
+	if (m_Settings.Seed >= 0)
+	{
+		params.Seed = m_Settings.Seed;
+	}
+	if (!m_Settings.LevelFile.empty())
+	{
+		params.LevelFile = m_Settings.LevelFile;
+	}
+}
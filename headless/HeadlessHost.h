@@ -0,0 +1,59 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+
+class IExamPlugin;
+class HeadlessWorld;
+class HeadlessExamInterface;
+class RecordingExamInterface;
+class ReplayWriter;
+
+struct HeadlessRunSettings
+{
+	float DeltaTime = 1.f / 60.f; //fixed simulation step
+	int MaxFrames = 60 * 60 * 10; //ten minutes of game time
+	int Seed = -1; //overrides GameDebugParams::Seed when not negative
+	std::string LevelFile = {}; //overrides GameDebugParams::LevelFile when not empty
+	std::string RecordFile = {}; //records every interface call into this replay file when not empty
+};
+
+struct HeadlessRunResult
+{
+	int Seed = 0;
+	std::string LevelFile = {};
+	StatisticsInfo Stats{};
+	int FramesSimulated = 0;
+	bool AgentDied = false;
+};
+
+//Drives a single plugin instance on a HeadlessWorld at a fixed timestep, without a window
+class HeadlessHost final
+{
+public:
+	explicit HeadlessHost(const HeadlessRunSettings& settings);
+	~HeadlessHost();
+
+	HeadlessRunResult Run();
+
+	//for tools that drive the frames themselves, Run() is UpdateSteering + World Step while IsRunning()
+	bool IsRunning(int framesSimulated) const;
+	IExamPlugin* GetPlugin() const { return m_pPlugin; }
+	HeadlessWorld* GetWorld() const { return m_pWorld; }
+	const HeadlessRunSettings& GetSettings() const { return m_Settings; }
+	//nullptr unless RecordFile is set and could be created
+	const ReplayWriter* GetReplayWriter() const { return m_pReplayWriter; }
+
+	HeadlessHost(const HeadlessHost& other) = delete;
+	HeadlessHost& operator=(const HeadlessHost& rhs) = delete;
+	HeadlessHost(HeadlessHost&& other) = delete;
+	HeadlessHost& operator=(HeadlessHost&& rhs) = delete;
+private:
+	void ApplyOverrides(GameDebugParams& params) const;
+
+	HeadlessRunSettings m_Settings;
+	GameDebugParams m_Params{};
+	IExamPlugin* m_pPlugin = nullptr;
+	HeadlessWorld* m_pWorld = nullptr;
+	HeadlessExamInterface* m_pInterface = nullptr;
+	ReplayWriter* m_pReplayWriter = nullptr;
+	RecordingExamInterface* m_pRecordingInterface = nullptr; //between the plugin and m_pInterface while recording
+};
@@ -0,0 +1,742 @@
+#include "stdafx.h"
+#include "HeadlessWorld.h"
+
+namespace
+{
+	//WORLD
+	const Elite::Vector2 worldDimensions{ 300.f, 300.f };
+	const int houseCount{ 12 };
+	const float purgeZoneInterval{ 40.f };
+	const float purgeZoneDelay{ 5.f };
+
+	//AGENT
+	const float agentMaxHealth{ 10.f };
+	const float agentMaxEnergy{ 10.f };
+	const float agentMaxStamina{ 10.f };
+	const float agentWalkSpeed{ 10.f };
+	const float agentRunMultiplier{ 2.f };
+	const float energyDrainPerSecond{ 0.1f };
+	const float starvationDamagePerSecond{ 0.5f };
+	const float staminaDrainPerSecond{ 2.f };
+	const float staminaRegenPerSecond{ 1.f };
+	const unsigned int inventoryCapacity{ 5 };
+
+	//ENEMIES
+	const float enemyDetectionRange{ 20.f };
+	const float enemyBiteDamage{ 1.f };
+	const float enemyBiteCooldown{ 1.f };
+	const float enemyWanderTurnRate{ 1.f };
+	const float minEnemySpawnDistance{ 30.f };
+
+	struct EnemyTemplate
+	{
+		float Speed;
+		float Size;
+		int Health;
+	};
+
+	EnemyTemplate GetEnemyTemplate(eEnemyType type)
+	{
+		switch (type)
+		{
+		case eEnemyType::ZOMBIE_RUNNER:
+			return { 6.f, 1.f, 1 };
+		case eEnemyType::ZOMBIE_HEAVY:
+			return { 2.f, 2.f, 6 };
+		default:
+			return { 3.f, 1.5f, 3 };
+		}
+	}
+
+	bool IsInsideRect(const Elite::Vector2& pos, const Elite::Vector2& center, const Elite::Vector2& size)
+	{
+		return abs(pos.x - center.x) <= size.x / 2.f && abs(pos.y - center.y) <= size.y / 2.f;
+	}
+
+	bool IsInsideFOV(const AgentInfo& agent, const Elite::Vector2& pos, float extraRange = 0.f)
+	{
+		const Elite::Vector2 toPos{ pos - agent.Position };
+		const float range{ agent.FOV_Range + extraRange };
+		if (toPos.SqrtMagnitude() > range * range)
+		{
+			return false;
+		}
+
+		const Elite::Vector2 lookDir{ Elite::OrientationToVector(agent.Orientation) };
+		const Elite::Vector2 dir{ toPos.GetNormalized() };
+		return Elite::Dot(lookDir, dir) >= cosf(agent.FOV_Angle / 2.f);
+	}
+}
+
+HeadlessWorld::HeadlessWorld(const GameDebugParams& params)
+	: m_Rng{ static_cast<unsigned int>(params.Seed) }
+	, m_Params{ params }
+{
+	m_WorldInfo.Center = Elite::ZeroVector2;
+	m_WorldInfo.Dimensions = worldDimensions;
+
+	m_Agent.Health = agentMaxHealth;
+	m_Agent.Energy = agentMaxEnergy;
+	m_Agent.Stamina = agentMaxStamina;
+	m_Agent.FOV_Angle = Elite::ToRadians(90.f);
+	m_Agent.FOV_Range = 20.f;
+	m_Agent.MaxLinearSpeed = agentWalkSpeed;
+	m_Agent.MaxAngularSpeed = Elite::ToRadians(180.f);
+	m_Agent.GrabRange = 3.f;
+	m_Agent.AgentSize = 1.f;
+	m_Agent.Position = m_WorldInfo.Center;
+
+	m_Inventory.resize(inventoryCapacity, InventorySlot{ Item{}, false });
+	m_GrabbedItems.reserve(inventoryCapacity);
+
+	if (!LoadLevel(m_Params.LevelFile))
+	{
+		GenerateHouses();
+	}
+	for (int i{ 0 }; i < m_Params.ItemCount; ++i)
+	{
+		SpawnItem();
+	}
+	if (m_Params.SpawnEnemies)
+	{
+		for (int i{ 0 }; i < m_Params.EnemyCount; ++i)
+		{
+			SpawnEnemy();
+		}
+	}
+
+	UpdateFOV();
+}
+
+void HeadlessWorld::Step(float dt, const SteeringPlugin_Output& steering)
+{
+	if (m_Agent.Death)
+	{
+		return;
+	}
+
+	UpdateAgent(dt, steering);
+	UpdateEnemies(dt);
+	UpdatePurgeZones(dt);
+
+	if (m_Params.GodMode)
+	{
+		m_Agent.Health = agentMaxHealth;
+	}
+	m_Agent.Death = m_Agent.Health <= 0.f;
+
+	m_Stats.TimeSurvived += dt;
+	m_Stats.Difficulty = m_Stats.TimeSurvived / 120.f;
+	m_Stats.Score = int(m_Stats.TimeSurvived) + 10 * m_Stats.NumEnemiesKilled + 2 * m_Stats.NumItemsPickUp;
+
+	UpdateFOV();
+}
+
+#pragma region FOV
+bool HeadlessWorld::GetHouseInFOV(unsigned int index, HouseInfo& houseInfo) const
+{
+	if (index >= m_HousesInFOV.size())
+	{
+		return false;
+	}
+
+	houseInfo = m_HousesInFOV[index];
+	return true;
+}
+
+bool HeadlessWorld::GetEntityInFOV(unsigned int index, EntityInfo& entityInfo) const
+{
+	if (index >= m_EntitiesInFOV.size())
+	{
+		return false;
+	}
+
+	entityInfo = m_EntitiesInFOV[index];
+	return true;
+}
+
+void HeadlessWorld::UpdateFOV()
+{
+	m_HousesInFOV.clear();
+	const auto addHouseIfVisible = [this](const HouseInfo& house)
+	{
+		//use the house radius as extra range so big houses are seen from their edge
+		if (IsInsideRect(m_Agent.Position, house.Center, house.Size) || IsInsideFOV(m_Agent, house.Center, house.Size.Magnitude() / 2.f))
+		{
+			m_HousesInFOV.push_back(house);
+		}
+	};
+	if (m_LevelIndex.IsEmpty())
+	{
+		std::for_each(m_Houses.begin(), m_Houses.end(), addHouseIfVisible);
+	}
+	else
+	{
+		//only look at houses near the view range instead of every house in the level
+		const float range{ m_Agent.FOV_Range };
+		b2AABB fovBox{};
+		fovBox.lowerBound = b2Vec2{ m_Agent.Position.x - range, m_Agent.Position.y - range };
+		fovBox.upperBound = b2Vec2{ m_Agent.Position.x + range, m_Agent.Position.y + range };
+		m_LevelIndex.QueryHouses(fovBox, [this, &addHouseIfVisible](int houseIdx)
+		{
+			addHouseIfVisible(m_Houses[houseIdx]);
+			return true;
+		});
+	}
+
+	m_EntitiesInFOV.clear();
+	for (const PurgeZone& zone : m_PurgeZones)
+	{
+		if (IsVisible(zone.Info.Center, zone.Info.Radius))
+		{
+			m_EntitiesInFOV.push_back(EntityInfo{ eEntityType::PURGEZONE, zone.Info.Center, zone.Info.ZoneHash });
+		}
+	}
+	for (const Enemy& enemy : m_Enemies)
+	{
+		if (IsVisible(enemy.Info.Location))
+		{
+			m_EntitiesInFOV.push_back(EntityInfo{ eEntityType::ENEMY, enemy.Info.Location, enemy.Info.EnemyHash });
+		}
+	}
+	for (const Item& item : m_Items)
+	{
+		if (IsVisible(item.Info.Location))
+		{
+			m_EntitiesInFOV.push_back(EntityInfo{ eEntityType::ITEM, item.Info.Location, item.Info.ItemHash });
+		}
+	}
+}
+#pragma endregion
+
+#pragma region Entities
+bool HeadlessWorld::GetEnemyInfo(const EntityInfo& entity, EnemyInfo& enemyInfo) const
+{
+	for (const Enemy& enemy : m_Enemies)
+	{
+		if (enemy.Info.EnemyHash == entity.EntityHash)
+		{
+			enemyInfo = enemy.Info;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool HeadlessWorld::GetItemInfo(const EntityInfo& entity, ItemInfo& itemInfo) const
+{
+	for (const Item& item : m_Items)
+	{
+		if (item.Info.ItemHash == entity.EntityHash)
+		{
+			itemInfo = item.Info;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool HeadlessWorld::GetPurgeZoneInfo(const EntityInfo& entity, PurgeZoneInfo& zoneInfo) const
+{
+	for (const PurgeZone& zone : m_PurgeZones)
+	{
+		if (zone.Info.ZoneHash == entity.EntityHash)
+		{
+			zoneInfo = zone.Info;
+			return true;
+		}
+	}
+	return false;
+}
+
+bool HeadlessWorld::GrabItem(const EntityInfo& entity, ItemInfo& itemInfo)
+{
+	const float grabRangeSq{ m_Agent.GrabRange * m_Agent.GrabRange };
+	int grabIdx{ -1 };
+	float closestDistSq{ FLT_MAX };
+	for (int i{ 0 }; i < int(m_Items.size()); ++i)
+	{
+		const float distSq{ Elite::DistanceSquared(m_Items[i].Info.Location, m_Agent.Position) };
+		if (distSq > grabRangeSq)
+		{
+			continue;
+		}
+
+		if (m_Params.AutoGrabClosestItem)
+		{
+			if (distSq < closestDistSq)
+			{
+				closestDistSq = distSq;
+				grabIdx = i;
+			}
+		}
+		else if (m_Items[i].Info.ItemHash == entity.EntityHash)
+		{
+			grabIdx = i;
+			break;
+		}
+	}
+
+	if (grabIdx == -1)
+	{
+		return false;
+	}
+
+	itemInfo = m_Items[grabIdx].Info;
+	m_GrabbedItems.push_back(m_Items[grabIdx]);
+	m_Items.erase(m_Items.begin() + grabIdx);
+	++m_Stats.NumItemsPickUp;
+	SpawnItem();
+	return true;
+}
+
+bool HeadlessWorld::DestroyItem(const EntityInfo& entity)
+{
+	const float grabRangeSq{ m_Agent.GrabRange * m_Agent.GrabRange };
+	for (auto it = m_Items.begin(); it != m_Items.end(); ++it)
+	{
+		if (it->Info.ItemHash == entity.EntityHash && Elite::DistanceSquared(it->Info.Location, m_Agent.Position) <= grabRangeSq)
+		{
+			m_Items.erase(it);
+			SpawnItem();
+			return true;
+		}
+	}
+	return false;
+}
+
+int HeadlessWorld::GetItemValue(const ItemInfo& itemInfo) const
+{
+	for (const InventorySlot& slot : m_Inventory)
+	{
+		if (slot.IsUsed && slot.SlotItem.Info.ItemHash == itemInfo.ItemHash)
+		{
+			return slot.SlotItem.Value;
+		}
+	}
+	for (const Item& item : m_GrabbedItems)
+	{
+		if (item.Info.ItemHash == itemInfo.ItemHash)
+		{
+			return item.Value;
+		}
+	}
+	for (const Item& item : m_Items)
+	{
+		if (item.Info.ItemHash == itemInfo.ItemHash)
+		{
+			return item.Value;
+		}
+	}
+	return 0;
+}
+#pragma endregion
+
+#pragma region NavMesh
+Elite::Vector2 HeadlessWorld::GetClosestPathPoint(Elite::Vector2 goal) const
+{
+	//there are no walls, so the only detour is entering a house from its closest side
+	const HouseInfo* pGoalHouse{ GetHouseAt(goal) };
+	if (!pGoalHouse || GetHouseAt(m_Agent.Position) == pGoalHouse)
+	{
+		return goal;
+	}
+
+	const float doorDepth{ 1.5f };
+	const Elite::Vector2 halfSize{ pGoalHouse->Size.x / 2.f - doorDepth, pGoalHouse->Size.y / 2.f - doorDepth };
+	Elite::Vector2 pathPoint{ m_Agent.Position };
+	pathPoint.x = Elite::Clamp(pathPoint.x, pGoalHouse->Center.x - halfSize.x, pGoalHouse->Center.x + halfSize.x);
+	pathPoint.y = Elite::Clamp(pathPoint.y, pGoalHouse->Center.y - halfSize.y, pGoalHouse->Center.y + halfSize.y);
+	return pathPoint;
+}
+#pragma endregion
+
+#pragma region Inventory
+bool HeadlessWorld::AddInventoryItem(unsigned int slotId, const ItemInfo& itemInfo)
+{
+	if (slotId >= m_Inventory.size() || m_Inventory[slotId].IsUsed)
+	{
+		return false;
+	}
+
+	for (auto it = m_GrabbedItems.begin(); it != m_GrabbedItems.end(); ++it)
+	{
+		if (it->Info.ItemHash == itemInfo.ItemHash)
+		{
+			m_Inventory[slotId] = InventorySlot{ *it, true };
+			m_GrabbedItems.erase(it);
+			return true;
+		}
+	}
+	return false;
+}
+
+bool HeadlessWorld::UseInventoryItem(unsigned int slotId)
+{
+	if (slotId >= m_Inventory.size() || !m_Inventory[slotId].IsUsed)
+	{
+		return false;
+	}
+
+	Item& item{ m_Inventory[slotId].SlotItem };
+	switch (item.Info.Type)
+	{
+	case eItemType::PISTOL:
+		if (item.Value <= 0)
+		{
+			return false;
+		}
+		FireWeapon(item);
+		break;
+	case eItemType::MEDKIT:
+		m_Agent.Health = std::min(agentMaxHealth, m_Agent.Health + item.Value);
+		item.Value = 0;
+		break;
+	case eItemType::FOOD:
+		m_Agent.Energy = std::min(agentMaxEnergy, m_Agent.Energy + item.Value);
+		item.Value = 0;
+		break;
+	default:
+		return false;
+	}
+	return true;
+}
+
+bool HeadlessWorld::RemoveInventoryItem(unsigned int slotId)
+{
+	if (slotId >= m_Inventory.size() || !m_Inventory[slotId].IsUsed)
+	{
+		return false;
+	}
+
+	m_Inventory[slotId].IsUsed = false;
+	return true;
+}
+
+bool HeadlessWorld::GetInventoryItem(unsigned int slotId, ItemInfo& itemInfo) const
+{
+	if (slotId >= m_Inventory.size() || !m_Inventory[slotId].IsUsed)
+	{
+		return false;
+	}
+
+	itemInfo = m_Inventory[slotId].SlotItem.Info;
+	return true;
+}
+
+void HeadlessWorld::FireWeapon(Item& weapon)
+{
+	--weapon.Value;
+
+	//hit the closest enemy whose circle intersects the aim ray
+	const Elite::Vector2 aimDir{ Elite::OrientationToVector(m_Agent.Orientation) };
+	int hitIdx{ -1 };
+	float closestHit{ m_Agent.FOV_Range };
+	for (int i{ 0 }; i < int(m_Enemies.size()); ++i)
+	{
+		const EnemyInfo& enemy{ m_Enemies[i].Info };
+		const Elite::Vector2 toEnemy{ enemy.Location - m_Agent.Position };
+		const float along{ Elite::Dot(toEnemy, aimDir) };
+		if (along <= 0.f || along >= closestHit)
+		{
+			continue;
+		}
+
+		const float perp{ Elite::Cross(aimDir, toEnemy) };
+		if (abs(perp) <= enemy.Size && !m_LevelIndex.RayCastWalls(m_Agent.Position, enemy.Location))
+		{
+			closestHit = along;
+			hitIdx = i;
+		}
+	}
+
+	if (hitIdx == -1)
+	{
+		++m_Stats.NumMissedShots;
+		return;
+	}
+
+	++m_Stats.NumEnemiesHit;
+	if (--m_Enemies[hitIdx].Info.Health <= 0)
+	{
+		++m_Stats.NumEnemiesKilled;
+		m_Enemies.erase(m_Enemies.begin() + hitIdx);
+		SpawnEnemy();
+	}
+}
+#pragma endregion
+
+#pragma region Update
+void HeadlessWorld::UpdateAgent(float dt, const SteeringPlugin_Output& steering)
+{
+	//stamina
+	const bool canRun{ steering.RunMode && (m_Params.InfiniteStamina || m_Agent.Stamina > 0.f) };
+	if (canRun && !m_Params.InfiniteStamina)
+	{
+		m_Agent.Stamina = std::max(0.f, m_Agent.Stamina - staminaDrainPerSecond * dt);
+	}
+	else if (!canRun)
+	{
+		m_Agent.Stamina = std::min(agentMaxStamina, m_Agent.Stamina + staminaRegenPerSecond * dt);
+	}
+	m_Agent.RunMode = canRun;
+
+	//movement
+	const float maxSpeed{ m_Agent.MaxLinearSpeed * (canRun ? agentRunMultiplier : 1.f) };
+	Elite::Vector2 velocity{ steering.LinearVelocity };
+	if (velocity.SqrtMagnitude() > maxSpeed * maxSpeed)
+	{
+		velocity = velocity.GetNormalized() * maxSpeed;
+	}
+	m_Agent.LinearVelocity = velocity;
+	m_Agent.CurrentLinearSpeed = velocity.Magnitude();
+	m_Agent.Position += velocity * dt;
+
+	if (steering.AutoOrient)
+	{
+		m_Agent.AngularVelocity = 0.f;
+		if (m_Agent.CurrentLinearSpeed > 0.f)
+		{
+			m_Agent.Orientation = Elite::GetOrientationFromVelocity(velocity);
+		}
+	}
+	else
+	{
+		m_Agent.AngularVelocity = Elite::Clamp(steering.AngularVelocity, -m_Agent.MaxAngularSpeed, m_Agent.MaxAngularSpeed);
+		m_Agent.Orientation += m_Agent.AngularVelocity * dt;
+	}
+
+	m_Agent.IsInHouse = GetHouseAt(m_Agent.Position) != nullptr;
+
+	//energy
+	if (!m_Params.IgnoreEnergy)
+	{
+		m_Agent.Energy = std::max(0.f, m_Agent.Energy - energyDrainPerSecond * dt);
+		if (m_Agent.Energy <= 0.f)
+		{
+			m_Agent.Health -= starvationDamagePerSecond * dt;
+		}
+	}
+
+	//bitten only stays true for the frame the bite happened
+	m_Agent.WasBitten = m_Agent.Bitten;
+	m_Agent.Bitten = false;
+}
+
+void HeadlessWorld::UpdateEnemies(float dt)
+{
+	const float detectionRangeSq{ enemyDetectionRange * enemyDetectionRange };
+	for (Enemy& enemy : m_Enemies)
+	{
+		const EnemyTemplate enemyTemplate{ GetEnemyTemplate(enemy.Info.Type) };
+		const Elite::Vector2 toAgent{ m_Agent.Position - enemy.Info.Location };
+		if (toAgent.SqrtMagnitude() <= detectionRangeSq)
+		{
+			enemy.Info.LinearVelocity = toAgent.GetNormalized() * enemyTemplate.Speed;
+		}
+		else
+		{
+			enemy.WanderAngle += RandomRange(-enemyWanderTurnRate, enemyWanderTurnRate) * dt;
+			enemy.Info.LinearVelocity = Elite::OrientationToVector(enemy.WanderAngle) * (enemyTemplate.Speed / 2.f);
+		}
+		enemy.Info.Location += enemy.Info.LinearVelocity * dt;
+
+		//keep enemies inside the world bounds
+		const Elite::Vector2 halfDim{ m_WorldInfo.Dimensions.x / 2.f, m_WorldInfo.Dimensions.y / 2.f };
+		enemy.Info.Location.x = Elite::Clamp(enemy.Info.Location.x, m_WorldInfo.Center.x - halfDim.x, m_WorldInfo.Center.x + halfDim.x);
+		enemy.Info.Location.y = Elite::Clamp(enemy.Info.Location.y, m_WorldInfo.Center.y - halfDim.y, m_WorldInfo.Center.y + halfDim.y);
+
+		enemy.BiteCooldown = std::max(0.f, enemy.BiteCooldown - dt);
+		const float biteRange{ enemy.Info.Size + m_Agent.AgentSize };
+		if (enemy.BiteCooldown <= 0.f && toAgent.SqrtMagnitude() <= biteRange * biteRange)
+		{
+			m_Agent.Health -= enemyBiteDamage;
+			m_Agent.Bitten = true;
+			enemy.BiteCooldown = enemyBiteCooldown;
+		}
+	}
+}
+
+void HeadlessWorld::UpdatePurgeZones(float dt)
+{
+	m_PurgeZoneTimer += dt;
+	if (m_PurgeZoneTimer >= purgeZoneInterval)
+	{
+		m_PurgeZoneTimer = 0.f;
+		SpawnPurgeZone();
+	}
+
+	for (auto it = m_PurgeZones.begin(); it != m_PurgeZones.end();)
+	{
+		it->TimeToPurge -= dt;
+		if (it->TimeToPurge > 0.f)
+		{
+			++it;
+			continue;
+		}
+
+		//purge everything inside the zone
+		const float radiusSq{ it->Info.Radius * it->Info.Radius };
+		if (Elite::DistanceSquared(it->Info.Center, m_Agent.Position) <= radiusSq)
+		{
+			m_Agent.Health = 0.f;
+		}
+		const Elite::Vector2 center{ it->Info.Center };
+		const size_t prevEnemyCount{ m_Enemies.size() };
+		m_Enemies.erase(std::remove_if(m_Enemies.begin(), m_Enemies.end(),
+			[&center, radiusSq](const Enemy& enemy) { return Elite::DistanceSquared(center, enemy.Info.Location) <= radiusSq; }),
+			m_Enemies.end());
+		for (size_t i{ m_Enemies.size() }; i < prevEnemyCount; ++i)
+		{
+			SpawnEnemy();
+		}
+
+		it = m_PurgeZones.erase(it);
+	}
+}
+#pragma endregion
+
+#pragma region Spawning
+bool HeadlessWorld::LoadLevel(const std::string& levelFile)
+{
+	if (levelFile.empty() || !m_Level.Open(levelFile))
+	{
+		return false;
+	}
+
+	m_WorldInfo.Dimensions = m_Level.GetWorldSize();
+	m_Houses.reserve(m_Level.GetNrHouses());
+	for (unsigned int i{ 0 }; i < m_Level.GetNrHouses(); ++i)
+	{
+		m_Houses.push_back(m_Level.GetHouse(i));
+	}
+	m_LevelIndex.Build(m_Level);
+	return true;
+}
+
+void HeadlessWorld::GenerateHouses()
+{
+	const int maxAttempts{ 100 };
+	const float spacing{ 10.f };
+	for (int i{ 0 }; i < houseCount; ++i)
+	{
+		for (int attempt{ 0 }; attempt < maxAttempts; ++attempt)
+		{
+			HouseInfo house{};
+			house.Size = Elite::Vector2{ RandomRange(15.f, 40.f), RandomRange(15.f, 30.f) };
+			house.Center = GetRandomPosition(house.Size.Magnitude());
+
+			const bool overlaps{ std::any_of(m_Houses.begin(), m_Houses.end(), [&house, spacing](const HouseInfo& other)
+			{
+				return abs(house.Center.x - other.Center.x) * 2.f < house.Size.x + other.Size.x + spacing
+					&& abs(house.Center.y - other.Center.y) * 2.f < house.Size.y + other.Size.y + spacing;
+			}) };
+			//keep the spawn point free
+			if (!overlaps && !IsInsideRect(m_Agent.Position, house.Center, house.Size + Elite::Vector2{ spacing, spacing }))
+			{
+				m_Houses.push_back(house);
+				break;
+			}
+		}
+	}
+}
+
+void HeadlessWorld::SpawnEnemy()
+{
+	Enemy enemy{};
+	enemy.Info.Type = eEnemyType(std::uniform_int_distribution<int>{ int(eEnemyType::ZOMBIE_NORMAL), int(eEnemyType::ZOMBIE_HEAVY) }(m_Rng));
+	const EnemyTemplate enemyTemplate{ GetEnemyTemplate(enemy.Info.Type) };
+	enemy.Info.Size = enemyTemplate.Size;
+	enemy.Info.Health = enemyTemplate.Health;
+	enemy.Info.EnemyHash = m_NextHash++;
+	enemy.WanderAngle = RandomRange(0.f, 2.f * float(E_PI));
+
+	//don't spawn enemies on top of the agent
+	do
+	{
+		enemy.Info.Location = GetRandomPosition(0.f);
+	} while (Elite::DistanceSquared(enemy.Info.Location, m_Agent.Position) < minEnemySpawnDistance * minEnemySpawnDistance);
+
+	m_Enemies.push_back(enemy);
+}
+
+void HeadlessWorld::SpawnItem()
+{
+	Item item{};
+	item.Info.Type = eItemType(std::uniform_int_distribution<int>{ int(eItemType::PISTOL), int(eItemType::GARBAGE) }(m_Rng));
+	item.Info.ItemHash = m_NextHash++;
+	switch (item.Info.Type)
+	{
+	case eItemType::PISTOL:
+		item.Value = std::uniform_int_distribution<int>{ 5, 20 }(m_Rng);
+		break;
+	case eItemType::MEDKIT:
+	case eItemType::FOOD:
+		item.Value = std::uniform_int_distribution<int>{ 1, 5 }(m_Rng);
+		break;
+	default:
+		item.Value = 0;
+		break;
+	}
+
+	//items only spawn inside houses, unless there are none
+	if (m_Houses.empty())
+	{
+		item.Info.Location = GetRandomPosition(0.f);
+	}
+	else
+	{
+		const HouseInfo& house{ m_Houses[std::uniform_int_distribution<size_t>{ 0, m_Houses.size() - 1 }(m_Rng)] };
+		item.Info.Location.x = house.Center.x + RandomRange(-house.Size.x / 3.f, house.Size.x / 3.f);
+		item.Info.Location.y = house.Center.y + RandomRange(-house.Size.y / 3.f, house.Size.y / 3.f);
+	}
+
+	m_Items.push_back(item);
+}
+
+void HeadlessWorld::SpawnPurgeZone()
+{
+	PurgeZone zone{};
+	zone.Info.Center = GetRandomPosition(0.f);
+	zone.Info.Radius = RandomRange(15.f, 25.f);
+	zone.Info.ZoneHash = m_NextHash++;
+	zone.TimeToPurge = purgeZoneDelay;
+	m_PurgeZones.push_back(zone);
+}
+#pragma endregion
+
+#pragma region Helpers
+const HouseInfo* HeadlessWorld::GetHouseAt(const Elite::Vector2& pos) const
+{
+	if (!m_LevelIndex.IsEmpty())
+	{
+		const int houseIdx{ m_LevelIndex.FindHouseAt(pos) };
+		return houseIdx == -1 ? nullptr : &m_Houses[houseIdx];
+	}
+
+	for (const HouseInfo& house : m_Houses)
+	{
+		if (IsInsideRect(pos, house.Center, house.Size))
+		{
+			return &house;
+		}
+	}
+	return nullptr;
+}
+
+bool HeadlessWorld::IsVisible(const Elite::Vector2& pos, float extraRange) const
+{
+	return IsInsideFOV(m_Agent, pos, extraRange) && !m_LevelIndex.RayCastWalls(m_Agent.Position, pos);
+}
+
+Elite::Vector2 HeadlessWorld::GetRandomPosition(float border)
+{
+	const Elite::Vector2 halfDim{ m_WorldInfo.Dimensions.x / 2.f - border, m_WorldInfo.Dimensions.y / 2.f - border };
+	return Elite::Vector2{ m_WorldInfo.Center.x + RandomRange(-halfDim.x, halfDim.x), m_WorldInfo.Center.y + RandomRange(-halfDim.y, halfDim.y) };
+}
+
+float HeadlessWorld::RandomRange(float min, float max)
+{
+	return std::uniform_real_distribution<float>{ min, max }(m_Rng);
+}
+#pragma endregion
@@ -0,0 +1,106 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+#include "LevelFile.h"
+#include "LevelSpatialIndex.h"
+
+//Simple kinematic stand-in for the exam framework world
+//no physics, agent and enemies move straight along their velocity
+//houses come from GameDebugParams::LevelFile when it can be loaded, its walls block sight and shots but not movement
+class HeadlessWorld final
+{
+public:
+	explicit HeadlessWorld(const GameDebugParams& params);
+
+	void Step(float dt, const SteeringPlugin_Output& steering);
+	bool IsEpisodeOver() const { return m_Agent.Death; }
+
+	const WorldInfo& GetWorldInfo() const { return m_WorldInfo; }
+	const StatisticsInfo& GetStats() const { return m_Stats; }
+	const AgentInfo& GetAgentInfo() const { return m_Agent; }
+
+	//FOV
+	bool GetHouseInFOV(unsigned int index, HouseInfo& houseInfo) const;
+	bool GetEntityInFOV(unsigned int index, EntityInfo& entityInfo) const;
+
+	//ENTITIES
+	bool GetEnemyInfo(const EntityInfo& entity, EnemyInfo& enemyInfo) const;
+	bool GetItemInfo(const EntityInfo& entity, ItemInfo& itemInfo) const;
+	bool GetPurgeZoneInfo(const EntityInfo& entity, PurgeZoneInfo& zoneInfo) const;
+	bool GrabItem(const EntityInfo& entity, ItemInfo& itemInfo);
+	bool DestroyItem(const EntityInfo& entity);
+	int GetItemValue(const ItemInfo& itemInfo) const;
+
+	//NAVMESH
+	Elite::Vector2 GetClosestPathPoint(Elite::Vector2 goal) const;
+
+	//INVENTORY
+	bool AddInventoryItem(unsigned int slotId, const ItemInfo& itemInfo);
+	bool UseInventoryItem(unsigned int slotId);
+	bool RemoveInventoryItem(unsigned int slotId);
+	bool GetInventoryItem(unsigned int slotId, ItemInfo& itemInfo) const;
+	unsigned int GetInventoryCapacity() const { return static_cast<unsigned int>(m_Inventory.size()); }
+
+private:
+	struct Enemy
+	{
+		EnemyInfo Info;
+		float BiteCooldown;
+		float WanderAngle;
+	};
+
+	struct Item
+	{
+		ItemInfo Info;
+		int Value; //ammo, health or energy depending on the type
+	};
+
+	struct InventorySlot
+	{
+		Item SlotItem;
+		bool IsUsed;
+	};
+
+	struct PurgeZone
+	{
+		PurgeZoneInfo Info;
+		float TimeToPurge;
+	};
+
+	bool LoadLevel(const std::string& levelFile);
+	void GenerateHouses();
+	void SpawnEnemy();
+	void SpawnItem();
+	void SpawnPurgeZone();
+
+	void UpdateAgent(float dt, const SteeringPlugin_Output& steering);
+	void UpdateEnemies(float dt);
+	void UpdatePurgeZones(float dt);
+	void UpdateFOV();
+
+	void FireWeapon(Item& weapon);
+	const HouseInfo* GetHouseAt(const Elite::Vector2& pos) const;
+	bool IsVisible(const Elite::Vector2& pos, float extraRange = 0.f) const;
+	Elite::Vector2 GetRandomPosition(float border);
+	float RandomRange(float min, float max);
+
+	std::mt19937 m_Rng;
+	GameDebugParams m_Params;
+	WorldInfo m_WorldInfo{};
+	StatisticsInfo m_Stats{};
+	AgentInfo m_Agent{};
+	int m_NextHash = 1;
+	float m_PurgeZoneTimer = 0.f;
+
+	LevelFile m_Level;
+	LevelSpatialIndex m_LevelIndex;
+	std::vector<HouseInfo> m_Houses;
+	std::vector<Enemy> m_Enemies;
+	std::vector<Item> m_Items;
+	std::vector<Item> m_GrabbedItems; //grabbed but not yet added to the inventory
+	std::vector<PurgeZone> m_PurgeZones;
+	std::vector<InventorySlot> m_Inventory;
+
+	//rebuilt after every step, the FOV getters only index into these
+	std::vector<HouseInfo> m_HousesInFOV;
+	std::vector<EntityInfo> m_EntitiesInFOV;
+};
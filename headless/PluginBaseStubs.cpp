@@ -0,0 +1,46 @@
+#include "stdafx.h"
+#include "IExamInterface.h"
+
+//GPP_PluginBase.lib provides these for the Windows host
+//headless builds don't link against it, so define the non-virtual parts of the interfaces here
+
+IBaseInterface::IBaseInterface() {}
+IBaseInterface::~IBaseInterface() {}
+
+void IBaseInterface::Draw_Polygon(const Elite::Vector2* points, int count, const Elite::Vector3& color)
+{
+	Draw_Polygon(points, count, color, NextDepthSlice());
+}
+
+void IBaseInterface::Draw_SolidPolygon(const Elite::Vector2* points, int count, const Elite::Vector3& color)
+{
+	Draw_SolidPolygon(points, count, color, NextDepthSlice());
+}
+
+void IBaseInterface::Draw_Circle(const Elite::Vector2& center, float radius, const Elite::Vector3& color)
+{
+	Draw_Circle(center, radius, color, NextDepthSlice());
+}
+
+void IBaseInterface::Draw_SolidCircle(const Elite::Vector2& center, float32 radius, const Elite::Vector2& axis, const Elite::Vector3& color)
+{
+	Draw_SolidCircle(center, radius, axis, color, NextDepthSlice());
+}
+
+void IBaseInterface::Draw_Segment(const Elite::Vector2& p1, const Elite::Vector2& p2, const Elite::Vector3& color)
+{
+	Draw_Segment(p1, p2, color, NextDepthSlice());
+}
+
+void IBaseInterface::Draw_Transform(const b2Transform& xf)
+{
+	Draw_Transform(xf, NextDepthSlice());
+}
+
+void IBaseInterface::Draw_Point(const Elite::Vector2& p, float size, const Elite::Vector3& color)
+{
+	Draw_Point(p, size, color, NextDepthSlice());
+}
+
+IExamInterface::IExamInterface() {}
+IExamInterface::~IExamInterface() {}
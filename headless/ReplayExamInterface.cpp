@@ -0,0 +1,210 @@
+#include "stdafx.h"
+#include "ReplayExamInterface.h"
+
+ReplayExamInterface::ReplayExamInterface(ReplayReader* pReader)
+	: m_pReader{ pReader }
+{
+}
+
+template<typename... TArgs>
+bool ReplayExamInterface::Expect(eReplayCall call, const TArgs&... args) const
+{
+	if (m_IsDiverged)
+	{
+		return false;
+	}
+
+	eReplayCall recordedCall{ eReplayCall::_COUNT };
+	const bool isMatching{ m_pReader->Read(recordedCall) && recordedCall == call && (IsArgMatching(args) && ...) };
+	if (!isMatching)
+	{
+		m_IsDiverged = true;
+		m_DivergedFrame = m_pReader->GetFrameIdx();
+		m_DivergedCall = call;
+		m_RecordedCall = recordedCall;
+	}
+	return isMatching;
+}
+
+template<typename TArg>
+bool ReplayExamInterface::IsArgMatching(const TArg& arg) const
+{
+	TArg recordedArg{};
+	return m_pReader->Read(recordedArg) && memcmp(&recordedArg, &arg, sizeof(TArg)) == 0;
+}
+
+template<typename... TAnswers>
+void ReplayExamInterface::Answer(TAnswers&... answers) const
+{
+	(m_pReader->Read(answers), ...);
+}
+
+bool ReplayExamInterface::CheckSteering(const SteeringPlugin_Output& steering)
+{
+	SteeringPlugin_Output recorded{};
+	if (!Expect(eReplayCall::STEERING_OUTPUT))
+	{
+		return false;
+	}
+	Answer(recorded);
+	return recorded.LinearVelocity == steering.LinearVelocity && recorded.AngularVelocity == steering.AngularVelocity
+		&& recorded.AutoOrient == steering.AutoOrient && recorded.RunMode == steering.RunMode;
+}
+
+#pragma region World
+WorldInfo ReplayExamInterface::World_GetInfo() const
+{
+	WorldInfo worldInfo{};
+	if (Expect(eReplayCall::WORLD_GET_INFO))
+		Answer(worldInfo);
+	return worldInfo;
+}
+
+StatisticsInfo ReplayExamInterface::World_GetStats() const
+{
+	StatisticsInfo stats{};
+	if (Expect(eReplayCall::WORLD_GET_STATS))
+		Answer(stats);
+	return stats;
+}
+
+bool ReplayExamInterface::Fov_GetHouseByIndex(UINT index, HouseInfo& houseInfo) const
+{
+	bool isValid{ false };
+	if (Expect(eReplayCall::FOV_GET_HOUSE_BY_INDEX, index))
+		Answer(isValid, houseInfo);
+	return isValid;
+}
+
+bool ReplayExamInterface::Fov_GetEntityByIndex(UINT index, EntityInfo& enemyInfo) const
+{
+	bool isValid{ false };
+	if (Expect(eReplayCall::FOV_GET_ENTITY_BY_INDEX, index))
+		Answer(isValid, enemyInfo);
+	return isValid;
+}
+
+AgentInfo ReplayExamInterface::Agent_GetInfo() const
+{
+	AgentInfo agentInfo{};
+	if (Expect(eReplayCall::AGENT_GET_INFO))
+		Answer(agentInfo);
+	return agentInfo;
+}
+
+bool ReplayExamInterface::Enemy_GetInfo(EntityInfo entity, EnemyInfo& enemy)
+{
+	bool isValid{ false };
+	if (Expect(eReplayCall::ENEMY_GET_INFO, entity))
+		Answer(isValid, enemy);
+	return isValid;
+}
+
+Elite::Vector2 ReplayExamInterface::NavMesh_GetClosestPathPoint(Elite::Vector2 goal) const
+{
+	Elite::Vector2 pathPoint{};
+	if (Expect(eReplayCall::NAVMESH_GET_CLOSEST_PATH_POINT, goal))
+		Answer(pathPoint);
+	return pathPoint;
+}
+#pragma endregion
+
+#pragma region Inventory
+bool ReplayExamInterface::Inventory_AddItem(UINT slotId, ItemInfo item)
+{
+	bool isAdded{ false };
+	if (Expect(eReplayCall::INVENTORY_ADD_ITEM, slotId, item))
+		Answer(isAdded);
+	return isAdded;
+}
+
+bool ReplayExamInterface::Inventory_UseItem(UINT slotId)
+{
+	bool isUsed{ false };
+	if (Expect(eReplayCall::INVENTORY_USE_ITEM, slotId))
+		Answer(isUsed);
+	return isUsed;
+}
+
+bool ReplayExamInterface::Inventory_RemoveItem(UINT slotId)
+{
+	bool isRemoved{ false };
+	if (Expect(eReplayCall::INVENTORY_REMOVE_ITEM, slotId))
+		Answer(isRemoved);
+	return isRemoved;
+}
+
+bool ReplayExamInterface::Inventory_GetItem(UINT slotId, ItemInfo& item)
+{
+	bool isValid{ false };
+	if (Expect(eReplayCall::INVENTORY_GET_ITEM, slotId))
+		Answer(isValid, item);
+	return isValid;
+}
+
+UINT ReplayExamInterface::Inventory_GetCapacity() const
+{
+	UINT capacity{ 0 };
+	if (Expect(eReplayCall::INVENTORY_GET_CAPACITY))
+		Answer(capacity);
+	return capacity;
+}
+#pragma endregion
+
+#pragma region Items
+bool ReplayExamInterface::Item_GetInfo(EntityInfo entity, ItemInfo& item)
+{
+	bool isValid{ false };
+	if (Expect(eReplayCall::ITEM_GET_INFO, entity))
+		Answer(isValid, item);
+	return isValid;
+}
+
+bool ReplayExamInterface::Item_Grab(EntityInfo entity, ItemInfo& item)
+{
+	bool isGrabbed{ false };
+	if (Expect(eReplayCall::ITEM_GRAB, entity))
+		Answer(isGrabbed, item);
+	return isGrabbed;
+}
+
+bool ReplayExamInterface::Item_Destroy(EntityInfo entity)
+{
+	bool isDestroyed{ false };
+	if (Expect(eReplayCall::ITEM_DESTROY, entity))
+		Answer(isDestroyed);
+	return isDestroyed;
+}
+
+int ReplayExamInterface::Weapon_GetAmmo(ItemInfo& item)
+{
+	int ammo{ -1 };
+	if (Expect(eReplayCall::WEAPON_GET_AMMO, item))
+		Answer(ammo);
+	return ammo;
+}
+
+int ReplayExamInterface::Medkit_GetHealth(ItemInfo& item)
+{
+	int health{ -1 };
+	if (Expect(eReplayCall::MEDKIT_GET_HEALTH, item))
+		Answer(health);
+	return health;
+}
+
+int ReplayExamInterface::Food_GetEnergy(ItemInfo& item)
+{
+	int energy{ -1 };
+	if (Expect(eReplayCall::FOOD_GET_ENERGY, item))
+		Answer(energy);
+	return energy;
+}
+
+bool ReplayExamInterface::PurgeZone_GetInfo(EntityInfo entity, PurgeZoneInfo& zone)
+{
+	bool isValid{ false };
+	if (Expect(eReplayCall::PURGEZONE_GET_INFO, entity))
+		Answer(isValid, zone);
+	return isValid;
+}
+#pragma endregion
@@ -0,0 +1,104 @@
+#pragma once
+#include "IExamInterface.h"
+#include "ReplayFile.h"
+
+//IExamInterface that answers every call from a replay, the frame has to be decoded by the caller
+//every call is checked against the recorded one and its arguments, once the plugin asks something else the replay has diverged
+//from then on every call answers false or zeros, the run can't be trusted past that point
+//rendering, debug and input calls are no-ops, same as in HeadlessExamInterface
+class ReplayExamInterface final : public IExamInterface
+{
+public:
+	explicit ReplayExamInterface(ReplayReader* pReader);
+	~ReplayExamInterface() = default;
+
+	//checks output against the recorded STEERING_OUTPUT that closes the frame, false if it differs or the plugin made fewer calls than recorded
+	bool CheckSteering(const SteeringPlugin_Output& steering);
+	bool IsDiverged() const { return m_IsDiverged; }
+	int GetDivergedFrame() const { return m_DivergedFrame; }
+	//what the plugin called when it diverged, and what the replay has there
+	eReplayCall GetDivergedCall() const { return m_DivergedCall; }
+	eReplayCall GetRecordedCall() const { return m_RecordedCall; }
+
+	//WORLD & ENTITIES
+	WorldInfo World_GetInfo() const override;
+	StatisticsInfo World_GetStats() const override;
+
+	bool Fov_GetHouseByIndex(UINT index, HouseInfo& houseInfo) const override;
+	bool Fov_GetEntityByIndex(UINT index, EntityInfo& enemyInfo) const override;
+
+	AgentInfo Agent_GetInfo() const override;
+	bool Enemy_GetInfo(EntityInfo entity, EnemyInfo& enemy) override;
+
+	//NAVMESH
+	Elite::Vector2 NavMesh_GetClosestPathPoint(Elite::Vector2 goal) const override;
+
+	//INVENTORY
+	bool Inventory_AddItem(UINT slotId, ItemInfo item) override;
+	bool Inventory_UseItem(UINT slotId) override;
+	bool Inventory_RemoveItem(UINT slotId) override;
+	bool Inventory_GetItem(UINT slotId, ItemInfo& item) override;
+	UINT Inventory_GetCapacity() const override;
+
+	bool Item_GetInfo(EntityInfo entity, ItemInfo& item) override;
+	bool Item_Grab(EntityInfo entity, ItemInfo& item) override;
+	bool Item_Destroy(EntityInfo entity) override;
+
+	int Weapon_GetAmmo(ItemInfo& item) override;
+	int Medkit_GetHealth(ItemInfo& item) override;
+	int Food_GetEnergy(ItemInfo& item) override;
+
+	//PURGEZONE
+	bool PurgeZone_GetInfo(EntityInfo entity, PurgeZoneInfo& zone) override;
+
+	//DEBUG
+	Elite::Vector2 Debug_ConvertScreenToWorld(Elite::Vector2 screenPos) const override { return screenPos; }
+	Elite::Vector2 Debug_ConvertWorldToScreen(Elite::Vector2 worldPos) const override { return worldPos; }
+
+	//INPUT
+	bool Input_IsKeyboardKeyDown(Elite::InputScancode key) const override { return false; }
+	bool Input_IsKeyboardKeyUp(Elite::InputScancode key) const override { return false; }
+	bool Input_IsMouseButtonDown(Elite::InputMouseButton button) const override { return false; }
+	bool Input_IsMouseButtonUp(Elite::InputMouseButton button) const override { return false; }
+	Elite::MouseData Input_GetMouseData(Elite::InputType type, Elite::InputMouseButton button = Elite::InputMouseButton(0)) const override { return Elite::MouseData{}; }
+
+	//EVENT
+	void RequestShutdown() const override {}
+
+	//RENDERER
+	void Draw_Polygon(const Elite::Vector2* points, int count, const Elite::Vector3& color, float depth) override {}
+	void Draw_SolidPolygon(const Elite::Vector2* points, int count, const Elite::Vector3& color, float depth, bool triangulate = false) override {}
+	void Draw_Circle(const Elite::Vector2& center, float radius, const Elite::Vector3& color, float depth) override {}
+	void Draw_SolidCircle(const Elite::Vector2& center, float32 radius, const Elite::Vector2& axis, const Elite::Vector3& color, float depth) override {}
+	void Draw_Segment(const Elite::Vector2& p1, const Elite::Vector2& p2, const Elite::Vector3& color, float depth) override {}
+	void Draw_Direction(const Elite::Vector2& p, Elite::Vector2 dir, float length, const Elite::Vector3& color, float depth = 0.9f) override {}
+	void Draw_Transform(const b2Transform& xf, float depth) override {}
+	void Draw_Point(const Elite::Vector2& p, float size, const Elite::Vector3& color, float depth) override {}
+	float NextDepthSlice() override { return 0.f; }
+
+	//the non-virtual overloads are hidden by the overrides above, pull them back in
+	using IBaseInterface::Draw_Polygon;
+	using IBaseInterface::Draw_SolidPolygon;
+	using IBaseInterface::Draw_Circle;
+	using IBaseInterface::Draw_SolidCircle;
+	using IBaseInterface::Draw_Segment;
+	using IBaseInterface::Draw_Transform;
+	using IBaseInterface::Draw_Point;
+
+private:
+	//reads the next record, true if it's call with exactly these arguments
+	template<typename... TArgs>
+	bool Expect(eReplayCall call, const TArgs&... args) const;
+	template<typename TArg>
+	bool IsArgMatching(const TArg& arg) const;
+	//the recorded answers of the call Expect just matched
+	template<typename... TAnswers>
+	void Answer(TAnswers&... answers) const;
+
+	ReplayReader* m_pReader;
+	//the const queries can diverge too
+	mutable bool m_IsDiverged = false;
+	mutable int m_DivergedFrame = -1;
+	mutable eReplayCall m_DivergedCall = eReplayCall::_COUNT;
+	mutable eReplayCall m_RecordedCall = eReplayCall::_COUNT;
+};
@@ -0,0 +1,87 @@
+#include "stdafx.h"
+#include "ReplayHost.h"
+#include "ReplayExamInterface.h"
+#include "IExamPlugin.h"
+
+//plugin entry point, same one the framework looks up in the dll
+extern "C" IPluginBase* Register();
+
+ReplayHost::ReplayHost(const std::string& replayFile)
+{
+	if (!m_Reader.Open(replayFile) || !m_Reader.NextFrame())
+	{
+		return;
+	}
+
+	m_pPlugin = static_cast<IExamPlugin*>(Register());
+	m_pPlugin->DllInit();
+
+	//same as the headless host, the plugin sees the seed and level the recording ran with
+	GameDebugParams params{};
+	ApplyOverrides(params);
+	m_pPlugin->InitGameDebugParams(params);
+	ApplyOverrides(params);
+
+	//frame 0 answers the calls of Initialize
+	m_pInterface = new ReplayExamInterface(&m_Reader);
+	PluginInfo info{};
+	m_pPlugin->Initialize(m_pInterface, info);
+}
+
+ReplayHost::~ReplayHost()
+{
+	if (m_pPlugin)
+	{
+		m_pPlugin->DllShutdown();
+	}
+	delete m_pPlugin;
+	delete m_pInterface;
+}
+
+ReplayRunResult ReplayHost::Run()
+{
+	ReplayRunResult result{};
+	result.NrFrames = m_Reader.GetNrFrames();
+	if (!m_pPlugin)
+	{
+		return result;
+	}
+
+	//Initialize made fewer calls than recorded
+	if (!m_pInterface->IsDiverged() && !m_Reader.IsFrameDone())
+	{
+		eReplayCall recordedCall{};
+		m_Reader.Read(recordedCall);
+		result.DivergedFrame = 0;
+		result.RecordedCall = recordedCall;
+		return result;
+	}
+
+	while (!m_pInterface->IsDiverged() && m_Reader.NextFrame())
+	{
+		const SteeringPlugin_Output steering{ m_pPlugin->UpdateSteering(m_Reader.GetDeltaTime()) };
+		if (!m_pInterface->CheckSteering(steering) && !m_pInterface->IsDiverged())
+		{
+			if (result.NrSteeringMismatches == 0)
+			{
+				result.FirstSteeringMismatch = m_Reader.GetFrameIdx();
+			}
+			++result.NrSteeringMismatches;
+		}
+		++result.FramesReplayed;
+	}
+
+	if (m_pInterface->IsDiverged())
+	{
+		result.DivergedFrame = m_pInterface->GetDivergedFrame();
+		result.DivergedCall = m_pInterface->GetDivergedCall();
+		result.RecordedCall = m_pInterface->GetRecordedCall();
+	}
+	return result;
+}
+
+void ReplayHost::ApplyOverrides(GameDebugParams& params) const
+{
+	params.Seed = m_Reader.GetSeed();
+	params.LevelFile = m_Reader.GetLevelFile();
+}
@@ -0,0 +1,42 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+#include "ReplayFile.h"
+
+class IExamPlugin;
+class ReplayExamInterface;
+
+struct ReplayRunResult
+{
+	uint32_t NrFrames = 0; //in the file, Initialize's included
+	int FramesReplayed = 0; //UpdateSteering calls
+	int DivergedFrame = -1; //first frame where the plugin made a different call than recorded, -1 if it never did
+	eReplayCall DivergedCall = eReplayCall::_COUNT;
+	eReplayCall RecordedCall = eReplayCall::_COUNT;
+	int NrSteeringMismatches = 0; //frames with the same calls but a different output
+	int FirstSteeringMismatch = -1;
+};
+
+//Drives a single plugin instance from a replay file instead of a world, as fast as the plugin runs
+//the plugin gets the recorded seed and level, then one UpdateSteering per recorded frame with its delta time
+//stops at the first frame the plugin's calls diverge from the recording
+class ReplayHost final
+{
+public:
+	explicit ReplayHost(const std::string& replayFile);
+	~ReplayHost();
+
+	//false if the file couldn't be opened, Run does nothing then
+	bool IsOpen() const { return m_pPlugin != nullptr; }
+	ReplayRunResult Run();
+
+	ReplayHost(const ReplayHost& other) = delete;
+	ReplayHost& operator=(const ReplayHost& rhs) = delete;
+	ReplayHost(ReplayHost&& other) = delete;
+	ReplayHost& operator=(ReplayHost&& rhs) = delete;
+private:
+	void ApplyOverrides(GameDebugParams& params) const;
+
+	ReplayReader m_Reader;
+	IExamPlugin* m_pPlugin = nullptr;
+	ReplayExamInterface* m_pInterface = nullptr;
+};
@@ -0,0 +1,83 @@
+#include "stdafx.h"
+#include "Tournament.h"
+#include "WorkStealingPool.h"
+
+Tournament::Tournament(const TournamentSettings& settings)
+	: m_Settings{ settings }
+{
+}
+
+void Tournament::Run()
+{
+	//every episode writes its own slot, so no locking is needed on the results
+	m_Results.clear();
+	m_Results.resize(std::max(m_Settings.NrEpisodes, 0));
+
+	const unsigned int nrThreads{ m_Settings.NrThreads > 0 ? m_Settings.NrThreads : std::thread::hardware_concurrency() };
+	WorkStealingPool pool{ nrThreads };
+	for (int i{ 0 }; i < int(m_Results.size()); ++i)
+	{
+		HeadlessRunSettings runSettings{ m_Settings.RunSettings };
+		runSettings.Seed = m_Settings.FirstSeed + i;
+		//every episode would write the same file
+		runSettings.RecordFile.clear();
+		if (!m_Settings.LevelFiles.empty())
+		{
+			runSettings.LevelFile = m_Settings.LevelFiles[i % m_Settings.LevelFiles.size()];
+		}
+
+		HeadlessRunResult* pResult{ &m_Results[i] };
+		pool.Submit([runSettings, pResult]()
+		{
+			HeadlessHost host{ runSettings };
+			*pResult = host.Run();
+		});
+	}
+	pool.Wait();
+}
+
+void Tournament::PrintResultsTable(FILE* pFile) const
+{
+	fprintf(pFile, "Seed,LevelFile,Frames,Died,Score,TimeSurvived,NumEnemiesKilled,NumMissedShots\n");
+	for (const HeadlessRunResult& result : m_Results)
+	{
+		fprintf(pFile, "%d,%s,%d,%d,%d,%.2f,%d,%d\n", result.Seed, result.LevelFile.c_str(), result.FramesSimulated, int(result.AgentDied),
+			result.Stats.Score, result.Stats.TimeSurvived, result.Stats.NumEnemiesKilled, result.Stats.NumMissedShots);
+	}
+}
+
+void Tournament::PrintSummary(FILE* pFile) const
+{
+	if (m_Results.empty())
+	{
+		return;
+	}
+
+	struct Column
+	{
+		const char* Name;
+		std::function<double(const StatisticsInfo&)> GetValue;
+	};
+	const Column columns[]{
+		{ "Score", [](const StatisticsInfo& stats) { return double(stats.Score); } },
+		{ "TimeSurvived", [](const StatisticsInfo& stats) { return double(stats.TimeSurvived); } },
+		{ "NumEnemiesKilled", [](const StatisticsInfo& stats) { return double(stats.NumEnemiesKilled); } },
+		{ "NumMissedShots", [](const StatisticsInfo& stats) { return double(stats.NumMissedShots); } },
+	};
+
+	fprintf(pFile, "%-18s %10s %10s %10s\n", "Statistic", "Mean", "Min", "Max");
+	for (const Column& column : columns)
+	{
+		double sum{ 0.0 };
+		double min{ DBL_MAX };
+		double max{ -DBL_MAX };
+		for (const HeadlessRunResult& result : m_Results)
+		{
+			const double value{ column.GetValue(result.Stats) };
+			sum += value;
+			min = std::min(min, value);
+			max = std::max(max, value);
+		}
+		fprintf(pFile, "%-18s %10.2f %10.2f %10.2f\n", column.Name, sum / m_Results.size(), min, max);
+	}
+}
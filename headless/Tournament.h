@@ -0,0 +1,29 @@
+#pragma once
+#include "HeadlessHost.h"
+
+struct TournamentSettings
+{
+	int NrEpisodes = 100;
+	int FirstSeed = 0; //episode i runs with seed FirstSeed + i
+	std::vector<std::string> LevelFiles = {}; //cycled over the episodes, empty uses the plugin's level
+	unsigned int NrThreads = 0; //0 uses every hardware thread
+	HeadlessRunSettings RunSettings = {}; //Seed and LevelFile are overwritten per episode, RecordFile is ignored
+};
+
+//Runs many independent episodes in parallel, each with its own plugin instance and headless world
+class Tournament final
+{
+public:
+	explicit Tournament(const TournamentSettings& settings);
+
+	void Run();
+	const std::vector<HeadlessRunResult>& GetResults() const { return m_Results; }
+
+	//one line per episode, comma separated
+	void PrintResultsTable(FILE* pFile) const;
+	void PrintSummary(FILE* pFile) const;
+
+private:
+	TournamentSettings m_Settings;
+	std::vector<HeadlessRunResult> m_Results;
+};
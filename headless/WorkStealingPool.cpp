@@ -0,0 +1,112 @@
+#include "stdafx.h"
+#include "WorkStealingPool.h"
+
+WorkStealingPool::WorkStealingPool(unsigned int nrThreads)
+	: m_Queues(std::max(nrThreads, 1u))
+{
+	const unsigned int nrWorkers{ static_cast<unsigned int>(m_Queues.size()) };
+	m_Workers.reserve(nrWorkers);
+	for (unsigned int i{ 0 }; i < nrWorkers; ++i)
+	{
+		m_Workers.emplace_back(&WorkStealingPool::WorkerLoop, this, i);
+	}
+}
+
+WorkStealingPool::~WorkStealingPool()
+{
+	{
+		std::lock_guard<std::mutex> lock{ m_WakeMutex };
+		m_IsStopping = true;
+	}
+	m_WakeCondition.notify_all();
+
+	for (std::thread& worker : m_Workers)
+	{
+		worker.join();
+	}
+}
+
+void WorkStealingPool::Submit(std::function<void()> task)
+{
+	{
+		std::lock_guard<std::mutex> lock{ m_WakeMutex };
+		++m_PendingTasks;
+		++m_QueuedTasks;
+	}
+
+	const unsigned int queueIdx{ m_NextQueue++ % static_cast<unsigned int>(m_Queues.size()) };
+	{
+		std::lock_guard<std::mutex> lock{ m_Queues[queueIdx].Mutex };
+		m_Queues[queueIdx].Tasks.push_back(std::move(task));
+	}
+	m_WakeCondition.notify_one();
+}
+
+void WorkStealingPool::Wait()
+{
+	std::unique_lock<std::mutex> lock{ m_WakeMutex };
+	m_DoneCondition.wait(lock, [this]() { return m_PendingTasks == 0; });
+}
+
+void WorkStealingPool::WorkerLoop(unsigned int workerIdx)
+{
+	std::function<void()> task{};
+	while (true)
+	{
+		if (PopTask(workerIdx, task) || StealTask(workerIdx, task))
+		{
+			task();
+			task = nullptr;
+
+			std::lock_guard<std::mutex> lock{ m_WakeMutex };
+			if (--m_PendingTasks == 0)
+			{
+				m_DoneCondition.notify_all();
+			}
+			continue;
+		}
+
+		//nothing to pop or steal, sleep until new work is queued
+		std::unique_lock<std::mutex> lock{ m_WakeMutex };
+		m_WakeCondition.wait(lock, [this]() { return m_IsStopping || m_QueuedTasks > 0; });
+		if (m_IsStopping)
+		{
+			return;
+		}
+	}
+}
+
+bool WorkStealingPool::PopTask(unsigned int workerIdx, std::function<void()>& task)
+{
+	WorkerQueue& queue{ m_Queues[workerIdx] };
+	std::lock_guard<std::mutex> lock{ queue.Mutex };
+	if (queue.Tasks.empty())
+	{
+		return false;
+	}
+
+	task = std::move(queue.Tasks.back());
+	queue.Tasks.pop_back();
+	--m_QueuedTasks;
+	return true;
+}
+
+bool WorkStealingPool::StealTask(unsigned int thiefIdx, std::function<void()>& task)
+{
+	const unsigned int nrQueues{ static_cast<unsigned int>(m_Queues.size()) };
+	for (unsigned int offset{ 1 }; offset < nrQueues; ++offset)
+	{
+		WorkerQueue& victim{ m_Queues[(thiefIdx + offset) % nrQueues] };
+		std::lock_guard<std::mutex> lock{ victim.Mutex };
+		if (victim.Tasks.empty())
+		{
+			continue;
+		}
+
+		task = std::move(victim.Tasks.front());
+		victim.Tasks.pop_front();
+		--m_QueuedTasks;
+		return true;
+	}
+	return false;
+}
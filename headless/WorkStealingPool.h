@@ -0,0 +1,50 @@
+#pragma once
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <atomic>
+#include <condition_variable>
+
+//Fixed size thread pool where every worker owns a task queue
+//workers pop their own queue from the back and steal from the front of the others when it runs dry
+//meant for coarse tasks (whole episodes), so a mutex per queue is cheap enough
+class WorkStealingPool final
+{
+public:
+	explicit WorkStealingPool(unsigned int nrThreads);
+	~WorkStealingPool();
+
+	//tasks submitted before Wait are spread round-robin over the workers
+	void Submit(std::function<void()> task);
+	//blocks until every submitted task has finished
+	void Wait();
+
+	unsigned int GetNrThreads() const { return static_cast<unsigned int>(m_Workers.size()); }
+
+	WorkStealingPool(const WorkStealingPool& other) = delete;
+	WorkStealingPool& operator=(const WorkStealingPool& rhs) = delete;
+	WorkStealingPool(WorkStealingPool&& other) = delete;
+	WorkStealingPool& operator=(WorkStealingPool&& rhs) = delete;
+private:
+	struct WorkerQueue
+	{
+		std::mutex Mutex;
+		std::deque<std::function<void()>> Tasks;
+	};
+
+	void WorkerLoop(unsigned int workerIdx);
+	bool PopTask(unsigned int workerIdx, std::function<void()>& task);
+	bool StealTask(unsigned int thiefIdx, std::function<void()>& task);
+
+	std::vector<std::thread> m_Workers;
+	std::vector<WorkerQueue> m_Queues;
+	std::atomic<unsigned int> m_NextQueue{ 0 };
+	std::atomic<int> m_PendingTasks{ 0 }; //queued or running
+	std::atomic<int> m_QueuedTasks{ 0 }; //waiting in one of the queues
+	std::atomic<bool> m_IsStopping{ false };
+
+	//workers sleep on this when all queues are empty
+	std::mutex m_WakeMutex;
+	std::condition_variable m_WakeCondition;
+	std::condition_variable m_DoneCondition;
+};
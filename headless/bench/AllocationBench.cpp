@@ -0,0 +1,112 @@
+#include "stdafx.h"
+#include "HeadlessHost.h"
+#include "HeadlessWorld.h"
+#include "IExamPlugin.h"
+#include "ELogger.h"
+#include <new>
+
+//Counts heap allocations made inside the plugin's UpdateSteering (perception refill + FSM tick + steering)
+//replaces the global operator new, so this has to be its own executable
+namespace
+{
+	bool g_IsCounting{ false };
+	size_t g_NrAllocations{ 0 };
+	size_t g_NrBytes{ 0 };
+
+	void* CountedAlloc(size_t size)
+	{
+		if (g_IsCounting)
+		{
+			++g_NrAllocations;
+			g_NrBytes += size;
+		}
+		void* pMemory{ malloc(size ? size : 1) };
+		if (!pMemory)
+		{
+			throw std::bad_alloc{};
+		}
+		return pMemory;
+	}
+}
+
+void* operator new(size_t size) { return CountedAlloc(size); }
+void* operator new[](size_t size) { return CountedAlloc(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return malloc(size ? size : 1); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return malloc(size ? size : 1); }
+void operator delete(void* pMemory) noexcept { free(pMemory); }
+void operator delete[](void* pMemory) noexcept { free(pMemory); }
+void operator delete(void* pMemory, size_t) noexcept { free(pMemory); }
+void operator delete[](void* pMemory, size_t) noexcept { free(pMemory); }
+
+//usage: gpp_alloc_bench [--episodes N] [--frames N] [--level FILE]
+//exits with 1 if any tick after the first one allocated
+int main(int argc, char* argv[])
+{
+	HeadlessRunSettings settings{};
+	int nrEpisodes{ 20 };
+	for (int i{ 1 }; i + 1 < argc; i += 2)
+	{
+		const std::string arg{ argv[i] };
+		if (arg == "--episodes")
+			nrEpisodes = atoi(argv[i + 1]);
+		else if (arg == "--frames")
+			settings.MaxFrames = atoi(argv[i + 1]);
+		else if (arg == "--level")
+			settings.LevelFile = argv[i + 1];
+		else
+		{
+			printf("Unknown argument '%s'\n", arg.c_str());
+			return 1;
+		}
+	}
+
+	//the FSM logs state changes, keep the report readable
+	Elite::Logger::GetInstance().SetOutput(nullptr);
+
+	long long nrTicks{ 0 };
+	long long nrAllocatingTicks{ 0 };
+	size_t firstTickAllocations{ 0 };
+	size_t nrAllocations{ 0 };
+	size_t nrBytes{ 0 };
+	for (int episode{ 0 }; episode < nrEpisodes; ++episode)
+	{
+		settings.Seed = episode;
+		HeadlessHost host{ settings };
+		IExamPlugin* pPlugin{ host.GetPlugin() };
+		HeadlessWorld* pWorld{ host.GetWorld() };
+		const float dt{ settings.DeltaTime };
+
+		int frame{ 0 };
+		while (host.IsRunning(frame))
+		{
+			const size_t allocationsBefore{ g_NrAllocations };
+			const size_t bytesBefore{ g_NrBytes };
+			g_IsCounting = true;
+			const SteeringPlugin_Output steering{ pPlugin->UpdateSteering(dt) };
+			g_IsCounting = false;
+			const size_t tickAllocations{ g_NrAllocations - allocationsBefore };
+
+			//the first tick sizes the per-frame buffers
+			if (frame == 0)
+			{
+				firstTickAllocations += tickAllocations;
+			}
+			else if (tickAllocations > 0)
+			{
+				++nrAllocatingTicks;
+				nrAllocations += tickAllocations;
+				nrBytes += g_NrBytes - bytesBefore;
+			}
+			++nrTicks;
+
+			pWorld->Step(dt, steering);
+			++frame;
+		}
+	}
+
+	printf("Episodes: %d, Ticks: %lld\n", nrEpisodes, nrTicks);
+	printf("First tick allocations: %zu (%.1f per episode)\n", firstTickAllocations, double(firstTickAllocations) / (std::max)(nrEpisodes, 1));
+	printf("Steady state: %zu allocations (%zu bytes) in %lld ticks\n", nrAllocations, nrBytes, nrAllocatingTicks);
+	printf("%s\n", nrAllocations == 0 ? "PASS: the plugin tick is allocation-free" : "FAIL: the plugin tick allocates");
+	return nrAllocations == 0 ? 0 : 1;
+}
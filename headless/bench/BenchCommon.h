@@ -0,0 +1,141 @@
+#pragma once
+#include <chrono>
+#include <initializer_list>
+#include <random>
+#include "EnemyFrame.h"
+
+//What the benches that time a piece of the plugin over generated scenes share: their arguments, the enemy counts they sweep and the timing,
+//and for the ones that read an EnemyFrame, the scenes and the comparison against the same math one EnemyInfo at a time
+namespace Bench
+{
+	//from one enemy to a thousand, the benches that time per enemy print a row for each
+	constexpr size_t EnemyCounts[]{ 1, 10, 100, 1000 };
+
+	//a --name value argument and the count it sets
+	struct Arg
+	{
+		Arg(const char* name, int& value) : pName{ name }, pInt{ &value } {}
+		Arg(const char* name, size_t& value) : pName{ name }, pSize{ &value } {}
+
+		const char* pName;
+		int* pInt{ nullptr };
+		size_t* pSize{ nullptr };
+	};
+
+	//sets the counts from the --name value pairs, prints the first unknown argument and returns false on it
+	inline bool ParseArgs(int argc, char* argv[], std::initializer_list<Arg> args)
+	{
+		for (int i{ 1 }; i + 1 < argc; i += 2)
+		{
+			const std::string name{ argv[i] };
+			const Arg* pArg{ std::find_if(args.begin(), args.end(), [&name](const Arg& arg) { return name == arg.pName; }) };
+			if (pArg == args.end())
+			{
+				printf("Unknown argument '%s'\n", name.c_str());
+				return false;
+			}
+			if (pArg->pInt)
+				*pArg->pInt = atoi(argv[i + 1]);
+			else
+				*pArg->pSize = static_cast<size_t>(atoi(argv[i + 1]));
+		}
+		return true;
+	}
+
+	inline double ToNanoseconds(std::chrono::steady_clock::duration duration)
+	{
+		return std::chrono::duration<double, std::nano>(duration).count();
+	}
+
+	//where KeepAlive stores to, a volatile the whole program can see, so no store to it can be left out
+	inline volatile unsigned char g_Sink{};
+
+	//stores every byte of the value where the optimizer has to assume it's read, so the loop that computed it can't be thrown away
+	template<typename TValue>
+	void KeepAlive(const TValue& value)
+	{
+		const unsigned char* pBytes{ reinterpret_cast<const unsigned char*>(&value) };
+		for (size_t byteIdx{ 0 }; byteIdx < sizeof(value); ++byteIdx)
+		{
+			g_Sink = pBytes[byteIdx];
+		}
+	}
+
+	//ns per call of calling run on every scene nrIterations times, run's results are summed and kept alive
+	template<typename TScene, typename TRun>
+	double TimePerScene(const std::vector<TScene>& scenes, int nrIterations, TRun run)
+	{
+		decltype(run(scenes.front())) checksum{};
+		const auto start{ std::chrono::steady_clock::now() };
+		for (int iteration{ 0 }; iteration < nrIterations; ++iteration)
+		{
+			for (const TScene& scene : scenes)
+			{
+				checksum += run(scene);
+			}
+		}
+		const double nanoseconds{ ToNanoseconds(std::chrono::steady_clock::now() - start) };
+		KeepAlive(checksum);
+		return nanoseconds / (double(scenes.size()) * nrIterations);
+	}
+
+	//an agent somewhere in the world with enemies around it, as EnemyInfos for the reference and as the frame the plugin reads
+	struct EnemyScene
+	{
+		AgentInfo Agent;
+		int Ammo{ 0 }; //only the target selection shoots
+		std::vector<EnemyInfo> Enemies;
+		EnemyFrame Frame;
+	};
+
+	//the agent at a random position and orientation, every enemy in a random direction between 1 and maxDistance from it
+	//setup(scene, rng) fills in the rest of the agent and the enemies before they're added to the frame
+	template<typename TSetup>
+	std::vector<EnemyScene> CreateEnemyScenes(size_t nrScenes, size_t nrEnemies, float maxDistance, TSetup setup)
+	{
+		std::minstd_rand rng{ 1 };
+		std::uniform_real_distribution<float> position{ -250.f, 250.f };
+		std::uniform_real_distribution<float> angle{ 0.f, 2.f * float(E_PI) };
+		std::uniform_real_distribution<float> distance{ 1.f, maxDistance };
+		std::vector<EnemyScene> scenes(nrScenes);
+		for (EnemyScene& scene : scenes)
+		{
+			scene.Agent.Position = Elite::Vector2{ position(rng), position(rng) };
+			scene.Agent.Orientation = angle(rng);
+			scene.Enemies.resize(nrEnemies);
+			for (EnemyInfo& enemy : scene.Enemies)
+			{
+				enemy.Location = scene.Agent.Position + Elite::OrientationToVector(angle(rng)) * distance(rng);
+			}
+			setup(scene, rng);
+			scene.Frame.Reserve(nrEnemies);
+			for (const EnemyInfo& enemy : scene.Enemies)
+			{
+				scene.Frame.Add(enemy);
+			}
+		}
+		return scenes;
+	}
+
+	//for every enemy count, times run and reference over the same scenes and prints a row with both, per call and per enemy,
+	//and how many scenes isMismatch says they disagree on, returns those summed over all counts
+	template<typename TCreateScenes, typename TRun, typename TReference, typename TIsMismatch>
+	size_t CompareWithReference(size_t nrScenes, int nrIterations, TCreateScenes createScenes, TRun run, TReference reference, TIsMismatch isMismatch)
+	{
+		printf("Scenes: %zu, Iterations: %d\n", nrScenes, nrIterations);
+		printf("%-10s %14s %14s %16s %16s %12s\n", "Enemies", "ns/call", "ns/enemy", "ref ns/call", "ref ns/enemy", "mismatches");
+		size_t nrMismatches{ 0 };
+		for (size_t nrEnemies : EnemyCounts)
+		{
+			const std::vector<EnemyScene> scenes{ createScenes(nrScenes, nrEnemies) };
+			const double time{ TimePerScene(scenes, nrIterations, run) };
+			const double referenceTime{ TimePerScene(scenes, nrIterations, reference) };
+			const size_t nrSceneMismatches{ size_t(std::count_if(scenes.begin(), scenes.end(), isMismatch)) };
+			nrMismatches += nrSceneMismatches;
+
+			printf("%-10zu %14.1f %14.2f %16.1f %16.2f %12zu\n", nrEnemies, time, time / nrEnemies,
+				referenceTime, referenceTime / nrEnemies, nrSceneMismatches);
+		}
+		return nrMismatches;
+	}
+}
@@ -0,0 +1,470 @@
+#include "stdafx.h"
+#include "IExamInterface.h"
+#include "IExamPlugin.h"
+#include "AgentBlackboard.h"
+#include "AgentStateGraph.h"
+#include "StatesAndTransitions.h"
+#include "SteeringBehaviors.h"
+#include "BlendedSteering.h"
+#include "ELogger.h"
+#include <chrono>
+#include <functional>
+#include <new>
+
+extern "C" IPluginBase* Register();
+
+//Time and heap allocations per call of every piece of the plugin: each transition check, each state's OnEnter/Update/OnExit,
+//each steering behavior, the blackboard lookups and a whole UpdateSteering tick, with 0 up to 1000 entities in view
+//replaces the global operator new, so this has to be its own executable
+namespace
+{
+	bool g_IsCounting{ false };
+	size_t g_NrAllocations{ 0 };
+
+	void* CountedAlloc(size_t size)
+	{
+		if (g_IsCounting)
+		{
+			++g_NrAllocations;
+		}
+		void* pMemory{ malloc(size ? size : 1) };
+		if (!pMemory)
+		{
+			throw std::bad_alloc{};
+		}
+		return pMemory;
+	}
+}
+
+void* operator new(size_t size) { return CountedAlloc(size); }
+void* operator new[](size_t size) { return CountedAlloc(size); }
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return malloc(size ? size : 1); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return malloc(size ? size : 1); }
+void operator delete(void* pMemory) noexcept { free(pMemory); }
+void operator delete[](void* pMemory) noexcept { free(pMemory); }
+void operator delete(void* pMemory, size_t) noexcept { free(pMemory); }
+void operator delete[](void* pMemory, size_t) noexcept { free(pMemory); }
+
+namespace
+{
+	//A world that never changes: the agent stands still with a pistol, food and a medkit
+	//and sees a fixed set of enemies, items and purge zones spiralling out to the edge of its view
+	//every call answers from that set, nothing is moved, grabbed or used up
+	class BenchExamInterface final : public IExamInterface
+	{
+	public:
+		explicit BenchExamInterface(size_t nrEntities)
+		{
+			m_Agent.Health = 10.f;
+			m_Agent.Energy = 10.f;
+			m_Agent.Stamina = 10.f;
+			m_Agent.FOV_Angle = 1.57f;
+			m_Agent.FOV_Range = 20.f;
+			m_Agent.Position = Elite::Vector2{ 40.f, 30.f };
+			m_Agent.MaxLinearSpeed = 5.f;
+			m_Agent.MaxAngularSpeed = 1.f;
+			m_Agent.GrabRange = 3.f;
+			m_Agent.AgentSize = 1.f;
+
+			//per ten: six enemies, three items and a purge zone
+			m_Entities.resize(nrEntities);
+			for (size_t i{ 0 }; i < nrEntities; ++i)
+			{
+				const size_t kind{ i % 10 };
+				const float angle{ 2.4f * float(i) };
+				const float distance{ 2.f + (m_Agent.FOV_Range - 2.f) * float(i + 1) / float(nrEntities) };
+				m_Entities[i].Type = kind < 6 ? eEntityType::ENEMY : kind < 9 ? eEntityType::ITEM : eEntityType::PURGEZONE;
+				m_Entities[i].Location = m_Agent.Position + Elite::Vector2{ cosf(angle), sinf(angle) } * distance;
+				m_Entities[i].EntityHash = int(i) + 1;
+			}
+			m_Houses.resize((std::min)(nrEntities / 10, m_MaxHouses));
+			for (size_t i{ 0 }; i < m_Houses.size(); ++i)
+			{
+				m_Houses[i].Center = m_Agent.Position + Elite::Vector2{ 12.f * float(i % 4) - 18.f, 12.f * float(i / 4) - 18.f };
+				m_Houses[i].Size = Elite::Vector2{ 8.f, 8.f };
+			}
+			m_Inventory[0].Type = eItemType::PISTOL;
+			m_Inventory[1].Type = eItemType::FOOD;
+			m_Inventory[2].Type = eItemType::MEDKIT;
+		}
+		~BenchExamInterface() = default;
+
+		//WORLD & ENTITIES
+		WorldInfo World_GetInfo() const override { return WorldInfo{ Elite::Vector2{}, Elite::Vector2{ 400.f, 400.f } }; }
+		StatisticsInfo World_GetStats() const override { return StatisticsInfo{}; }
+
+		bool Fov_GetHouseByIndex(UINT index, HouseInfo& houseInfo) const override
+		{
+			if (index >= m_Houses.size())
+				return false;
+			houseInfo = m_Houses[index];
+			return true;
+		}
+		bool Fov_GetEntityByIndex(UINT index, EntityInfo& enemyInfo) const override
+		{
+			if (index >= m_Entities.size())
+				return false;
+			enemyInfo = m_Entities[index];
+			return true;
+		}
+
+		AgentInfo Agent_GetInfo() const override { return m_Agent; }
+		bool Enemy_GetInfo(EntityInfo entity, EnemyInfo& enemy) override
+		{
+			enemy.Type = eEnemyType::ZOMBIE_NORMAL;
+			enemy.Location = entity.Location;
+			enemy.LinearVelocity = Elite::Vector2{};
+			enemy.EnemyHash = entity.EntityHash;
+			enemy.Size = 1.f;
+			enemy.Health = 3;
+			return entity.Type == eEntityType::ENEMY;
+		}
+
+		//NAVMESH
+		Elite::Vector2 NavMesh_GetClosestPathPoint(Elite::Vector2 goal) const override { return goal; }
+
+		//INVENTORY
+		bool Inventory_AddItem(UINT slotId, ItemInfo item) override { return slotId < m_NrInventorySlots; }
+		bool Inventory_UseItem(UINT slotId) override { return slotId < m_NrInventorySlots; }
+		bool Inventory_RemoveItem(UINT slotId) override { return slotId < m_NrInventorySlots; }
+		bool Inventory_GetItem(UINT slotId, ItemInfo& item) override
+		{
+			//the first three slots are filled
+			if (slotId >= 3)
+				return false;
+			item = m_Inventory[slotId];
+			return true;
+		}
+		UINT Inventory_GetCapacity() const override { return m_NrInventorySlots; }
+
+		bool Item_GetInfo(EntityInfo entity, ItemInfo& item) override
+		{
+			item.Type = eItemType(entity.EntityHash % 3);
+			item.Location = entity.Location;
+			item.ItemHash = entity.EntityHash;
+			return entity.Type == eEntityType::ITEM;
+		}
+		bool Item_Grab(EntityInfo entity, ItemInfo& item) override { return Item_GetInfo(entity, item); }
+		bool Item_Destroy(EntityInfo entity) override { return entity.Type == eEntityType::ITEM; }
+
+		//enough for every shot the states fire, the mirror counts them down
+		int Weapon_GetAmmo(ItemInfo& item) override { return (std::numeric_limits<int>::max)(); }
+		int Medkit_GetHealth(ItemInfo& item) override { return 5; }
+		int Food_GetEnergy(ItemInfo& item) override { return 5; }
+
+		//PURGEZONE
+		bool PurgeZone_GetInfo(EntityInfo entity, PurgeZoneInfo& zone) override
+		{
+			zone.Center = entity.Location;
+			zone.Radius = 5.f;
+			zone.ZoneHash = entity.EntityHash;
+			return entity.Type == eEntityType::PURGEZONE;
+		}
+
+		//DEBUG
+		Elite::Vector2 Debug_ConvertScreenToWorld(Elite::Vector2 screenPos) const override { return screenPos; }
+		Elite::Vector2 Debug_ConvertWorldToScreen(Elite::Vector2 worldPos) const override { return worldPos; }
+
+		//INPUT
+		bool Input_IsKeyboardKeyDown(Elite::InputScancode key) const override { return false; }
+		bool Input_IsKeyboardKeyUp(Elite::InputScancode key) const override { return false; }
+		bool Input_IsMouseButtonDown(Elite::InputMouseButton button) const override { return false; }
+		bool Input_IsMouseButtonUp(Elite::InputMouseButton button) const override { return false; }
+		Elite::MouseData Input_GetMouseData(Elite::InputType type, Elite::InputMouseButton button = Elite::InputMouseButton(0)) const override { return Elite::MouseData{}; }
+
+		//EVENT
+		void RequestShutdown() const override {}
+
+		//RENDERER
+		void Draw_Polygon(const Elite::Vector2* points, int count, const Elite::Vector3& color, float depth) override {}
+		void Draw_SolidPolygon(const Elite::Vector2* points, int count, const Elite::Vector3& color, float depth, bool triangulate = false) override {}
+		void Draw_Circle(const Elite::Vector2& center, float radius, const Elite::Vector3& color, float depth) override {}
+		void Draw_SolidCircle(const Elite::Vector2& center, float32 radius, const Elite::Vector2& axis, const Elite::Vector3& color, float depth) override {}
+		void Draw_Segment(const Elite::Vector2& p1, const Elite::Vector2& p2, const Elite::Vector3& color, float depth) override {}
+		void Draw_Direction(const Elite::Vector2& p, Elite::Vector2 dir, float length, const Elite::Vector3& color, float depth = 0.9f) override {}
+		void Draw_Transform(const b2Transform& xf, float depth) override {}
+		void Draw_Point(const Elite::Vector2& p, float size, const Elite::Vector3& color, float depth) override {}
+		float NextDepthSlice() override { return 0.f; }
+
+		//the non-virtual overloads are hidden by the overrides above, pull them back in
+		using IBaseInterface::Draw_Polygon;
+		using IBaseInterface::Draw_SolidPolygon;
+		using IBaseInterface::Draw_Circle;
+		using IBaseInterface::Draw_SolidCircle;
+		using IBaseInterface::Draw_Segment;
+		using IBaseInterface::Draw_Transform;
+		using IBaseInterface::Draw_Point;
+
+	private:
+		static constexpr size_t m_MaxHouses{ 16 };
+		static constexpr UINT m_NrInventorySlots{ 5 };
+
+		AgentInfo m_Agent{};
+		std::vector<EntityInfo> m_Entities;
+		std::vector<HouseInfo> m_Houses;
+		ItemInfo m_Inventory[m_NrInventorySlots]{};
+	};
+
+	//The blackboard, states and transitions as Plugin::DllInit sets them up, without the FSM so every piece can be called on its own
+	struct BenchAgent
+	{
+		explicit BenchAgent(BenchExamInterface* pInterface)
+		{
+			Blackboard.CreateSlots<AgentBlackboardSlots>();
+			BB::AddSlotAliases(&Blackboard);
+			Blackboard.Get<BB::Interface>() = pInterface;
+			Blackboard.Get<BB::SteeringController>() = &Controller;
+			Blackboard.Get<BB::Perception>().Reserve(16, 64);
+			Blackboard.Get<BB::Memory>().Reserve(4096);
+			Blackboard.Get<BB::VisitedHouses>().Reserve(256);
+			Blackboard.Get<BB::Threats>().Initialize(pInterface->World_GetInfo());
+			//the pistol, food and medkit the bench world hands out
+			Blackboard.Get<BB::Inventory>().Sync(pInterface);
+
+			States.resize(AgentStateGraph::NrStates);
+			States[int(eAgentState::WANDER)] = { "WanderState", new WanderState() };
+			States[int(eAgentState::FLEE)] = { "FleeState", new FleeState() };
+			States[int(eAgentState::ENTER_HOUSE)] = { "EnterHouseState", new EnterHouseState() };
+			States[int(eAgentState::SEARCH_CURRENT_HOUSE)] = { "SearchCurrentHouseState", new SearchCurrentHouseState() };
+			States[int(eAgentState::EXIT_CURRENT_HOUSE)] = { "ExitCurrentHouseState", new ExitCurrentHouseState() };
+			States[int(eAgentState::GRAB_ITEM)] = { "GrabItemState", new GrabItemState() };
+			States[int(eAgentState::KILL_ZOMBIE)] = { "KillZombieState", new KillZombieState() };
+			States[int(eAgentState::GO_TO_WORLD_CENTER)] = { "GoToWorldCenterState", new GoToWorldCenterState() };
+			States[int(eAgentState::FLEE_PURGE_ZONE)] = { "FleePurgeZoneState", new FleePurgeZoneState() };
+
+			Transitions.resize(AgentStateGraph::NrTransitions);
+			Transitions[int(eAgentTransition::SEES_ZOMBIE)] = { "SeesZombieTransition", new SeesZombieTransition() };
+			Transitions[int(eAgentTransition::SEES_HOUSE)] = { "SeesHouseTransition", new SeesHouseTransition() };
+			Transitions[int(eAgentTransition::SEES_ITEM)] = { "SeesItemTransition", new SeesItemTransition() };
+			Transitions[int(eAgentTransition::FINISHED_FLEEING)] = { "FinishedFleeingTransition", new FinishedFleeingTransition() };
+			Transitions[int(eAgentTransition::IS_INSIDE_HOUSE)] = { "IsInsideHouseTransition", new IsInsideHouseTransition() };
+			Transitions[int(eAgentTransition::IS_NOT_INSIDE_HOUSE)] = { "IsNotInsideHouseTransition", new IsNotInsideHouseTransition() };
+			Transitions[int(eAgentTransition::FINISHED_SEARCHING_HOUSE)] = { "FinishedSearchingHouseTransition", new FinishedSearchingHouseTransition() };
+			Transitions[int(eAgentTransition::HAS_GRABBED_ITEM)] = { "HasGrabbedItemTransition", new HasGrabbedItemTransition() };
+			Transitions[int(eAgentTransition::CAN_KILL_ZOMBIE)] = { "CanKillZombieTransition", new CanKillZombieTransition() };
+			Transitions[int(eAgentTransition::HAS_KILLED_ZOMBIE)] = { "HasKilledZombieTransition", new HasKilledZombieTransition() };
+			Transitions[int(eAgentTransition::HAS_LEFT_WORLD)] = { "HasLeftWorldTransition", new HasLeftWorldTransition() };
+			Transitions[int(eAgentTransition::IS_AT_WORLD_CENTER)] = { "IsAtWorldCenterTransition", new IsAtWorldCenterTransition() };
+			Transitions[int(eAgentTransition::SEES_PURGE_ZONE)] = { "SeesPurgeZoneTransition", new SeesPurgeZoneTransition() };
+			Transitions[int(eAgentTransition::HAS_LEFT_PURGE_ZONE)] = { "HasLeftPurgeZoneTransition", new HasLeftPurgeZoneTransition() };
+
+			//the start of UpdateSteering, so everything reads a perception of the bench world
+			IExamInterface* pExamInterface{ pInterface };
+			Blackboard.Get<BB::Agent>() = pExamInterface->Agent_GetInfo();
+			Blackboard.Get<BB::Perception>().Refresh(pExamInterface);
+			Blackboard.Get<BB::Memory>().Update(Blackboard.Get<BB::Perception>(), Blackboard.Get<BB::Agent>(), m_DeltaTime);
+			const EntityPartition& enemies{ Blackboard.Get<BB::Perception>().GetEnemies() };
+			for (size_t i{ 0 }; i < enemies.Size(); ++i)
+			{
+				EnemyInfo enemyInfo{};
+				pExamInterface->Enemy_GetInfo(enemies.GetEntity(i, eEntityType::ENEMY), enemyInfo);
+				Blackboard.Get<BB::Threats>().Splat(enemyInfo, m_DeltaTime);
+				Blackboard.Get<BB::Context>().AddObstacle(Blackboard.Get<BB::Agent>().Position, enemyInfo.Location, enemyInfo.Size / 2.f, 1.5f, 15.f);
+				Blackboard.Get<BB::Enemies>().Add(enemyInfo);
+			}
+		}
+		~BenchAgent()
+		{
+			for (const auto& state : States)
+				delete state.second;
+			for (const auto& transition : Transitions)
+				delete transition.second;
+		}
+
+		BenchAgent(const BenchAgent& other) = delete;
+		BenchAgent& operator=(const BenchAgent& rhs) = delete;
+		BenchAgent(BenchAgent&& other) = delete;
+		BenchAgent& operator=(BenchAgent&& rhs) = delete;
+
+		static constexpr float m_DeltaTime{ 0.016f };
+
+		Elite::Blackboard Blackboard;
+		SteeringController Controller;
+		std::vector<std::pair<const char*, Elite::FSMState*>> States;
+		std::vector<std::pair<const char*, Elite::FSMTransition*>> Transitions;
+	};
+
+	struct Measurement
+	{
+		double Nanoseconds = 0.0;
+		double NrAllocations = 0.0;
+	};
+
+	//one call outside the clock first, so growing to size doesn't count against the steady state
+	Measurement Measure(int nrIterations, const std::function<void()>& operation)
+	{
+		operation();
+		g_NrAllocations = 0;
+		g_IsCounting = true;
+		const auto start{ std::chrono::steady_clock::now() };
+		for (int iteration{ 0 }; iteration < nrIterations; ++iteration)
+		{
+			operation();
+		}
+		const auto end{ std::chrono::steady_clock::now() };
+		g_IsCounting = false;
+
+		Measurement measurement{};
+		measurement.Nanoseconds = std::chrono::duration<double, std::nano>(end - start).count() / nrIterations;
+		measurement.NrAllocations = double(g_NrAllocations) / nrIterations;
+		return measurement;
+	}
+
+	//a row of the report, one measurement per entity count
+	struct Row
+	{
+		std::string Name;
+		std::vector<Measurement> Measurements;
+	};
+
+	//every piece on a fresh agent, the states change the blackboard and a transition shouldn't see what the last state left
+	void MeasureComponents(size_t nrEntities, int nrIterations, std::vector<Row>& rows)
+	{
+		BenchExamInterface benchInterface{ nrEntities };
+		size_t rowIdx{ 0 };
+		const auto addMeasurement{ [&rows, &rowIdx](const std::string& name, const Measurement& measurement)
+		{
+			if (rowIdx == rows.size())
+				rows.push_back(Row{ name, {} });
+			rows[rowIdx++].Measurements.push_back(measurement);
+		} };
+
+		for (size_t transitionIdx{ 0 }; transitionIdx < AgentStateGraph::NrTransitions; ++transitionIdx)
+		{
+			BenchAgent agent{ &benchInterface };
+			Elite::FSMTransition* pTransition{ agent.Transitions[transitionIdx].second };
+			bool isChecked{ false };
+			addMeasurement(std::string{ agent.Transitions[transitionIdx].first } + "::ToTransition",
+				Measure(nrIterations, [&]() { isChecked ^= pTransition->ToTransition(&agent.Blackboard); }));
+		}
+
+		for (size_t stateIdx{ 0 }; stateIdx < AgentStateGraph::NrStates; ++stateIdx)
+		{
+			BenchAgent agent{ &benchInterface };
+			Elite::FSMState* pState{ agent.States[stateIdx].second };
+			const std::string name{ agent.States[stateIdx].first };
+			addMeasurement(name + "::OnEnter", Measure(nrIterations, [&]() { pState->OnEnter(&agent.Blackboard); }));
+			addMeasurement(name + "::Update", Measure(nrIterations, [&]() { pState->Update(&agent.Blackboard, BenchAgent::m_DeltaTime); }));
+			addMeasurement(name + "::OnExit", Measure(nrIterations, [&]() { pState->OnExit(&agent.Blackboard); }));
+		}
+
+		{
+			BenchAgent agent{ &benchInterface };
+			const AgentInfo agentInfo{ agent.Blackboard.Get<BB::Agent>() };
+			const TargetData target{ agentInfo.Position + Elite::Vector2{ 10.f, 5.f } };
+			Seek seek{};
+			Flee flee{};
+			Face face{};
+			Wander wander{};
+			seek.SetTarget(target);
+			flee.SetTarget(target);
+			face.SetTarget(target);
+			BlendedSteering blended{ { { &flee, 0.8f }, { &wander, 0.2f } } };
+			Elite::Vector2 checksum{};
+			addMeasurement("Seek::CalculateSteering", Measure(nrIterations, [&]() { checksum += seek.CalculateSteering(BenchAgent::m_DeltaTime, agentInfo).LinearVelocity; }));
+			addMeasurement("Flee::CalculateSteering", Measure(nrIterations, [&]() { checksum += flee.CalculateSteering(BenchAgent::m_DeltaTime, agentInfo).LinearVelocity; }));
+			addMeasurement("Face::CalculateSteering", Measure(nrIterations, [&]() { checksum.x += face.CalculateSteering(BenchAgent::m_DeltaTime, agentInfo).AngularVelocity; }));
+			addMeasurement("Wander::CalculateSteering", Measure(nrIterations, [&]() { checksum += wander.CalculateSteering(BenchAgent::m_DeltaTime, agentInfo).LinearVelocity; }));
+			addMeasurement("BlendedSteering::CalculateSteering", Measure(nrIterations, [&]() { checksum += blended.CalculateSteering(BenchAgent::m_DeltaTime, agentInfo).LinearVelocity; }));
+			//through the context the bench world filled in, what a fleeing agent pays
+			agent.Controller.SetToContextFlee(agent.Blackboard.Get<BB::Context>(), target);
+			addMeasurement("SteeringController (context flee)", Measure(nrIterations, [&]() { checksum += agent.Controller.CalculateSteering(BenchAgent::m_DeltaTime, agentInfo).LinearVelocity; }));
+
+			agent.Controller.SetToEvade(agent.Blackboard.Get<BB::Enemies>(), target);
+			addMeasurement("SteeringController (evade)", Measure(nrIterations, [&]() { checksum += agent.Controller.CalculateSteering(BenchAgent::m_DeltaTime, agentInfo).LinearVelocity; }));
+
+			//the typed keys against the string API that still backs the debug tooling
+			const std::string agentName{ "Agent" };
+			const std::string nrShotsName{ "NrTimesToShoot" };
+			int nrShots{ 0 };
+			AgentInfo agentCopy{};
+			addMeasurement("Blackboard::Get<Key>", Measure(nrIterations, [&]() { nrShots += agent.Blackboard.Get<BB::NrTimesToShoot>()++; }));
+			addMeasurement("Blackboard::GetData", Measure(nrIterations, [&]() { agent.Blackboard.GetData(agentName, agentCopy); }));
+			addMeasurement("Blackboard::ChangeData", Measure(nrIterations, [&]() { agent.Blackboard.ChangeData(nrShotsName, ++nrShots); }));
+			//keeps the timed loops from being thrown away
+			if (checksum.x == FLT_MAX || agentCopy.Health == FLT_MAX)
+				printf("%f %d\n", checksum.x, nrShots);
+		}
+	}
+
+	//the whole plugin as a host drives it, one tick per operation
+	Measurement MeasureTick(size_t nrEntities, int nrIterations, const std::string& levelFile)
+	{
+		BenchExamInterface benchInterface{ nrEntities };
+		IExamPlugin* pPlugin{ static_cast<IExamPlugin*>(Register()) };
+		pPlugin->DllInit();
+		GameDebugParams params{};
+		params.LevelFile = levelFile;
+		pPlugin->InitGameDebugParams(params);
+		PluginInfo info{};
+		pPlugin->Initialize(&benchInterface, info);
+
+		Elite::Vector2 checksum{};
+		const Measurement measurement{ Measure(nrIterations, [&]() { checksum += pPlugin->UpdateSteering(BenchAgent::m_DeltaTime).LinearVelocity; }) };
+		if (checksum.x == FLT_MAX)
+			printf("%f\n", checksum.x);
+
+		pPlugin->DllShutdown();
+		delete pPlugin;
+		return measurement;
+	}
+}
+
+//usage: gpp_component_bench [--iterations N] [--level FILE]
+//without a level the plugin has no flow field, with one the tick also pays for the wall feelers
+//exits with 1 if a warmed up UpdateSteering tick allocates
+int main(int argc, char* argv[])
+{
+	int nrIterations{ 10000 };
+	std::string levelFile{};
+	for (int i{ 1 }; i + 1 < argc; i += 2)
+	{
+		const std::string arg{ argv[i] };
+		if (arg == "--iterations")
+			nrIterations = atoi(argv[i + 1]);
+		else if (arg == "--level")
+			levelFile = argv[i + 1];
+		else
+		{
+			printf("Unknown argument '%s'\n", arg.c_str());
+			return 1;
+		}
+	}
+
+	//the FSM logs state changes, keep the report readable
+	Elite::Logger::GetInstance().SetOutput(nullptr);
+
+	const size_t entityCounts[]{ 0, 10, 100, 1000 };
+	std::vector<Row> rows{};
+	for (size_t nrEntities : entityCounts)
+	{
+		MeasureComponents(nrEntities, nrIterations, rows);
+	}
+	Row tickRow{ "Plugin::UpdateSteering", {} };
+	for (size_t nrEntities : entityCounts)
+	{
+		tickRow.Measurements.push_back(MeasureTick(nrEntities, nrIterations, levelFile));
+	}
+	rows.push_back(tickRow);
+
+	printf("Iterations: %d, level: %s\n", nrIterations, levelFile.empty() ? "none" : levelFile.c_str());
+	printf("%-48s", "ns/op (allocs/op) for entities in view");
+	for (size_t nrEntities : entityCounts)
+		printf(" %19zu", nrEntities);
+	printf("\n");
+	for (const Row& row : rows)
+	{
+		printf("%-48s", row.Name.c_str());
+		for (const Measurement& measurement : row.Measurements)
+			printf(" %10.1f (%6.2f)", measurement.Nanoseconds, measurement.NrAllocations);
+		printf("\n");
+	}
+
+	bool isAllocationFree{ true };
+	for (const Measurement& measurement : tickRow.Measurements)
+	{
+		isAllocationFree &= measurement.NrAllocations == 0.0;
+	}
+	printf("%s\n", isAllocationFree ? "PASS: a warmed up tick doesn't allocate" : "FAIL: a warmed up tick allocates");
+	return isAllocationFree ? 0 : 1;
+}
@@ -0,0 +1,168 @@
+#include "stdafx.h"
+#include "BlendedSteering.h"
+#include "ContextSteering.h"
+#include "ContextSteering.inl"
+#include "BenchCommon.h"
+
+//the plugin only steers with 16 slots, the 32 slot map is compiled in for this bench alone
+template class ContextMap<32>;
+
+//Time per agent of fleeing through a context map of 16 and 32 slots against the blended flee and wander the plugin used before
+//every scene has an agent with enemies around it, exits with 1 if a context map picks a direction that isn't among its safest slots
+namespace
+{
+	//the plugin's settings for the enemies
+	const float g_EnemyClearance{ 1.5f };
+	const float g_EnemyDangerRange{ 15.f };
+	const float g_WanderWeight{ 0.25f };
+
+	struct Scene
+	{
+		AgentInfo Agent;
+		std::vector<EnemyInfo> Enemies;
+		Elite::Vector2 Threat; //the closest enemy, what gets fled from
+	};
+
+	std::vector<Scene> CreateScenes(size_t nrScenes, size_t nrEnemies)
+	{
+		std::minstd_rand rng{ 1 };
+		std::uniform_real_distribution<float> position{ -250.f, 250.f };
+		std::uniform_real_distribution<float> angle{ 0.f, 2.f * float(E_PI) };
+		std::uniform_real_distribution<float> distance{ 2.f, g_EnemyDangerRange };
+		std::vector<Scene> scenes(nrScenes);
+		for (Scene& scene : scenes)
+		{
+			scene.Agent.Position = Elite::Vector2{ position(rng), position(rng) };
+			scene.Agent.MaxLinearSpeed = 5.f;
+			scene.Agent.Orientation = angle(rng);
+			scene.Enemies.resize(nrEnemies);
+			float closestDistance{ FLT_MAX };
+			for (EnemyInfo& enemy : scene.Enemies)
+			{
+				const float enemyAngle{ angle(rng) };
+				const float enemyDistance{ distance(rng) };
+				enemy.Location = scene.Agent.Position + Elite::Vector2{ cosf(enemyAngle), sinf(enemyAngle) } * enemyDistance;
+				enemy.Size = 1.f;
+				if (enemyDistance < closestDistance)
+				{
+					closestDistance = enemyDistance;
+					scene.Threat = enemy.Location;
+				}
+			}
+		}
+		return scenes;
+	}
+
+	//what the plugin does in a tick: the dangers once, then the interest of the flee mode on top
+	template<int TNrSlots>
+	bool ContextFlee(const Scene& scene, Wander& wander, ContextMap<TNrSlots>& context, Elite::Vector2& direction)
+	{
+		context.Clear();
+		for (const EnemyInfo& enemy : scene.Enemies)
+		{
+			context.AddObstacle(scene.Agent.Position, enemy.Location, enemy.Size / 2.f, g_EnemyClearance, g_EnemyDangerRange);
+		}
+		context.AddInterest((scene.Agent.Position - scene.Threat).GetNormalized(), 1.f);
+		context.AddInterest((wander.GetNextTarget(scene.Agent) - scene.Agent.Position).GetNormalized(), g_WanderWeight);
+		return context.ChooseDirection(direction);
+	}
+
+	//index of the slot direction points into
+	template<int TNrSlots>
+	int GetSlotIdx(const Elite::Vector2& direction)
+	{
+		const float angle{ atan2f(direction.y, direction.x) };
+		return (int(roundf(angle / (2.f * float(E_PI)) * TNrSlots)) + TNrSlots) % TNrSlots;
+	}
+
+	template<int TNrSlots>
+	bool IsSafest(const ContextMap<TNrSlots>& context, int slotIdx)
+	{
+		float minDanger{ FLT_MAX };
+		for (int i{ 0 }; i < TNrSlots; ++i)
+		{
+			minDanger = (std::min)(minDanger, context.GetDanger(i));
+		}
+		return context.GetDanger(slotIdx) <= minDanger + ContextMap<TNrSlots>::DangerTolerance;
+	}
+
+	//times every scene nrIterations times, then checks the directions of the last pass
+	template<int TNrSlots>
+	double RunContext(const std::vector<Scene>& scenes, int nrIterations, size_t& nrMasked, size_t& nrBlocked)
+	{
+		Wander wander{};
+		ContextMap<TNrSlots> context{};
+		Elite::Vector2 direction{};
+		const double nanoseconds{ Bench::TimePerScene(scenes, nrIterations, [&wander, &context, &direction](const Scene& scene)
+		{
+			ContextFlee(scene, wander, context, direction);
+			return direction;
+		}) };
+
+		for (const Scene& scene : scenes)
+		{
+			if (!ContextFlee(scene, wander, context, direction))
+			{
+				++nrBlocked;
+			}
+			else if (!IsSafest(context, GetSlotIdx<TNrSlots>(direction)))
+			{
+				++nrMasked;
+			}
+		}
+		return nanoseconds;
+	}
+}
+
+//usage: gpp_context_bench [--scenes N] [--enemies N] [--iterations N]
+int main(int argc, char* argv[])
+{
+	size_t nrScenes{ 10000 };
+	size_t nrEnemies{ 8 };
+	int nrIterations{ 20 };
+	if (!Bench::ParseArgs(argc, argv, { { "--scenes", nrScenes }, { "--enemies", nrEnemies }, { "--iterations", nrIterations } }))
+		return 1;
+
+	const std::vector<Scene> scenes{ CreateScenes(nrScenes, nrEnemies) };
+
+	//the blend only knows about the closest enemy, counts how often it heads into one of the others
+	Flee flee{};
+	Wander wander{};
+	BlendedSteering blended{ { { &flee, 0.8f }, { &wander, 0.2f } } };
+	SteeringContext context{};
+	const double blendedTime{ Bench::TimePerScene(scenes, nrIterations, [&flee, &blended](const Scene& scene)
+	{
+		flee.SetTarget(TargetData{ scene.Threat });
+		return blended.CalculateSteering(0.016f, scene.Agent).LinearVelocity;
+	}) };
+	size_t nrBlendedIntoDanger{ 0 };
+	for (const Scene& scene : scenes)
+	{
+		flee.SetTarget(TargetData{ scene.Threat });
+		const Elite::Vector2 velocity{ blended.CalculateSteering(0.016f, scene.Agent).LinearVelocity };
+		Elite::Vector2 direction{};
+		ContextFlee(scene, wander, context, direction);
+		if (!IsSafest(context, GetSlotIdx<SteeringContext::NrSlots>(velocity)))
+		{
+			++nrBlendedIntoDanger;
+		}
+	}
+
+	size_t nrMasked16{ 0 };
+	size_t nrBlocked16{ 0 };
+	const double contextTime16{ RunContext<16>(scenes, nrIterations, nrMasked16, nrBlocked16) };
+	size_t nrMasked32{ 0 };
+	size_t nrBlocked32{ 0 };
+	const double contextTime32{ RunContext<32>(scenes, nrIterations, nrMasked32, nrBlocked32) };
+
+	const auto toPercentage{ [nrScenes](size_t count) { return 100.0 * count / nrScenes; } };
+	printf("Scenes: %zu, enemies per scene: %zu, Iterations: %d\n", nrScenes, nrEnemies, nrIterations);
+	printf("%-12s %10s %18s %16s\n", "Path", "ns/agent", "into danger (%)", "no safe way (%)");
+	printf("%-12s %10.1f %18.2f %16s\n", "Blended", blendedTime, toPercentage(nrBlendedIntoDanger), "-");
+	printf("%-12s %10.1f %18.2f %16.2f\n", "Context16", contextTime16, toPercentage(nrMasked16), toPercentage(nrBlocked16));
+	printf("%-12s %10.1f %18.2f %16.2f\n", "Context32", contextTime32, toPercentage(nrMasked32), toPercentage(nrBlocked32));
+
+	const bool isSafe{ nrMasked16 == 0 && nrMasked32 == 0 };
+	printf("%s\n", isSafe ? "PASS: the context maps only steer through their safest slots" : "FAIL: a context map steered into a masked slot");
+	return isSafe ? 0 : 1;
+}
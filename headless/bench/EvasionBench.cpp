@@ -0,0 +1,77 @@
+#include "stdafx.h"
+#include "EnemyEvasion.h"
+#include "BenchCommon.h"
+
+//Time of EnemyEvasion::GetAvoidance against the same closest approach math one enemy at a time, from one to a thousand enemies
+//every scene has a moving agent with enemies closing in from all around, exits with 1 if the two disagree on a scene
+namespace
+{
+	//what the plugin's evade mode asks for
+	const float g_Clearance{ 1.f };
+	const float g_Horizon{ 1.5f };
+
+	std::vector<Bench::EnemyScene> CreateScenes(size_t nrScenes, size_t nrEnemies)
+	{
+		return Bench::CreateEnemyScenes(nrScenes, nrEnemies, 20.f, [](Bench::EnemyScene& scene, std::minstd_rand& rng)
+		{
+			std::uniform_real_distribution<float> angle{ 0.f, 2.f * float(E_PI) };
+			std::uniform_real_distribution<float> speed{ 0.f, 4.f };
+			scene.Agent.LinearVelocity = Elite::OrientationToVector(angle(rng)) * 5.f;
+			scene.Agent.AgentSize = 1.f;
+			for (EnemyInfo& enemy : scene.Enemies)
+			{
+				//mostly heading for the agent, some just wandering past
+				const Elite::Vector2 toAgent{ (scene.Agent.Position - enemy.Location).GetNormalized() };
+				enemy.LinearVelocity = (toAgent + Elite::OrientationToVector(angle(rng)) * 0.5f) * speed(rng);
+				enemy.Size = 1.f;
+			}
+		});
+	}
+
+	Elite::Vector2 GetAvoidance(const Bench::EnemyScene& scene)
+	{
+		return EnemyEvasion::GetAvoidance(scene.Frame, scene.Agent, g_Clearance, g_Horizon);
+	}
+
+	//the closest approach to one enemy at a time, straight from its EnemyInfo
+	Elite::Vector2 GetReferenceAvoidance(const Bench::EnemyScene& scene)
+	{
+		Elite::Vector2 avoidance{};
+		for (const EnemyInfo& enemy : scene.Enemies)
+		{
+			const Elite::Vector2 toEnemy{ enemy.Location - scene.Agent.Position };
+			const Elite::Vector2 velocity{ enemy.LinearVelocity - scene.Agent.LinearVelocity };
+			const float approachTime{ Elite::Clamp(-toEnemy.Dot(velocity) / (std::max)(velocity.SqrtMagnitude(), 1e-6f), 0.f, g_Horizon) };
+			const Elite::Vector2 closest{ toEnemy + velocity * approachTime };
+			const float collisionDistance{ enemy.Size + scene.Agent.AgentSize + g_Clearance };
+			const float closestDistance{ closest.Magnitude() };
+			if (closestDistance < collisionDistance)
+			{
+				//head on there's no side to push to, away from the enemy then
+				const Elite::Vector2 away{ closestDistance < 1e-2f ? toEnemy : closest };
+				avoidance -= away / (std::max)(away.Magnitude(), 1e-2f) * (1.f - approachTime / g_Horizon) * (1.f - closestDistance / collisionDistance);
+			}
+		}
+		return avoidance;
+	}
+
+	//the sums are added up in a different order, allow for the rounding of that
+	bool IsMismatch(const Bench::EnemyScene& scene)
+	{
+		const Elite::Vector2 reference{ GetReferenceAvoidance(scene) };
+		return (GetAvoidance(scene) - reference).Magnitude() > 1e-4f * (1.f + reference.Magnitude());
+	}
+}
+
+//usage: gpp_evasion_bench [--scenes N] [--iterations N]
+int main(int argc, char* argv[])
+{
+	size_t nrScenes{ 200 };
+	int nrIterations{ 50 };
+	if (!Bench::ParseArgs(argc, argv, { { "--scenes", nrScenes }, { "--iterations", nrIterations } }))
+		return 1;
+
+	const bool isMatching{ Bench::CompareWithReference(nrScenes, nrIterations, CreateScenes, GetAvoidance, GetReferenceAvoidance, IsMismatch) == 0 };
+	printf("%s\n", isMatching ? "PASS: the evasion matches the per enemy closest approach" : "FAIL: the evasion differs from the per enemy closest approach");
+	return isMatching ? 0 : 1;
+}
@@ -0,0 +1,221 @@
+#include "stdafx.h"
+#include "SteeringBehaviors.h"
+#include "SteeringBatch.h"
+#include <chrono>
+
+//Agents per second of the batch steering kernels against one virtual CalculateSteering call per agent
+//also checks the kernels against the per agent behaviors, exits with 1 if they don't match
+namespace
+{
+	enum class eBehavior
+	{
+		SEEK,
+		FLEE,
+		FACE,
+		WANDER,
+
+		//@END
+		_COUNT
+	};
+
+	const char* GetBehaviorName(eBehavior behavior)
+	{
+		switch (behavior)
+		{
+		case eBehavior::SEEK: return "Seek";
+		case eBehavior::FLEE: return "Flee";
+		case eBehavior::FACE: return "Face";
+		case eBehavior::WANDER: return "Wander";
+		default: return "Unknown";
+		}
+	}
+
+	struct Agents
+	{
+		std::vector<AgentInfo> Infos;
+		std::vector<Elite::Vector2> Targets;
+		std::vector<float> WanderAngles;
+		std::vector<float> WanderAngleDeltas;
+	};
+
+	Agents CreateAgents(size_t nrAgents)
+	{
+		std::minstd_rand rng{ 1 };
+		std::uniform_real_distribution<float> position{ -250.f, 250.f };
+		std::uniform_real_distribution<float> unit{ -1.f, 1.f };
+		Agents agents{};
+		agents.Infos.resize(nrAgents);
+		for (size_t i{ 0 }; i < nrAgents; ++i)
+		{
+			AgentInfo& info{ agents.Infos[i] };
+			info.Position = Elite::Vector2{ position(rng), position(rng) };
+			info.LinearVelocity = Elite::Vector2{ 5.f * unit(rng), 5.f * unit(rng) };
+			info.Orientation = b2_pi * unit(rng);
+			info.MaxLinearSpeed = 5.f + unit(rng);
+			info.MaxAngularSpeed = 1.f;
+			agents.Targets.push_back(Elite::Vector2{ position(rng), position(rng) });
+			agents.WanderAngles.push_back(20.f * unit(rng));
+			agents.WanderAngleDeltas.push_back(ToRadians(45) * unit(rng));
+		}
+		return agents;
+	}
+
+	void FillBatch(const Agents& agents, SteeringBatch& batch)
+	{
+		batch.Resize(agents.Infos.size());
+		for (size_t i{ 0 }; i < agents.Infos.size(); ++i)
+		{
+			batch.SetAgent(i, agents.Infos[i]);
+			batch.SetTarget(i, agents.Targets[i]);
+			batch.WanderAngle[i] = agents.WanderAngles[i];
+			batch.WanderAngleDelta[i] = agents.WanderAngleDeltas[i];
+		}
+	}
+
+	void RunBatch(const BatchSteering& steering, eBehavior behavior, SteeringBatch& batch)
+	{
+		switch (behavior)
+		{
+		case eBehavior::SEEK: steering.Seek(batch); break;
+		case eBehavior::FLEE: steering.Flee(batch); break;
+		case eBehavior::FACE: steering.Face(batch); break;
+		case eBehavior::WANDER: steering.Wander(batch); break;
+		default: break;
+		}
+	}
+
+	std::unique_ptr<ISteeringBehavior> CreateBehavior(eBehavior behavior)
+	{
+		switch (behavior)
+		{
+		case eBehavior::SEEK: return std::make_unique<Seek>();
+		case eBehavior::FLEE: return std::make_unique<Flee>();
+		case eBehavior::FACE: return std::make_unique<Face>();
+		default: return std::make_unique<Wander>();
+		}
+	}
+
+	double GetAgentsPerSecond(size_t nrAgents, int nrIterations, std::chrono::steady_clock::duration elapsed)
+	{
+		const double seconds{ std::chrono::duration<double>(elapsed).count() };
+		return nrAgents * double(nrIterations) / (std::max)(seconds, 1e-9);
+	}
+
+	//face only turns one way or the other, the polynomial atan2 may only disagree where the angle lies on the facing threshold
+	bool IsFaceMismatchAllowed(const AgentInfo& info, const Elite::Vector2& target)
+	{
+		const Elite::Vector2 toTarget{ target - info.Position };
+		const float difference{ abs(atan2f(toTarget.x, -toTarget.y) - info.Orientation) };
+		const float tolerance{ 1e-5f };
+		return abs(difference - 0.1f) < tolerance || difference < tolerance;
+	}
+}
+
+//usage: gpp_steering_bench [--agents N] [--iterations N]
+int main(int argc, char* argv[])
+{
+	size_t nrAgents{ 100000 };
+	int nrIterations{ 50 };
+	for (int i{ 1 }; i + 1 < argc; i += 2)
+	{
+		const std::string arg{ argv[i] };
+		if (arg == "--agents")
+			nrAgents = static_cast<size_t>(atoi(argv[i + 1]));
+		else if (arg == "--iterations")
+			nrIterations = atoi(argv[i + 1]);
+		else
+		{
+			printf("Unknown argument '%s'\n", arg.c_str());
+			return 1;
+		}
+	}
+
+	const Agents agents{ CreateAgents(nrAgents) };
+	const float maxLinearError{ 1e-3f };
+	bool isMatching{ true };
+
+	printf("Agents: %zu, Iterations: %d, best kernel: %s\n", nrAgents, nrIterations, BatchSteering::GetKernelName(BatchSteering::GetBestKernel()));
+	printf("%-8s %-10s %16s %12s\n", "Behavior", "Path", "Agents/s", "Speedup");
+	for (int behaviorIdx{ 0 }; behaviorIdx < int(eBehavior::_COUNT); ++behaviorIdx)
+	{
+		const eBehavior behavior{ static_cast<eBehavior>(behaviorIdx) };
+
+		//per agent path, one behavior per agent like the plugin uses them
+		std::vector<std::unique_ptr<ISteeringBehavior>> behaviors{};
+		for (size_t i{ 0 }; i < nrAgents; ++i)
+		{
+			behaviors.push_back(CreateBehavior(behavior));
+			behaviors.back()->SetTarget(TargetData{ agents.Targets[i] });
+		}
+		std::vector<SteeringPlugin_Output> virtualOutput(nrAgents);
+		const auto virtualStart{ std::chrono::steady_clock::now() };
+		for (int iteration{ 0 }; iteration < nrIterations; ++iteration)
+		{
+			for (size_t i{ 0 }; i < nrAgents; ++i)
+			{
+				virtualOutput[i] = behaviors[i]->CalculateSteering(0.016f, agents.Infos[i]);
+			}
+		}
+		const double virtualRate{ GetAgentsPerSecond(nrAgents, nrIterations, std::chrono::steady_clock::now() - virtualStart) };
+		printf("%-8s %-10s %16.0f %12s\n", GetBehaviorName(behavior), "Virtual", virtualRate, "1.0x");
+
+		//the scalar kernel is the reference for the SIMD ones, Wander draws its own random numbers so it can't be compared per agent
+		SteeringBatch reference{};
+		FillBatch(agents, reference);
+		RunBatch(BatchSteering{ eSteeringKernel::SCALAR }, behavior, reference);
+		if (behavior != eBehavior::WANDER)
+		{
+			for (size_t i{ 0 }; i < nrAgents; ++i)
+			{
+				const SteeringPlugin_Output scalar{ reference.GetSteering(i) };
+				if (scalar.LinearVelocity != virtualOutput[i].LinearVelocity || scalar.AngularVelocity != virtualOutput[i].AngularVelocity)
+				{
+					printf("MISMATCH: %s scalar kernel differs from the behavior for agent %zu\n", GetBehaviorName(behavior), i);
+					isMatching = false;
+					break;
+				}
+			}
+		}
+
+		for (int kernelIdx{ 0 }; kernelIdx < int(eSteeringKernel::_COUNT); ++kernelIdx)
+		{
+			const eSteeringKernel kernel{ static_cast<eSteeringKernel>(kernelIdx) };
+			if (!BatchSteering::IsKernelSupported(kernel))
+			{
+				printf("%-8s %-10s %16s %12s\n", GetBehaviorName(behavior), BatchSteering::GetKernelName(kernel), "unsupported", "-");
+				continue;
+			}
+
+			const BatchSteering steering{ kernel };
+			SteeringBatch batch{};
+			FillBatch(agents, batch);
+			RunBatch(steering, behavior, batch);
+			for (size_t i{ 0 }; i < nrAgents; ++i)
+			{
+				const SteeringPlugin_Output expected{ reference.GetSteering(i) };
+				const SteeringPlugin_Output actual{ batch.GetSteering(i) };
+				const bool isLinearMatching{ (expected.LinearVelocity - actual.LinearVelocity).Magnitude() <= maxLinearError };
+				const bool isAngularMatching{ expected.AngularVelocity == actual.AngularVelocity || IsFaceMismatchAllowed(agents.Infos[i], agents.Targets[i]) };
+				if (!isLinearMatching || !isAngularMatching)
+				{
+					printf("MISMATCH: %s %s kernel differs from the scalar kernel for agent %zu\n", GetBehaviorName(behavior), BatchSteering::GetKernelName(kernel), i);
+					isMatching = false;
+					break;
+				}
+			}
+
+			//wander keeps turning its angle, refill so every path starts from the same state
+			FillBatch(agents, batch);
+			const auto batchStart{ std::chrono::steady_clock::now() };
+			for (int iteration{ 0 }; iteration < nrIterations; ++iteration)
+			{
+				RunBatch(steering, behavior, batch);
+			}
+			const double batchRate{ GetAgentsPerSecond(nrAgents, nrIterations, std::chrono::steady_clock::now() - batchStart) };
+			printf("%-8s %-10s %16.0f %11.1fx\n", GetBehaviorName(behavior), BatchSteering::GetKernelName(kernel), batchRate, batchRate / virtualRate);
+		}
+	}
+
+	printf("%s\n", isMatching ? "PASS: the kernels match the per agent behaviors" : "FAIL: the kernels don't match the per agent behaviors");
+	return isMatching ? 0 : 1;
+}
@@ -0,0 +1,88 @@
+#include "stdafx.h"
+#include "TargetSelection.h"
+#include "BenchCommon.h"
+
+//Time of TargetSelection::SelectTarget, scoring 4 enemies at a time, against scoring one EnemyInfo at a time, from one to a thousand enemies
+//every scene has an agent with enemies of random health around it, exits with 1 if the two pick targets of a different score
+//or the selection asks for another number of shots than the target's health
+namespace
+{
+	//what CanKillZombieTransition asks for
+	const float g_Range{ 10.f };
+
+	std::vector<Bench::EnemyScene> CreateScenes(size_t nrScenes, size_t nrEnemies)
+	{
+		return Bench::CreateEnemyScenes(nrScenes, nrEnemies, 2.f * g_Range, [](Bench::EnemyScene& scene, std::minstd_rand& rng)
+		{
+			std::uniform_real_distribution<float> angle{ 0.f, 2.f * float(E_PI) };
+			std::uniform_real_distribution<float> speed{ 0.f, 4.f };
+			std::uniform_int_distribution<int> health{ 1, 6 };
+			scene.Agent.MaxLinearSpeed = 5.f;
+			scene.Ammo = health(rng);
+			for (EnemyInfo& enemy : scene.Enemies)
+			{
+				enemy.LinearVelocity = Elite::OrientationToVector(angle(rng)) * speed(rng);
+				enemy.Health = health(rng);
+			}
+		});
+	}
+
+	size_t SelectTarget(const Bench::EnemyScene& scene)
+	{
+		size_t targetIdx{};
+		int nrShots{};
+		return TargetSelection::SelectTarget(scene.Frame, scene.Agent, g_Range, scene.Ammo, targetIdx, nrShots) ? targetIdx + size_t(nrShots) : size_t(0);
+	}
+
+	//the same score, one enemy at a time straight from its EnemyInfo, lowest() if none can be killed
+	float GetReferenceBestScore(const Bench::EnemyScene& scene)
+	{
+		const Elite::Vector2 forward{ Elite::OrientationToVector(scene.Agent.Orientation) };
+		float bestScore{ std::numeric_limits<float>::lowest() };
+		for (const EnemyInfo& enemy : scene.Enemies)
+		{
+			const Elite::Vector2 toEnemy{ enemy.Location - scene.Agent.Position };
+			const float distance{ toEnemy.Magnitude() };
+			if (distance >= g_Range || enemy.Health > scene.Ammo)
+				continue;
+			const Elite::Vector2 direction{ toEnemy / (std::max)(distance, 1e-2f) };
+			const float closing{ Elite::Clamp(-enemy.LinearVelocity.Dot(direction) / scene.Agent.MaxLinearSpeed, -1.f, 1.f) };
+			const float score{ (1.f - distance / g_Range) - float(enemy.Health) / float(scene.Ammo) + 0.5f * forward.Dot(direction) + 0.5f * closing };
+			bestScore = (std::max)(bestScore, score);
+		}
+		return bestScore;
+	}
+
+	//score of the target SelectTarget picked, lowest() if it didn't pick one
+	//a pick that takes another number of shots than the target's health is never right, max() then
+	float GetSelectedScore(const Bench::EnemyScene& scene)
+	{
+		size_t targetIdx{};
+		int nrShots{};
+		if (!TargetSelection::SelectTarget(scene.Frame, scene.Agent, g_Range, scene.Ammo, targetIdx, nrShots))
+			return std::numeric_limits<float>::lowest();
+		if (nrShots != scene.Enemies[targetIdx].Health)
+			return (std::numeric_limits<float>::max)();
+		const Bench::EnemyScene single{ scene.Agent, scene.Ammo, { scene.Enemies[targetIdx] }, {} };
+		return GetReferenceBestScore(single);
+	}
+
+	//near ties can go either way with the rounding, only a worse pick counts
+	bool IsMismatch(const Bench::EnemyScene& scene)
+	{
+		return abs(GetSelectedScore(scene) - GetReferenceBestScore(scene)) > 1e-4f;
+	}
+}
+
+//usage: gpp_target_bench [--scenes N] [--iterations N]
+int main(int argc, char* argv[])
+{
+	size_t nrScenes{ 200 };
+	int nrIterations{ 50 };
+	if (!Bench::ParseArgs(argc, argv, { { "--scenes", nrScenes }, { "--iterations", nrIterations } }))
+		return 1;
+
+	const bool isMatching{ Bench::CompareWithReference(nrScenes, nrIterations, CreateScenes, SelectTarget, GetReferenceBestScore, IsMismatch) == 0 };
+	printf("%s\n", isMatching ? "PASS: the selection picks the best scoring target" : "FAIL: the selection picked a worse target than the per enemy scoring or the wrong number of shots");
+	return isMatching ? 0 : 1;
+}
@@ -0,0 +1,263 @@
+#include "stdafx.h"
+#include "ThreatMap.h"
+#include <chrono>
+
+//Time per tick of the threat map, with many remembered enemies of which the agent only sees the ones close to it
+//also runs the same decay and spread over every cell of a plain grid next to it, exits with 1 if the dirty tiles drift from that
+namespace
+{
+	//ThreatMap with its default settings, without tiles
+	class ReferenceMap final
+	{
+	public:
+		explicit ReferenceMap(const WorldInfo& worldInfo)
+		{
+			const int nrCells{ int(ceilf((worldInfo.Dimensions.x + 2.f * m_Margin) / m_CellSize / ThreatMap::TileSize)) * ThreatMap::TileSize };
+			m_Size = nrCells;
+			m_Stride = nrCells + 2;
+			m_Origin = worldInfo.Center - Elite::Vector2{ float(nrCells), float(nrCells) } * (m_CellSize / 2.f);
+			m_Front.assign(size_t(m_Stride) * m_Stride, 0.f);
+			m_Back = m_Front;
+		}
+
+		void Update(float deltaTime)
+		{
+			const float decay{ expf(-deltaTime / m_FadeTime) };
+			const float spread{ (std::min)(m_SpreadRate * deltaTime, 1.f) };
+			for (int y{ 1 }; y <= m_Size; ++y)
+			{
+				for (int x{ 1 }; x <= m_Size; ++x)
+				{
+					const int idx{ y * m_Stride + x };
+					const float neighbours{ m_Front[idx - 1] + m_Front[idx + 1] + m_Front[idx - m_Stride] + m_Front[idx + m_Stride] };
+					const float threat{ decay * (1.f - spread) * m_Front[idx] + decay * spread * 0.25f * neighbours };
+					m_Back[idx] = threat >= 1e-7f ? threat : 0.f;
+				}
+			}
+			m_Front.swap(m_Back);
+		}
+
+		void Splat(const EnemyInfo& enemyInfo, float deltaTime)
+		{
+			const float threat{ deltaTime / m_FadeTime };
+			AddThreat(enemyInfo.Location, threat * 0.5f);
+			AddThreat(enemyInfo.Location + enemyInfo.LinearVelocity * m_PredictionTime, threat * 0.5f);
+		}
+
+		float Sample(const Elite::Vector2& position) const
+		{
+			const float gridX{ (position.x - m_Origin.x) / m_CellSize - 0.5f };
+			const float gridY{ (position.y - m_Origin.y) / m_CellSize - 0.5f };
+			const int cellX{ int(floorf(gridX)) };
+			const int cellY{ int(floorf(gridY)) };
+			const float tX{ gridX - cellX };
+			const float tY{ gridY - cellY };
+			const float* pCell{ &m_Front[(cellY + 1) * m_Stride + cellX + 1] };
+			const float bottom{ pCell[0] + (pCell[1] - pCell[0]) * tX };
+			const float top{ pCell[m_Stride] + (pCell[m_Stride + 1] - pCell[m_Stride]) * tX };
+			return bottom + (top - bottom) * tY;
+		}
+
+	private:
+		void AddThreat(const Elite::Vector2& position, float threat)
+		{
+			const float gridX{ (position.x - m_Origin.x) / m_CellSize - 0.5f };
+			const float gridY{ (position.y - m_Origin.y) / m_CellSize - 0.5f };
+			const int cellX{ int(floorf(gridX)) };
+			const int cellY{ int(floorf(gridY)) };
+			const float tX{ gridX - cellX };
+			const float tY{ gridY - cellY };
+			for (int offsetY{ 0 }; offsetY < 2; ++offsetY)
+			{
+				for (int offsetX{ 0 }; offsetX < 2; ++offsetX)
+				{
+					const int x{ cellX + offsetX };
+					const int y{ cellY + offsetY };
+					if (x >= 0 && x < m_Size && y >= 0 && y < m_Size)
+					{
+						m_Front[(y + 1) * m_Stride + x + 1] += threat * (offsetX ? tX : 1.f - tX) * (offsetY ? tY : 1.f - tY);
+					}
+				}
+			}
+		}
+
+		const float m_CellSize{ 4.f };
+		const float m_Margin{ 20.f };
+		const float m_FadeTime{ 2.f };
+		const float m_SpreadRate{ 4.f };
+		const float m_PredictionTime{ 0.5f };
+		int m_Size{};
+		int m_Stride{};
+		Elite::Vector2 m_Origin{};
+		std::vector<float> m_Front;
+		std::vector<float> m_Back;
+	};
+
+	//the enemies walk straight and bounce off the border of the world
+	void MoveEnemies(std::vector<EnemyInfo>& enemies, float halfWorldSize, float deltaTime)
+	{
+		for (EnemyInfo& enemy : enemies)
+		{
+			enemy.Location += enemy.LinearVelocity * deltaTime;
+			if (abs(enemy.Location.x) > halfWorldSize)
+				enemy.LinearVelocity.x = -enemy.LinearVelocity.x;
+			if (abs(enemy.Location.y) > halfWorldSize)
+				enemy.LinearVelocity.y = -enemy.LinearVelocity.y;
+		}
+	}
+
+	struct RunResult
+	{
+		std::chrono::steady_clock::duration MapTime;
+		std::chrono::steady_clock::duration SlowestTick;
+		std::chrono::steady_clock::duration ReferenceTime;
+		size_t NrSplats;
+		size_t NrDirtyTiles;
+		float LargestError;
+	};
+
+	//the same enemies and the same walk every run, only the timings differ
+	RunResult Run(size_t nrEnemies, int nrTicks, float viewRange)
+	{
+		WorldInfo worldInfo{};
+		worldInfo.Dimensions = Elite::Vector2{ 300.f, 300.f };
+		const float halfWorldSize{ worldInfo.Dimensions.x / 2.f };
+		const float deltaTime{ 1.f / 60.f };
+
+		std::minstd_rand rng{ 1 };
+		std::uniform_real_distribution<float> position{ -halfWorldSize, halfWorldSize };
+		std::uniform_real_distribution<float> velocity{ -3.f, 3.f };
+		std::vector<EnemyInfo> enemies(nrEnemies);
+		for (EnemyInfo& enemy : enemies)
+		{
+			enemy.Location = Elite::Vector2{ position(rng), position(rng) };
+			enemy.LinearVelocity = Elite::Vector2{ velocity(rng), velocity(rng) };
+		}
+
+		ThreatMap threats{};
+		threats.Initialize(worldInfo);
+		ReferenceMap reference{ worldInfo };
+
+		RunResult result{};
+		//like the perception frame, only what's in view is splatted
+		std::vector<EnemyInfo> seenEnemies{};
+		seenEnemies.reserve(nrEnemies);
+		for (int tick{ 0 }; tick < nrTicks; ++tick)
+		{
+			//the agent walks a circle through the middle of the world and sees the enemies around it
+			const float angle{ tick * deltaTime * 0.1f };
+			const Elite::Vector2 agentPosition{ 60.f * cosf(angle), 60.f * sinf(angle) };
+
+			seenEnemies.clear();
+			for (const EnemyInfo& enemy : enemies)
+			{
+				if (Elite::DistanceSquared(enemy.Location, agentPosition) <= viewRange * viewRange)
+				{
+					seenEnemies.push_back(enemy);
+				}
+			}
+			result.NrSplats += seenEnemies.size();
+
+			const auto mapStart{ std::chrono::steady_clock::now() };
+			threats.Update(deltaTime);
+			for (const EnemyInfo& enemy : seenEnemies)
+			{
+				threats.Splat(enemy, deltaTime);
+			}
+			const auto tickTime{ std::chrono::steady_clock::now() - mapStart };
+			result.MapTime += tickTime;
+			result.SlowestTick = (std::max)(result.SlowestTick, tickTime);
+			result.NrDirtyTiles += threats.GetNrDirtyTiles();
+
+			const auto referenceStart{ std::chrono::steady_clock::now() };
+			reference.Update(deltaTime);
+			for (const EnemyInfo& enemy : seenEnemies)
+			{
+				reference.Splat(enemy, deltaTime);
+			}
+			result.ReferenceTime += std::chrono::steady_clock::now() - referenceStart;
+
+			if (tick % 60 == 0)
+			{
+				for (int sampleIdx{ 0 }; sampleIdx < 1000; ++sampleIdx)
+				{
+					const Elite::Vector2 samplePosition{ position(rng), position(rng) };
+					result.LargestError = (std::max)(result.LargestError, abs(threats.Sample(samplePosition) - reference.Sample(samplePosition)));
+				}
+			}
+			MoveEnemies(enemies, halfWorldSize, deltaTime);
+		}
+		return result;
+	}
+}
+
+//usage: gpp_threatmap_bench [--enemies N] [--ticks N] [--view RANGE] [--runs N]
+int main(int argc, char* argv[])
+{
+	size_t nrEnemies{ 256 };
+	int nrTicks{ 20000 };
+	float viewRange{ 20.f };
+	int nrRuns{ 5 };
+	for (int i{ 1 }; i + 1 < argc; i += 2)
+	{
+		const std::string arg{ argv[i] };
+		if (arg == "--enemies")
+			nrEnemies = static_cast<size_t>(atoi(argv[i + 1]));
+		else if (arg == "--ticks")
+			nrTicks = atoi(argv[i + 1]);
+		else if (arg == "--view")
+			viewRange = float(atof(argv[i + 1]));
+		else if (arg == "--runs")
+			nrRuns = (std::max)(atoi(argv[i + 1]), 1);
+		else
+		{
+			printf("Unknown argument '%s'\n", arg.c_str());
+			return 1;
+		}
+	}
+
+	//the budget of the whole map per tick, the plugin ticks it next to everything else
+	const double maxNsPerTick{ 1000.0 };
+	const float maxError{ 1e-4f };
+
+	//the sandbox shares its cpu, a run the scheduler cut into is slower, the median run is the typical one and the one compared against the budget
+	const auto toNanoseconds{ [](std::chrono::steady_clock::duration duration) { return std::chrono::duration<double, std::nano>(duration).count(); } };
+	std::vector<RunResult> results{};
+	float largestError{ 0.f };
+	std::chrono::steady_clock::duration slowestTick{};
+	printf("%-12s", "Run ns/tick");
+	for (int runIdx{ 0 }; runIdx < nrRuns; ++runIdx)
+	{
+		results.push_back(Run(nrEnemies, nrTicks, viewRange));
+		printf(" %8.0f", toNanoseconds(results.back().MapTime) / nrTicks);
+		largestError = (std::max)(largestError, results.back().LargestError);
+		slowestTick = (std::max)(slowestTick, results.back().SlowestTick);
+	}
+	printf("\n");
+	std::sort(results.begin(), results.end(), [](const RunResult& lhs, const RunResult& rhs) { return lhs.MapTime < rhs.MapTime; });
+	const RunResult& median{ results[results.size() / 2] };
+
+	const double nsPerTick{ toNanoseconds(median.MapTime) / nrTicks };
+	printf("Enemies: %zu, Ticks: %d, view range: %.0f, seen per tick: %.1f, dirty tiles per tick: %.1f\n",
+		nrEnemies, nrTicks, viewRange, double(median.NrSplats) / nrTicks, double(median.NrDirtyTiles) / nrTicks);
+	printf("%-12s %14s %14s %18s\n", "Path", "median ns/tick", "best ns/tick", "slowest tick ns");
+	printf("%-12s %14.0f %14.0f %18.0f\n", "DirtyTiles", nsPerTick, toNanoseconds(results.front().MapTime) / nrTicks, toNanoseconds(slowestTick));
+	printf("%-12s %14.0f %14.0f %18s\n", "EveryCell", toNanoseconds(median.ReferenceTime) / nrTicks, toNanoseconds(results.front().ReferenceTime) / nrTicks, "-");
+	printf("largest difference: %g\n", largestError);
+
+	const bool isMatching{ largestError <= maxError };
+	const bool isInBudget{ nsPerTick <= maxNsPerTick };
+	if (!isMatching)
+	{
+		printf("FAIL: the dirty tiles drift from updating every cell by more than %g\n", maxError);
+	}
+	if (!isInBudget)
+	{
+		printf("FAIL: the median run of the dirty tiles takes %.0f ns per tick, over the budget of %.0f ns\n", nsPerTick, maxNsPerTick);
+	}
+	if (isMatching && isInBudget)
+	{
+		printf("PASS: the dirty tiles match updating every cell, the median run within %.0f ns per tick\n", maxNsPerTick);
+	}
+	return isMatching && isInBudget ? 0 : 1;
+}
@@ -0,0 +1,190 @@
+#include "stdafx.h"
+#include "WorldMemory.h"
+#include "PerceptionFrame.h"
+#include <chrono>
+#include <unordered_map>
+
+//Fills a WorldMemory with many entities that get moved, forgotten and expire over a number of rounds
+//and checks every Find, QueryRadius and FindNearest against a brute force pass over a plain map of the same entities, exits with 1 on the first mismatch
+namespace
+{
+	struct ReferenceEntity
+	{
+		EntityInfo Info;
+		float LastSeenTime;
+	};
+
+	uint64_t GetKey(const EntityInfo& entityInfo)
+	{
+		return (uint64_t(entityInfo.Type) << 32) | uint32_t(entityInfo.EntityHash);
+	}
+
+	//same rule as WorldMemory::IsExpired
+	bool IsExpired(const WorldMemory& memory, const ReferenceEntity& entity)
+	{
+		return memory.GetTime() - entity.LastSeenTime > memory.GetLifetime(entity.Info.Type);
+	}
+}
+
+//usage: gpp_worldmemory_bench [--entities N] [--rounds N] [--queries N]
+int main(int argc, char* argv[])
+{
+	int nrEntities{ 50000 };
+	int nrRounds{ 10 };
+	int nrQueries{ 1000 };
+	for (int i{ 1 }; i + 1 < argc; i += 2)
+	{
+		const std::string arg{ argv[i] };
+		if (arg == "--entities")
+			nrEntities = atoi(argv[i + 1]);
+		else if (arg == "--rounds")
+			nrRounds = atoi(argv[i + 1]);
+		else if (arg == "--queries")
+			nrQueries = atoi(argv[i + 1]);
+		else
+		{
+			printf("Unknown argument '%s'\n", arg.c_str());
+			return 1;
+		}
+	}
+
+	const float halfWorldSize{ 500.f };
+	std::minstd_rand rng{ 1 };
+	std::uniform_real_distribution<float> position{ -halfWorldSize, halfWorldSize };
+	std::uniform_real_distribution<float> radius{ 0.f, 60.f };
+	std::uniform_real_distribution<float> chance{ 0.f, 1.f };
+	//the entities are spread over the rounds, a few hashes come up twice so those entities are seen again and move instead of being added
+	const int nrEntitiesPerRound{ nrEntities / nrRounds };
+	std::uniform_int_distribution<int> hash{ 0, nrEntities };
+	std::uniform_int_distribution<int> type{ 0, int(eEntityType::_LAST) };
+
+	WorldMemory memory{};
+	memory.Reserve(size_t(nrEntities));
+	std::unordered_map<uint64_t, ReferenceEntity> reference{};
+
+	//nothing is in view and the agent stands far outside the world, so Update only advances the clock and sweeps
+	const PerceptionFrame emptyFrame{};
+	AgentInfo agentInfo{};
+	agentInfo.Position = Elite::Vector2{ 1e6f, 1e6f };
+	agentInfo.FOV_Range = 1.f;
+	agentInfo.FOV_Angle = 1.f;
+
+	std::chrono::steady_clock::duration memoryTime{};
+	std::chrono::steady_clock::duration referenceTime{};
+	size_t nrFound{ 0 };
+	size_t nrChecked{ 0 };
+	std::vector<uint64_t> memoryKeys{};
+	std::vector<uint64_t> referenceKeys{};
+	for (int round{ 0 }; round < nrRounds; ++round)
+	{
+		for (int entityIdx{ 0 }; entityIdx < nrEntitiesPerRound; ++entityIdx)
+		{
+			EntityInfo entityInfo{};
+			entityInfo.Type = eEntityType(type(rng));
+			entityInfo.EntityHash = hash(rng);
+			entityInfo.Location = Elite::Vector2{ position(rng), position(rng) };
+			if (chance(rng) < 0.1f)
+			{
+				memory.Forget(entityInfo);
+				reference.erase(GetKey(entityInfo));
+				continue;
+			}
+			memory.Remember(entityInfo);
+			reference[GetKey(entityInfo)] = ReferenceEntity{ entityInfo, memory.GetTime() };
+		}
+
+		//a few seconds per round, so the enemies of earlier rounds expire
+		memory.Update(emptyFrame, agentInfo, 2.f);
+
+		for (int queryIdx{ 0 }; queryIdx < nrQueries; ++queryIdx)
+		{
+			const Elite::Vector2 center{ position(rng), position(rng) };
+			const float queryRadius{ radius(rng) };
+			const eEntityType queryType{ eEntityType(type(rng)) };
+
+			//every entity within the radius
+			const auto memoryStart{ std::chrono::steady_clock::now() };
+			memoryKeys.clear();
+			memory.QueryRadius(center, queryRadius, [&memoryKeys](const RememberedEntity& entity)
+			{
+				memoryKeys.push_back(GetKey(entity.Info));
+				return true;
+			});
+			const RememberedEntity* pNearest{ memory.FindNearest(center, queryRadius, [queryType](const RememberedEntity& entity) { return entity.Info.Type == queryType; }) };
+			memoryTime += std::chrono::steady_clock::now() - memoryStart;
+
+			const auto referenceStart{ std::chrono::steady_clock::now() };
+			referenceKeys.clear();
+			float nearestDistanceSq{ FLT_MAX };
+			for (const std::pair<const uint64_t, ReferenceEntity>& keyAndEntity : reference)
+			{
+				const ReferenceEntity& entity{ keyAndEntity.second };
+				const float distanceSq{ Elite::DistanceSquared(entity.Info.Location, center) };
+				if (IsExpired(memory, entity) || distanceSq > queryRadius * queryRadius)
+				{
+					continue;
+				}
+				referenceKeys.push_back(keyAndEntity.first);
+				if (entity.Info.Type == queryType)
+				{
+					nearestDistanceSq = (std::min)(nearestDistanceSq, distanceSq);
+				}
+			}
+			referenceTime += std::chrono::steady_clock::now() - referenceStart;
+
+			std::sort(memoryKeys.begin(), memoryKeys.end());
+			std::sort(referenceKeys.begin(), referenceKeys.end());
+			if (memoryKeys != referenceKeys)
+			{
+				printf("FAIL: round %d, QueryRadius at (%.2f, %.2f) radius %.2f found %zu entities instead of %zu\n",
+					round, center.x, center.y, queryRadius, memoryKeys.size(), referenceKeys.size());
+				return 1;
+			}
+			//two entities at the same distance can both be the nearest one, only the distance has to match
+			const bool isNearestMatching{ pNearest ? Elite::DistanceSquared(pNearest->Info.Location, center) == nearestDistanceSq : nearestDistanceSq == FLT_MAX };
+			if (!isNearestMatching)
+			{
+				printf("FAIL: round %d, FindNearest at (%.2f, %.2f) within %.2f doesn't find the nearest entity\n", round, center.x, center.y, queryRadius);
+				return 1;
+			}
+			nrFound += referenceKeys.size();
+		}
+
+		//every entity the reference still knows about, and the ones it forgot, by key
+		for (const std::pair<const uint64_t, ReferenceEntity>& keyAndEntity : reference)
+		{
+			const ReferenceEntity& entity{ keyAndEntity.second };
+			const RememberedEntity* pEntity{ memory.Find(entity.Info) };
+			//an expired entity is either not swept out yet or gone
+			const bool isMatching{ IsExpired(memory, entity) ? !pEntity || pEntity->Info.Location == entity.Info.Location
+				: pEntity && pEntity->Info.Location == entity.Info.Location && pEntity->LastSeenTime == entity.LastSeenTime };
+			if (!isMatching)
+			{
+				printf("FAIL: round %d, Find of entity %d of type %d doesn't match\n", round, entity.Info.EntityHash, int(entity.Info.Type));
+				return 1;
+			}
+			++nrChecked;
+		}
+		for (int missIdx{ 0 }; missIdx < nrQueries; ++missIdx)
+		{
+			EntityInfo entityInfo{};
+			entityInfo.Type = eEntityType(type(rng));
+			entityInfo.EntityHash = hash(rng);
+			if (reference.find(GetKey(entityInfo)) == reference.end() && memory.Find(entityInfo))
+			{
+				printf("FAIL: round %d, Find returns entity %d of type %d that was forgotten\n", round, entityInfo.EntityHash, int(entityInfo.Type));
+				return 1;
+			}
+		}
+	}
+
+	const auto toNanoseconds{ [](std::chrono::steady_clock::duration duration) { return std::chrono::duration<double, std::nano>(duration).count(); } };
+	const int nrQueriesRun{ nrRounds * nrQueries };
+	printf("Entities: %d, Rounds: %d, remembered at the end: %zu, Queries: %d, found per query: %.1f, Finds checked: %zu\n",
+		nrEntities, nrRounds, memory.Size(), nrQueriesRun, double(nrFound) / nrQueriesRun, nrChecked);
+	printf("%-12s %14s\n", "Path", "ns/query");
+	printf("%-12s %14.0f\n", "SpatialHash", toNanoseconds(memoryTime) / nrQueriesRun);
+	printf("%-12s %14.0f\n", "BruteForce", toNanoseconds(referenceTime) / nrQueriesRun);
+	printf("PASS: every query matches brute force\n");
+	return 0;
+}
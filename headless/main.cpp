@@ -0,0 +1,165 @@
+#include "stdafx.h"
+#include "HeadlessHost.h"
+#include "Tournament.h"
+#include "ReplayHost.h"
+#include "ReplayFile.h"
+#include "EProfiler.h"
+#include "ELogger.h"
+#include <chrono>
+
+namespace
+{
+	std::vector<std::string> SplitList(const std::string& list)
+	{
+		std::vector<std::string> items{};
+		std::stringstream stream{ list };
+		std::string item{};
+		while (std::getline(stream, item, ','))
+		{
+			if (!item.empty())
+				items.push_back(item);
+		}
+		return items;
+	}
+}
+
+//usage: gpp_headless [--seed N] [--frames N] [--dt SECONDS] [--level FILE] [--profile FILE.json] [--record FILE.gppr]
+//       gpp_headless --replay FILE.gppr [--profile FILE.json]
+//       gpp_headless --episodes N [--threads N] [--seed FIRST] [--levels A,B,...] [--frames N] [--dt SECONDS] [--csv FILE]
+int main(int argc, char* argv[])
+{
+	HeadlessRunSettings settings{};
+	TournamentSettings tournamentSettings{};
+	bool isTournament{ false };
+	std::string csvFile{};
+	std::string profileFile{};
+	std::string replayFile{};
+	for (int i{ 1 }; i + 1 < argc; i += 2)
+	{
+		const std::string arg{ argv[i] };
+		if (arg == "--seed")
+			settings.Seed = atoi(argv[i + 1]);
+		else if (arg == "--frames")
+			settings.MaxFrames = atoi(argv[i + 1]);
+		else if (arg == "--dt")
+			settings.DeltaTime = float(atof(argv[i + 1]));
+		else if (arg == "--level")
+			settings.LevelFile = argv[i + 1];
+		else if (arg == "--episodes")
+		{
+			tournamentSettings.NrEpisodes = atoi(argv[i + 1]);
+			isTournament = true;
+		}
+		else if (arg == "--threads")
+			tournamentSettings.NrThreads = unsigned(atoi(argv[i + 1]));
+		else if (arg == "--levels")
+			tournamentSettings.LevelFiles = SplitList(argv[i + 1]);
+		else if (arg == "--csv")
+			csvFile = argv[i + 1];
+		else if (arg == "--profile")
+			profileFile = argv[i + 1];
+		else if (arg == "--record")
+			settings.RecordFile = argv[i + 1];
+		else if (arg == "--replay")
+			replayFile = argv[i + 1];
+		else
+		{
+			printf("Unknown argument '%s'\n", arg.c_str());
+			return 1;
+		}
+	}
+
+	const auto start = std::chrono::steady_clock::now();
+	if (isTournament)
+	{
+		tournamentSettings.FirstSeed = std::max(settings.Seed, 0);
+		tournamentSettings.RunSettings = settings;
+		Tournament tournament{ tournamentSettings };
+		tournament.Run();
+		const auto end = std::chrono::steady_clock::now();
+		Elite::Logger::GetInstance().Flush();
+
+		if (!csvFile.empty())
+		{
+			FILE* pFile{ fopen(csvFile.c_str(), "w") };
+			if (pFile)
+			{
+				tournament.PrintResultsTable(pFile);
+				fclose(pFile);
+			}
+		}
+		tournament.PrintSummary(stdout);
+
+		long long totalFrames{ 0 };
+		for (const HeadlessRunResult& result : tournament.GetResults())
+		{
+			totalFrames += result.FramesSimulated;
+		}
+		const double elapsedMs{ std::chrono::duration<double, std::milli>(end - start).count() };
+		printf("Episodes: %d, Frames: %lld, Elapsed: %.2f ms, %.1f frames/ms\n", tournamentSettings.NrEpisodes, totalFrames, elapsedMs, totalFrames / std::max(elapsedMs, 0.001));
+		return 0;
+	}
+
+	int exitCode{ 0 };
+	if (!replayFile.empty())
+	{
+		ReplayHost host{ replayFile };
+		const ReplayRunResult result{ host.Run() };
+		const auto end = std::chrono::steady_clock::now();
+		Elite::Logger::GetInstance().Flush();
+		if (!host.IsOpen())
+		{
+			printf("Can't replay '%s'\n", replayFile.c_str());
+			return 1;
+		}
+
+		const double elapsedMs{ std::chrono::duration<double, std::milli>(end - start).count() };
+		printf("Frames: %d of %u replayed\n", result.FramesReplayed, result.NrFrames > 0 ? result.NrFrames - 1 : 0);
+		if (result.DivergedFrame >= 0)
+		{
+			printf("DIVERGED at frame %d: the plugin called %s where the replay has %s\n",
+				result.DivergedFrame, GetReplayCallName(result.DivergedCall), GetReplayCallName(result.RecordedCall));
+			exitCode = 1;
+		}
+		if (result.NrSteeringMismatches > 0)
+		{
+			printf("STEERING differs in %d frames, the first is frame %d\n", result.NrSteeringMismatches, result.FirstSteeringMismatch);
+			exitCode = 1;
+		}
+		if (exitCode == 0)
+		{
+			printf("Every call and steering output matches the replay\n");
+		}
+		printf("Elapsed: %.2f ms, %.1f frames/ms\n", elapsedMs, result.FramesReplayed / std::max(elapsedMs, 0.001));
+	}
+	else
+	{
+		HeadlessHost host{ settings };
+		const HeadlessRunResult result{ host.Run() };
+		const auto end = std::chrono::steady_clock::now();
+		//the plugin's log is written in the background, get it out before the results
+		Elite::Logger::GetInstance().Flush();
+
+		const double elapsedMs{ std::chrono::duration<double, std::milli>(end - start).count() };
+		printf("Frames: %d (%s)\n", result.FramesSimulated, result.AgentDied ? "agent died" : "frame limit");
+		printf("Score: %d, TimeSurvived: %.1f, Kills: %d, MissedShots: %d, ItemsPickedUp: %d\n",
+			result.Stats.Score, result.Stats.TimeSurvived, result.Stats.NumEnemiesKilled, result.Stats.NumMissedShots, result.Stats.NumItemsPickUp);
+		printf("Elapsed: %.2f ms, %.1f frames/ms\n", elapsedMs, result.FramesSimulated / std::max(elapsedMs, 0.001));
+		if (const ReplayWriter* pWriter{ host.GetReplayWriter() })
+		{
+			printf("Recorded %u frames to %s, %zu of %zu bytes of calls written\n",
+				pWriter->GetNrFrames(), settings.RecordFile.c_str(), pWriter->GetNrWrittenBytes(), pWriter->GetNrRawBytes());
+		}
+	}
+
+	if (!profileFile.empty())
+	{
+#ifdef ELITE_PROFILING
+		if (Elite::Profiler::GetInstance().ExportChromeTrace(profileFile))
+			printf("Profile written to %s\n", profileFile.c_str());
+#else
+		printf("WARNING: --profile needs a build with ELITE_PROFILING defined \n");
+#endif
+	}
+	return exitCode;
+}
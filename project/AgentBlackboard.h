@@ -0,0 +1,96 @@
+#pragma once
+#include "EBlackboard.h"
+#include "Exam_HelperStructs.h"
+#include "SteeringHelpers.h"
+#include "PerceptionFrame.h"
+#include "WorldMemory.h"
+#include "HouseRegistry.h"
+#include "ThreatMap.h"
+#include "ContextSteering.h"
+#include "EnemyFrame.h"
+#include "InventoryMirror.h"
+
+class IExamInterface;
+class SteeringController;
+class FlowField;
+
+//Everything the states and transitions share, stored contiguously in the blackboard
+struct AgentBlackboardSlots
+{
+	IExamInterface* pInterface = nullptr;
+	SteeringController* pSteeringController = nullptr;
+	const FlowField* pFlowField = nullptr; //nullptr if the level couldn't be loaded
+
+	AgentInfo Agent{}; //Agent_GetInfo() cached once per tick at the top of UpdateSteering
+	PerceptionFrame Perception;
+	WorldMemory Memory; //everything seen in earlier frames, updated right after the perception
+	HouseRegistry VisitedHouses; //timed by Memory.GetTime()
+	ThreatMap Threats; //every enemy seen, fading out, updated right after the memory
+	SteeringContext Context; //danger of every direction around the agent this tick, filled in with the threats
+	EnemyFrame Enemies; //every enemy in view with its info, filled in with the threats, ask this instead of Enemy_GetInfo
+	InventoryMirror Inventory; //ask this instead of Inventory_GetItem and add, use and remove items through it
+
+	TargetData Target;
+	HouseInfo TargetHouse;
+	EntityInfo TargetItem;
+	EnemyInfo TargetEnemy;
+	PurgeZoneInfo TargetPurgeZone;
+
+	Elite::Vector2 HouseEntryPoint;
+	bool AutoOrient = true;
+	int NrTimesToShoot = 0;
+};
+
+//Typed blackboard keys, use as pBlackboard->Get<BB::Target>()
+namespace BB
+{
+	template<typename T, T AgentBlackboardSlots::*TMember>
+	using AgentKey = Elite::BlackboardKey<AgentBlackboardSlots, T, TMember>;
+
+	using Interface = AgentKey<IExamInterface*, &AgentBlackboardSlots::pInterface>;
+	using SteeringController = AgentKey<::SteeringController*, &AgentBlackboardSlots::pSteeringController>;
+	using FlowField = AgentKey<const ::FlowField*, &AgentBlackboardSlots::pFlowField>;
+
+	using Agent = AgentKey<AgentInfo, &AgentBlackboardSlots::Agent>;
+	using Perception = AgentKey<PerceptionFrame, &AgentBlackboardSlots::Perception>;
+	using Memory = AgentKey<WorldMemory, &AgentBlackboardSlots::Memory>;
+	using VisitedHouses = AgentKey<HouseRegistry, &AgentBlackboardSlots::VisitedHouses>;
+	using Threats = AgentKey<ThreatMap, &AgentBlackboardSlots::Threats>;
+	using Context = AgentKey<SteeringContext, &AgentBlackboardSlots::Context>;
+	using Enemies = AgentKey<EnemyFrame, &AgentBlackboardSlots::Enemies>;
+	using Inventory = AgentKey<InventoryMirror, &AgentBlackboardSlots::Inventory>;
+
+	using Target = AgentKey<TargetData, &AgentBlackboardSlots::Target>;
+	using TargetHouse = AgentKey<HouseInfo, &AgentBlackboardSlots::TargetHouse>;
+	using TargetItem = AgentKey<EntityInfo, &AgentBlackboardSlots::TargetItem>;
+	using TargetEnemy = AgentKey<EnemyInfo, &AgentBlackboardSlots::TargetEnemy>;
+	using TargetPurgeZone = AgentKey<PurgeZoneInfo, &AgentBlackboardSlots::TargetPurgeZone>;
+
+	using HouseEntryPoint = AgentKey<Elite::Vector2, &AgentBlackboardSlots::HouseEntryPoint>;
+	using AutoOrient = AgentKey<bool, &AgentBlackboardSlots::AutoOrient>;
+	using NrTimesToShoot = AgentKey<int, &AgentBlackboardSlots::NrTimesToShoot>;
+
+	//register the string names of all slots, only needed for tooling that still uses the string API
+	inline void AddSlotAliases(Elite::Blackboard* pBlackboard)
+	{
+		pBlackboard->AddSlotAlias<Interface>("Interface");
+		pBlackboard->AddSlotAlias<SteeringController>("SteeringController");
+		pBlackboard->AddSlotAlias<FlowField>("FlowField");
+		pBlackboard->AddSlotAlias<Agent>("Agent");
+		pBlackboard->AddSlotAlias<Perception>("Perception");
+		pBlackboard->AddSlotAlias<Memory>("Memory");
+		pBlackboard->AddSlotAlias<VisitedHouses>("VisitedHouses");
+		pBlackboard->AddSlotAlias<Threats>("Threats");
+		pBlackboard->AddSlotAlias<Context>("Context");
+		pBlackboard->AddSlotAlias<Enemies>("Enemies");
+		pBlackboard->AddSlotAlias<Inventory>("Inventory");
+		pBlackboard->AddSlotAlias<Target>("Target");
+		pBlackboard->AddSlotAlias<TargetHouse>("TargetHouse");
+		pBlackboard->AddSlotAlias<TargetItem>("TargetItem");
+		pBlackboard->AddSlotAlias<TargetEnemy>("TargetEnemy");
+		pBlackboard->AddSlotAlias<TargetPurgeZone>("TargetPurgeZone");
+		pBlackboard->AddSlotAlias<HouseEntryPoint>("HouseEntryPoint");
+		pBlackboard->AddSlotAlias<AutoOrient>("AutoOrient");
+		pBlackboard->AddSlotAlias<NrTimesToShoot>("NrTimesToShoot");
+	}
+}
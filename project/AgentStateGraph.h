@@ -0,0 +1,106 @@
+#pragma once
+#include "EFiniteStateMachine.h"
+
+//The agent's state machine as data, the indices of the states and transitions the plugin hands to the FSM
+enum class eAgentState
+{
+	WANDER,
+	FLEE,
+	ENTER_HOUSE,
+	SEARCH_CURRENT_HOUSE,
+	EXIT_CURRENT_HOUSE,
+	GRAB_ITEM,
+	KILL_ZOMBIE,
+	GO_TO_WORLD_CENTER,
+	FLEE_PURGE_ZONE,
+
+	//@END
+	_COUNT
+};
+
+enum class eAgentTransition
+{
+	SEES_ZOMBIE,
+	SEES_HOUSE,
+	SEES_ITEM,
+	FINISHED_FLEEING,
+	IS_INSIDE_HOUSE,
+	IS_NOT_INSIDE_HOUSE,
+	FINISHED_SEARCHING_HOUSE,
+	HAS_GRABBED_ITEM,
+	CAN_KILL_ZOMBIE,
+	HAS_KILLED_ZOMBIE,
+	HAS_LEFT_WORLD,
+	IS_AT_WORLD_CENTER,
+	SEES_PURGE_ZONE,
+	HAS_LEFT_PURGE_ZONE,
+
+	//@END
+	_COUNT
+};
+
+namespace AgentStateGraph
+{
+	constexpr size_t NrStates{ size_t(eAgentState::_COUNT) };
+	constexpr size_t NrTransitions{ size_t(eAgentTransition::_COUNT) };
+
+	constexpr Elite::FSMEdge Edge(eAgentState from, eAgentTransition transition, eAgentState to)
+	{
+		Elite::FSMEdge edge{};
+		edge.FromState = int(from);
+		edge.Transition = int(transition);
+		edge.ToState = int(to);
+		return edge;
+	}
+
+	//per start state, the first transition that fires wins
+	constexpr std::array Edges
+	{
+		//from wander
+		Edge(eAgentState::WANDER, eAgentTransition::SEES_PURGE_ZONE, eAgentState::FLEE_PURGE_ZONE),
+		Edge(eAgentState::WANDER, eAgentTransition::IS_INSIDE_HOUSE, eAgentState::EXIT_CURRENT_HOUSE), //safety measure in case agent ends up wandering inside a house
+		Edge(eAgentState::WANDER, eAgentTransition::CAN_KILL_ZOMBIE, eAgentState::KILL_ZOMBIE),
+		Edge(eAgentState::WANDER, eAgentTransition::SEES_ZOMBIE, eAgentState::FLEE),
+		Edge(eAgentState::WANDER, eAgentTransition::SEES_HOUSE, eAgentState::ENTER_HOUSE),
+		Edge(eAgentState::WANDER, eAgentTransition::HAS_LEFT_WORLD, eAgentState::GO_TO_WORLD_CENTER),
+
+		//from flee
+		Edge(eAgentState::FLEE, eAgentTransition::SEES_PURGE_ZONE, eAgentState::FLEE_PURGE_ZONE),
+		Edge(eAgentState::FLEE, eAgentTransition::SEES_HOUSE, eAgentState::ENTER_HOUSE),
+		Edge(eAgentState::FLEE, eAgentTransition::CAN_KILL_ZOMBIE, eAgentState::KILL_ZOMBIE),
+		Edge(eAgentState::FLEE, eAgentTransition::FINISHED_FLEEING, eAgentState::WANDER),
+
+		//from exiting a house
+		Edge(eAgentState::EXIT_CURRENT_HOUSE, eAgentTransition::CAN_KILL_ZOMBIE, eAgentState::KILL_ZOMBIE),
+		Edge(eAgentState::EXIT_CURRENT_HOUSE, eAgentTransition::SEES_ITEM, eAgentState::GRAB_ITEM),
+		Edge(eAgentState::EXIT_CURRENT_HOUSE, eAgentTransition::IS_NOT_INSIDE_HOUSE, eAgentState::FLEE),
+
+		//from searching a house
+		Edge(eAgentState::SEARCH_CURRENT_HOUSE, eAgentTransition::SEES_PURGE_ZONE, eAgentState::EXIT_CURRENT_HOUSE),
+		Edge(eAgentState::SEARCH_CURRENT_HOUSE, eAgentTransition::CAN_KILL_ZOMBIE, eAgentState::KILL_ZOMBIE),
+		Edge(eAgentState::SEARCH_CURRENT_HOUSE, eAgentTransition::SEES_ITEM, eAgentState::GRAB_ITEM),
+		Edge(eAgentState::SEARCH_CURRENT_HOUSE, eAgentTransition::FINISHED_SEARCHING_HOUSE, eAgentState::EXIT_CURRENT_HOUSE),
+
+		//from entering a house
+		Edge(eAgentState::ENTER_HOUSE, eAgentTransition::SEES_PURGE_ZONE, eAgentState::FLEE_PURGE_ZONE),
+		Edge(eAgentState::ENTER_HOUSE, eAgentTransition::IS_INSIDE_HOUSE, eAgentState::SEARCH_CURRENT_HOUSE),
+		Edge(eAgentState::ENTER_HOUSE, eAgentTransition::CAN_KILL_ZOMBIE, eAgentState::KILL_ZOMBIE),
+
+		//from killing a zombie
+		Edge(eAgentState::KILL_ZOMBIE, eAgentTransition::HAS_KILLED_ZOMBIE, eAgentState::WANDER),
+
+		//from grabbing an item
+		Edge(eAgentState::GRAB_ITEM, eAgentTransition::HAS_GRABBED_ITEM, eAgentState::SEARCH_CURRENT_HOUSE),
+
+		//from traveling to the world center
+		Edge(eAgentState::GO_TO_WORLD_CENTER, eAgentTransition::SEES_HOUSE, eAgentState::ENTER_HOUSE),
+		Edge(eAgentState::GO_TO_WORLD_CENTER, eAgentTransition::CAN_KILL_ZOMBIE, eAgentState::KILL_ZOMBIE),
+		Edge(eAgentState::GO_TO_WORLD_CENTER, eAgentTransition::IS_AT_WORLD_CENTER, eAgentState::WANDER),
+
+		//from fleeing a purge zone
+		Edge(eAgentState::FLEE_PURGE_ZONE, eAgentTransition::HAS_LEFT_PURGE_ZONE, eAgentState::WANDER),
+	};
+
+	//compiled once by the compiler, the FSM reads it in place
+	constexpr Elite::FSMTable<NrStates, Edges.size()> Table{ Elite::CompileFSMTable<NrStates>(Edges) };
+}
@@ -14,7 +14,7 @@ SteeringPlugin_Output BlendedSteering::CalculateSteering(float deltaT, const Age
 	SteeringPlugin_Output blendedSteering = {};
 	auto totalWeight = 0.f;
 
-	for (auto weightedBehavior : m_WeightedBehaviors)
+	for (const WeightedBehavior& weightedBehavior : m_WeightedBehaviors)
 	{
 		auto steering = weightedBehavior.pBehavior->CalculateSteering(deltaT, agentInfo);
 		blendedSteering.LinearVelocity += weightedBehavior.weight * steering.LinearVelocity;
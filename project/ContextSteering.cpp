@@ -0,0 +1,5 @@
+#include "stdafx.h"
+#include "ContextSteering.h"
+#include "ContextSteering.inl"
+
+template class ContextMap<16>;
@@ -0,0 +1,42 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+
+//Context steering: how interesting and how dangerous each of TNrSlots directions around the agent is, evenly spread counter clockwise from +x
+//every source writes into a slot with max, so two sources never cancel each other out like blended velocities do
+//the direction chosen is the most interesting one among the least dangerous slots
+//the slots are processed 4 at a time, ContextSteering.cpp compiles in 16 slots, other counts include ContextSteering.inl
+template<int TNrSlots>
+class ContextMap final
+{
+	static_assert(TNrSlots % 4 == 0, "the slots are processed 4 at a time");
+public:
+	static const int NrSlots{ TNrSlots };
+	//a slot counts as safe as the safest one if its danger is within this of it
+	static constexpr float DangerTolerance{ 0.05f };
+
+	void Clear();
+	void ClearInterest();
+
+	//slots within 90 degrees of direction get weight times the cosine of the angle to it, direction has to be normalized
+	void AddInterest(const Elite::Vector2& direction, float weight);
+	//slots within the cone around direction get weight, direction has to be normalized
+	void AddDanger(const Elite::Vector2& direction, float weight, float cosHalfAngle);
+	//a round obstacle: danger towards it, rising from 0 at range from its edge to 1 at its edge
+	//the cone covers the obstacle plus clearance around it, and at least one slot
+	void AddObstacle(const Elite::Vector2& agentPosition, const Elite::Vector2& center, float radius, float clearance, float range);
+	void AddSlotDanger(int slotIdx, float weight);
+
+	//false if none of the least dangerous slots is interesting
+	bool ChooseDirection(Elite::Vector2& direction) const;
+
+	static Elite::Vector2 GetSlotDirection(int slotIdx);
+	float GetInterest(int slotIdx) const { return m_Interest[slotIdx]; }
+	float GetDanger(int slotIdx) const { return m_Danger[slotIdx]; }
+
+private:
+	alignas(16) float m_Interest[TNrSlots]{};
+	alignas(16) float m_Danger[TNrSlots]{};
+};
+
+//what the plugin steers with
+using SteeringContext = ContextMap<16>;
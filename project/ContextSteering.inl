@@ -0,0 +1,170 @@
+//Internal to ContextMap: the definitions of its members for any number of slots
+//ContextSteering.cpp compiles in the 16 slots the plugin steers with, a TU that wants another count includes this after ContextSteering.h and instantiates it itself
+
+//SSE2 is part of every x64 cpu, same as in the threat map
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define CONTEXT_STEERING_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	template<int TNrSlots>
+	struct SlotDirections
+	{
+		alignas(16) float X[TNrSlots];
+		alignas(16) float Y[TNrSlots];
+		float CosHalfSpacing; //cosine of half the angle between two slots
+
+		SlotDirections()
+			: CosHalfSpacing{ cosf(float(E_PI) / TNrSlots) }
+		{
+			for (int slotIdx{ 0 }; slotIdx < TNrSlots; ++slotIdx)
+			{
+				const float angle{ 2.f * float(E_PI) * slotIdx / TNrSlots };
+				X[slotIdx] = cosf(angle);
+				Y[slotIdx] = sinf(angle);
+			}
+		}
+	};
+
+	template<int TNrSlots>
+	const SlotDirections<TNrSlots> g_Slots{};
+}
+
+template<int TNrSlots>
+void ContextMap<TNrSlots>::Clear()
+{
+	std::fill(m_Interest, m_Interest + TNrSlots, 0.f);
+	std::fill(m_Danger, m_Danger + TNrSlots, 0.f);
+}
+
+template<int TNrSlots>
+void ContextMap<TNrSlots>::ClearInterest()
+{
+	std::fill(m_Interest, m_Interest + TNrSlots, 0.f);
+}
+
+template<int TNrSlots>
+void ContextMap<TNrSlots>::AddInterest(const Elite::Vector2& direction, float weight)
+{
+	const SlotDirections<TNrSlots>& slots{ g_Slots<TNrSlots> };
+#ifdef CONTEXT_STEERING_SSE2
+	const __m128 directionX{ _mm_set1_ps(direction.x) };
+	const __m128 directionY{ _mm_set1_ps(direction.y) };
+	const __m128 weight4{ _mm_set1_ps(weight) };
+	for (int slotIdx{ 0 }; slotIdx < TNrSlots; slotIdx += 4)
+	{
+		const __m128 cosine{ _mm_add_ps(_mm_mul_ps(directionX, _mm_load_ps(slots.X + slotIdx)), _mm_mul_ps(directionY, _mm_load_ps(slots.Y + slotIdx))) };
+		const __m128 interest{ _mm_mul_ps(weight4, _mm_max_ps(cosine, _mm_setzero_ps())) };
+		_mm_store_ps(m_Interest + slotIdx, _mm_max_ps(_mm_load_ps(m_Interest + slotIdx), interest));
+	}
+#else
+	for (int slotIdx{ 0 }; slotIdx < TNrSlots; ++slotIdx)
+	{
+		const float cosine{ direction.x * slots.X[slotIdx] + direction.y * slots.Y[slotIdx] };
+		m_Interest[slotIdx] = (std::max)(m_Interest[slotIdx], weight * (std::max)(cosine, 0.f));
+	}
+#endif
+}
+
+template<int TNrSlots>
+void ContextMap<TNrSlots>::AddDanger(const Elite::Vector2& direction, float weight, float cosHalfAngle)
+{
+	const SlotDirections<TNrSlots>& slots{ g_Slots<TNrSlots> };
+#ifdef CONTEXT_STEERING_SSE2
+	const __m128 directionX{ _mm_set1_ps(direction.x) };
+	const __m128 directionY{ _mm_set1_ps(direction.y) };
+	const __m128 weight4{ _mm_set1_ps(weight) };
+	const __m128 cosHalfAngle4{ _mm_set1_ps(cosHalfAngle) };
+	for (int slotIdx{ 0 }; slotIdx < TNrSlots; slotIdx += 4)
+	{
+		const __m128 cosine{ _mm_add_ps(_mm_mul_ps(directionX, _mm_load_ps(slots.X + slotIdx)), _mm_mul_ps(directionY, _mm_load_ps(slots.Y + slotIdx))) };
+		const __m128 danger{ _mm_and_ps(weight4, _mm_cmpge_ps(cosine, cosHalfAngle4)) };
+		_mm_store_ps(m_Danger + slotIdx, _mm_max_ps(_mm_load_ps(m_Danger + slotIdx), danger));
+	}
+#else
+	for (int slotIdx{ 0 }; slotIdx < TNrSlots; ++slotIdx)
+	{
+		const float cosine{ direction.x * slots.X[slotIdx] + direction.y * slots.Y[slotIdx] };
+		if (cosine >= cosHalfAngle)
+		{
+			m_Danger[slotIdx] = (std::max)(m_Danger[slotIdx], weight);
+		}
+	}
+#endif
+}
+
+template<int TNrSlots>
+void ContextMap<TNrSlots>::AddObstacle(const Elite::Vector2& agentPosition, const Elite::Vector2& center, float radius, float clearance, float range)
+{
+	const Elite::Vector2 toCenter{ center - agentPosition };
+	const float distance{ toCenter.Magnitude() };
+	const float distanceToEdge{ distance - radius };
+	if (distanceToEdge >= range || distance <= FLT_EPSILON)
+	{
+		return;
+	}
+
+	//the half angle the obstacle plus clearance takes up as seen from the agent, a right angle once the agent is that close
+	const float sinHalfAngle{ (std::min)((radius + clearance) / distance, 1.f) };
+	const float cosHalfAngle{ sqrtf(1.f - sinHalfAngle * sinHalfAngle) };
+	const float weight{ (std::min)(1.f - distanceToEdge / range, 1.f) };
+	//never narrower than the slots, or it could slip between two of them
+	AddDanger(toCenter / distance, weight, (std::min)(cosHalfAngle, g_Slots<TNrSlots>.CosHalfSpacing));
+}
+
+template<int TNrSlots>
+void ContextMap<TNrSlots>::AddSlotDanger(int slotIdx, float weight)
+{
+	m_Danger[slotIdx] = (std::max)(m_Danger[slotIdx], weight);
+}
+
+template<int TNrSlots>
+bool ContextMap<TNrSlots>::ChooseDirection(Elite::Vector2& direction) const
+{
+	//the interest of every slot that isn't more dangerous than the safest one, 0 for the others
+	alignas(16) float safeInterest[TNrSlots];
+#ifdef CONTEXT_STEERING_SSE2
+	__m128 minDanger4{ _mm_load_ps(m_Danger) };
+	for (int slotIdx{ 4 }; slotIdx < TNrSlots; slotIdx += 4)
+	{
+		minDanger4 = _mm_min_ps(minDanger4, _mm_load_ps(m_Danger + slotIdx));
+	}
+	minDanger4 = _mm_min_ps(minDanger4, _mm_shuffle_ps(minDanger4, minDanger4, _MM_SHUFFLE(1, 0, 3, 2)));
+	minDanger4 = _mm_min_ps(minDanger4, _mm_shuffle_ps(minDanger4, minDanger4, _MM_SHUFFLE(2, 3, 0, 1)));
+	const __m128 maxDanger4{ _mm_add_ps(minDanger4, _mm_set1_ps(DangerTolerance)) };
+	for (int slotIdx{ 0 }; slotIdx < TNrSlots; slotIdx += 4)
+	{
+		const __m128 isSafe{ _mm_cmple_ps(_mm_load_ps(m_Danger + slotIdx), maxDanger4) };
+		_mm_store_ps(safeInterest + slotIdx, _mm_and_ps(_mm_load_ps(m_Interest + slotIdx), isSafe));
+	}
+#else
+	const float maxDanger{ *std::min_element(m_Danger, m_Danger + TNrSlots) + DangerTolerance };
+	for (int slotIdx{ 0 }; slotIdx < TNrSlots; ++slotIdx)
+	{
+		safeInterest[slotIdx] = m_Danger[slotIdx] <= maxDanger ? m_Interest[slotIdx] : 0.f;
+	}
+#endif
+
+	const int bestIdx{ int(std::max_element(safeInterest, safeInterest + TNrSlots) - safeInterest) };
+	if (safeInterest[bestIdx] <= 0.f)
+	{
+		return false;
+	}
+
+	//leans towards the safe neighbours by how interesting they are, so the direction isn't stuck to the slots
+	const int previousIdx{ (bestIdx + TNrSlots - 1) % TNrSlots };
+	const int nextIdx{ (bestIdx + 1) % TNrSlots };
+	direction = GetSlotDirection(bestIdx) * safeInterest[bestIdx]
+		+ GetSlotDirection(previousIdx) * safeInterest[previousIdx]
+		+ GetSlotDirection(nextIdx) * safeInterest[nextIdx];
+	direction.Normalize();
+	return true;
+}
+
+template<int TNrSlots>
+Elite::Vector2 ContextMap<TNrSlots>::GetSlotDirection(int slotIdx)
+{
+	return Elite::Vector2{ g_Slots<TNrSlots>.X[slotIdx], g_Slots<TNrSlots>.Y[slotIdx] };
+}
@@ -9,6 +9,7 @@
 
 //Includes
 #include <unordered_map>
+#include "ELogger.h"
 
 namespace Elite
 {
@@ -27,13 +28,35 @@ namespace Elite
 	class BlackboardField : public IBlackBoardField
 	{
 	public:
-		explicit BlackboardField(T data) : m_Data(data)
+		explicit BlackboardField(T data) : m_Data(data), m_pData(&m_Data)
 		{}
-		T GetData() { return m_Data; };
-		void SetData(T data) { m_Data = data; }
+		//aliases a typed slot instead of holding its own copy, both APIs then see the same value
+		explicit BlackboardField(T* pSlot) : m_Data(), m_pData(pSlot)
+		{}
+		T GetData() { return *m_pData; };
+		T& GetDataRef() { return *m_pData; }
+		void SetData(T data) { *m_pData = data; }
 
+		BlackboardField(const BlackboardField& other) = delete;
+		BlackboardField& operator=(const BlackboardField& rhs) = delete;
 	private:
 		T m_Data;
+		T* m_pData;
+	};
+
+	//-----------------------------------------------------------------
+	// BLACKBOARD KEYS (TYPED)
+	//-----------------------------------------------------------------
+	//Compile time key for a slot of a plain TSlots struct, e.g.
+	//	using TargetKey = BlackboardKey<AgentSlots, TargetData, &AgentSlots::Target>;
+	//	pBlackboard->Get<TargetKey>().Position = ...;
+	//the lookup is resolved to a fixed member offset, no hashing, no RTTI and no heap node per entry
+	template<typename TSlots, typename T, T TSlots::*TMember>
+	struct BlackboardKey
+	{
+		using SlotsType = TSlots;
+		using ValueType = T;
+		static constexpr T TSlots::*Member = TMember;
 	};
 
 	//-----------------------------------------------------------------
@@ -42,11 +65,54 @@ namespace Elite
 	class Blackboard final
 	{
 	public:
+		Blackboard() = default;
 		~Blackboard()
 		{
 			for (auto el : m_BlackboardData)
 				delete(el.second);
 			m_BlackboardData.clear();
+
+			if (m_pSlots)
+				m_pDeleteSlots(m_pSlots);
+		}
+
+		Blackboard(const Blackboard& other) = delete;
+		Blackboard& operator=(const Blackboard& rhs) = delete;
+
+		//Create the typed slots, the blackboard owns them
+		template<typename TSlots> TSlots& CreateSlots()
+		{
+			assert(m_pSlots == nullptr && "Blackboard already has typed slots");
+			m_pSlots = new TSlots();
+			m_pSlotsType = &SlotsTypeId<TSlots>::Id;
+			m_pDeleteSlots = [](void* pSlots) { delete static_cast<TSlots*>(pSlots); };
+			return *static_cast<TSlots*>(m_pSlots);
+		}
+
+		//Get a typed slot, a single load from the slots struct
+		//returns a reference, large values (vectors) are read and filled in place instead of copied
+		template<typename TKey> typename TKey::ValueType& Get()
+		{
+			assert(m_pSlotsType == &SlotsTypeId<typename TKey::SlotsType>::Id && "Key doesn't belong to this blackboard's slots");
+			return static_cast<typename TKey::SlotsType*>(m_pSlots)->*TKey::Member;
+		}
+		template<typename TKey> const typename TKey::ValueType& Get() const
+		{
+			assert(m_pSlotsType == &SlotsTypeId<typename TKey::SlotsType>::Id && "Key doesn't belong to this blackboard's slots");
+			return static_cast<const typename TKey::SlotsType*>(m_pSlots)->*TKey::Member;
+		}
+
+		//Expose a typed slot under a name, so the string API (debug tooling) reads and writes the same value
+		template<typename TKey> bool AddSlotAlias(const std::string& name)
+		{
+			auto it = m_BlackboardData.find(name);
+			if (it == m_BlackboardData.end())
+			{
+				m_BlackboardData[name] = new BlackboardField<typename TKey::ValueType>(&Get<TKey>());
+				return true;
+			}
+			ELITE_LOG_WARNING("Data '%s' of type '%s' already in Blackboard", name.c_str(), typeid(typename TKey::ValueType).name());
+			return false;
 		}
 
 		//Add data to the blackboard
@@ -58,7 +124,7 @@ namespace Elite
 				m_BlackboardData[name] = new BlackboardField<T>(data);
 				return true;
 			}
-			printf("WARNING: Data '%s' of type '%s' already in Blackboard \n", name.c_str(), typeid(T).name());
+			ELITE_LOG_WARNING("Data '%s' of type '%s' already in Blackboard", name.c_str(), typeid(T).name());
 			return false;
 		}
 
@@ -75,25 +141,50 @@ namespace Elite
 					return true;
 				}
 			}
-			printf("WARNING: Data '%s' of type '%s' not found in Blackboard \n", name.c_str(), typeid(T).name());
+			ELITE_LOG_WARNING("Data '%s' of type '%s' not found in Blackboard", name.c_str(), typeid(T).name());
 			return false;
 		}
 
 		//Get the data from the blackboard
 		template<typename T> bool GetData(const std::string& name, T& data)
 		{
-			BlackboardField<T>* p = dynamic_cast<BlackboardField<T>*>(m_BlackboardData[name]);
-			if (p != nullptr)
+			T* pData = GetDataPtr<T>(name);
+			if (pData != nullptr)
 			{
-				data = p->GetData();
+				data = *pData;
 				return true;
 			}
-			printf("WARNING: Data '%s' of type '%s' not found in Blackboard \n", name.c_str(), typeid(T).name());
 			return false;
 		}
 
+		//Get the data in place, without copying it out, so it can be read or changed through the pointer
+		template<typename T> T* GetDataPtr(const std::string& name)
+		{
+			auto it = m_BlackboardData.find(name);
+			if (it != m_BlackboardData.end())
+			{
+				BlackboardField<T>* p = dynamic_cast<BlackboardField<T>*>(it->second);
+				if (p != nullptr)
+					return &p->GetDataRef();
+			}
+			ELITE_LOG_WARNING("Data '%s' of type '%s' not found in Blackboard", name.c_str(), typeid(T).name());
+			return nullptr;
+		}
+
 	private:
+		//one address per slots type, stands in for RTTI when checking keys in debug builds
+		template<typename TSlots> struct SlotsTypeId
+		{
+			static const char Id;
+		};
+
 		std::unordered_map<std::string, IBlackBoardField*> m_BlackboardData;
+
+		void* m_pSlots = nullptr;
+		const char* m_pSlotsType = nullptr;
+		void(*m_pDeleteSlots)(void*) = nullptr;
 	};
+
+	template<typename TSlots> const char Blackboard::SlotsTypeId<TSlots>::Id = 0;
 }
 #endif
\ No newline at end of file
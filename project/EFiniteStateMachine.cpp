@@ -2,6 +2,8 @@
 #include "stdafx.h"
 #include "EFiniteStateMachine.h"
 #include "EBlackboard.h"
+#include "EProfiler.h"
+#include "ELogger.h"
 using namespace Elite;
 
 
@@ -9,7 +11,7 @@ Elite::FiniteStateMachine::FiniteStateMachine(FSMState* startState, Blackboard*
     : m_pCurrentState(nullptr),
     m_pBlackboard(pBlackboard)
 {
-    SetState(startState);
+    SetState(startState, -1);
 }
 
 Elite::FiniteStateMachine::~FiniteStateMachine()
@@ -17,36 +19,64 @@ Elite::FiniteStateMachine::~FiniteStateMachine()
     SAFE_DELETE(m_pBlackboard);
 }
 
-void Elite::FiniteStateMachine::AddTransition(FSMState* startState, FSMState* toState, FSMTransition* transition)
+void Elite::FiniteStateMachine::SetTransitionTable(const std::vector<FSMState*>& states, const std::vector<FSMTransition*>& transitions, const std::vector<FSMEdge>& edges)
 {
-    auto it = m_Transitions.find(startState);
-    if (it == m_Transitions.end())
+    for (const FSMEdge& edge : edges)
     {
-        m_Transitions[startState] = Transitions();
+        const bool isValid{ edge.FromState >= 0 && edge.FromState < int(states.size()) && edge.ToState >= 0 && edge.ToState < int(states.size())
+            && edge.Transition >= 0 && edge.Transition < int(transitions.size()) };
+        if (!isValid)
+        {
+            ELITE_LOG_WARNING("FSM edge %d -(%d)-> %d refers to a state or transition that wasn't given", edge.FromState, edge.Transition, edge.ToState);
+            return;
+        }
     }
-   
-    m_Transitions[startState].push_back(std::make_pair(transition, toState));
+
+    m_Edges = edges;
+    m_States = states;
+    m_Transitions = transitions;
+    CompileEdges();
+}
+
+void Elite::FiniteStateMachine::AddTransition(FSMState* startState, FSMState* toState, FSMTransition* transition)
+{
+    FSMEdge edge{};
+    edge.FromState = FindOrAdd(m_States, startState);
+    edge.Transition = FindOrAdd(m_Transitions, transition);
+    edge.ToState = FindOrAdd(m_States, toState);
+    m_Edges.push_back(edge);
+
+    //only done while building the graph, recompiling the whole table keeps Update free of any bookkeeping
+    CompileEdges();
 }
 
 void Elite::FiniteStateMachine::Update(float deltaTime)
 {
-    auto it = m_Transitions.find(m_pCurrentState);
-    if (it != m_Transitions.end())
+    ELITE_PROFILE_SCOPE("FiniteStateMachine::Update");
+    //a new tick, the blackboard may have changed since the last one
+    m_IsEvaluated.reset();
+
+    if (m_CurrentStateIdx >= 0)
     {
-        //Since we use a normal for loop to loop over all the transitions
-        //the order that you add the transitions is the order of importance
-        for (TransitionStatePair& transPair : it->second)
+        //the edges of a state are stored in the order they were added, which is the order of importance
+        const int lastEdge{ m_pFirstEdge[m_CurrentStateIdx + 1] };
+        for (int edgeIdx{ m_pFirstEdge[m_CurrentStateIdx] }; edgeIdx < lastEdge; ++edgeIdx)
         {
-            if (transPair.first->ToTransition(m_pBlackboard))
+            const FSMEdge& edge{ m_pEdges[edgeIdx] };
+            if (EvaluateTransition(edge.Transition))
             {
-                SetState(transPair.second);
+                m_Transitions[edge.Transition]->OnTransition(m_pBlackboard);
+                SetState(m_States[edge.ToState], edge.ToState);
                 break;
             }
         }
     }
 
     if (m_pCurrentState)
+    {
+        ELITE_PROFILE_SCOPE(typeid(*m_pCurrentState).name());
         m_pCurrentState->Update(m_pBlackboard, deltaTime );
+    }
 }
 
 Blackboard* Elite::FiniteStateMachine::GetBlackboard() const
@@ -54,15 +84,76 @@ Blackboard* Elite::FiniteStateMachine::GetBlackboard() const
     return m_pBlackboard;
 }
 
-void Elite::FiniteStateMachine::SetState(FSMState* newState)
+void Elite::FiniteStateMachine::SetState(FSMState* pNewState, int newStateIdx)
 {
     if (m_pCurrentState)
         m_pCurrentState->OnExit(m_pBlackboard);
-    m_pCurrentState = newState;
+    m_pCurrentState = pNewState;
+    m_CurrentStateIdx = newStateIdx;
     if (m_pCurrentState)
     {
-        std::cout << "Entering state: " << typeid(*m_pCurrentState).name() << std::endl;
+        ELITE_LOG_INFO("Entering state: %s", typeid(*m_pCurrentState).name());
         m_pCurrentState->OnEnter(m_pBlackboard);
     }
-        
+}
+
+void Elite::FiniteStateMachine::UseTable(const std::vector<FSMState*>& states, const std::vector<FSMTransition*>& transitions, size_t nrTableStates, const int* pFirstEdge, const FSMEdge* pEdges)
+{
+    if (states.size() != nrTableStates)
+    {
+        ELITE_LOG_WARNING("FSM table has %zu states, but %zu were given", nrTableStates, states.size());
+    }
+
+    m_States = states;
+    m_States.resize(nrTableStates, nullptr);
+    m_Transitions = transitions;
+    m_pFirstEdge = pFirstEdge;
+    m_pEdges = pEdges;
+    m_CurrentStateIdx = GetStateIdx(m_pCurrentState);
+}
+
+void Elite::FiniteStateMachine::CompileEdges()
+{
+    const size_t nrStates{ m_States.size() };
+    m_CompiledFirstEdge.resize(nrStates + 1);
+    m_CompiledEdges.resize(m_Edges.size());
+    CompileFSMEdges(m_Edges.data(), m_Edges.size(), nrStates, m_CompiledFirstEdge.data(), m_CompiledEdges.data());
+
+    m_pFirstEdge = m_CompiledFirstEdge.data();
+    m_pEdges = m_CompiledEdges.data();
+    m_CurrentStateIdx = GetStateIdx(m_pCurrentState);
+}
+
+int Elite::FiniteStateMachine::GetStateIdx(FSMState* pState) const
+{
+    const auto it = std::find(m_States.begin(), m_States.end(), pState);
+    return (pState && it != m_States.end()) ? int(it - m_States.begin()) : -1;
+}
+
+bool Elite::FiniteStateMachine::EvaluateTransition(int transitionIdx)
+{
+    if (size_t(transitionIdx) >= m_MaxMemoTransitions)
+    {
+        ELITE_PROFILE_SCOPE(typeid(*m_Transitions[transitionIdx]).name());
+        return m_Transitions[transitionIdx]->ToTransition(m_pBlackboard);
+    }
+
+    if (!m_IsEvaluated[transitionIdx])
+    {
+        ELITE_PROFILE_SCOPE(typeid(*m_Transitions[transitionIdx]).name());
+        m_Results[transitionIdx] = m_Transitions[transitionIdx]->ToTransition(m_pBlackboard);
+        m_IsEvaluated[transitionIdx] = true;
+    }
+    return m_Results[transitionIdx];
+}
+
+template<typename T>
+int Elite::FiniteStateMachine::FindOrAdd(std::vector<T*>& items, T* pItem)
+{
+    const auto it = std::find(items.begin(), items.end(), pItem);
+    if (it != items.end())
+        return int(it - items.begin());
+
+    items.push_back(pItem);
+    return int(items.size()) - 1;
 }
@@ -10,7 +10,8 @@
 
 //--- Includes ---
 #include <vector>
-#include <map>
+#include <array>
+#include <bitset>
 #include "Exam_HelperStructs.h"
 
 namespace Elite
@@ -34,29 +35,112 @@ namespace Elite
 	public:
 		FSMTransition() = default;
 		virtual ~FSMTransition() = default;
+		//pure check, the FSM evaluates it at most once per tick and may reuse the result
 		virtual bool ToTransition(Blackboard* pBlackboard) const = 0;
+		//side effects (setting targets etc.), only called for the transition that fires, before the states switch
+		virtual void OnTransition(Blackboard* pBlackboard) const {};
 	};
 
+	//-----------------------------------------------------------------
+	// TRANSITION TABLE
+	//-----------------------------------------------------------------
+	//One edge of the graph, states and transitions are indices into the arrays handed to the FSM
+	struct FSMEdge
+	{
+		int FromState = 0;
+		int Transition = 0;
+		int ToState = 0;
+	};
+
+	//Graph in compressed rows: the edges leaving state s are Edges[FirstEdge[s]] up to Edges[FirstEdge[s + 1]]
+	//within a state the edges keep the order they were given in, which is their priority
+	template<size_t TNrStates, size_t TNrEdges>
+	struct FSMTable
+	{
+		std::array<int, TNrStates + 1> FirstEdge{};
+		std::array<FSMEdge, TNrEdges> Edges{};
+	};
+
+	//Sorts the edges by start state (stable counting sort), shared by the constexpr and the load time path
+	//pFirstEdge needs nrStates + 1 entries, pSortedEdges nrEdges
+	constexpr void CompileFSMEdges(const FSMEdge* pEdges, size_t nrEdges, size_t nrStates, int* pFirstEdge, FSMEdge* pSortedEdges)
+	{
+		for (size_t s{ 0 }; s <= nrStates; ++s)
+			pFirstEdge[s] = 0;
+		//count the edges per state, shifted by one so the prefix sum gives the row starts
+		for (size_t e{ 0 }; e < nrEdges; ++e)
+			++pFirstEdge[pEdges[e].FromState + 1];
+		for (size_t s{ 0 }; s < nrStates; ++s)
+			pFirstEdge[s + 1] += pFirstEdge[s];
+		//use the row starts as write cursors, afterwards every entry points one row further
+		for (size_t e{ 0 }; e < nrEdges; ++e)
+			pSortedEdges[pFirstEdge[pEdges[e].FromState]++] = pEdges[e];
+		for (size_t s{ nrStates }; s > 0; --s)
+			pFirstEdge[s] = pFirstEdge[s - 1];
+		pFirstEdge[0] = 0;
+	}
+
+	//Compiles an edge list into a table at compile time, e.g. static constexpr auto table{ CompileFSMTable<NrStates>(edges) };
+	template<size_t TNrStates, size_t TNrEdges>
+	constexpr FSMTable<TNrStates, TNrEdges> CompileFSMTable(const std::array<FSMEdge, TNrEdges>& edges)
+	{
+		FSMTable<TNrStates, TNrEdges> table{};
+		CompileFSMEdges(edges.data(), TNrEdges, TNrStates, table.FirstEdge.data(), table.Edges.data());
+		return table;
+	}
+
+	//-----------------------------------------------------------------
+	// FINITE STATE MACHINE
+	//-----------------------------------------------------------------
 	class FiniteStateMachine final
 	{
 	public:
 		FiniteStateMachine(FSMState* startState, Blackboard* pBlackboard);
 		virtual ~FiniteStateMachine();
-		
+
+		//the graph can be given as a compiled table, as an edge list compiled at load time or built edge by edge
+		//the FSM doesn't own the states and transitions, they're indexed by the edges
+		template<size_t TNrStates, size_t TNrEdges>
+		void SetTransitionTable(const std::vector<FSMState*>& states, const std::vector<FSMTransition*>& transitions, const FSMTable<TNrStates, TNrEdges>& table);
+		void SetTransitionTable(const std::vector<FSMState*>& states, const std::vector<FSMTransition*>& transitions, const std::vector<FSMEdge>& edges);
 		void AddTransition(FSMState* startState, FSMState* toState, FSMTransition* transition);
+
 		void Update(float deltaTime);
 		Elite::Blackboard* GetBlackboard() const;
 
 	private:
-		void SetState(FSMState* newState);
+		void SetState(FSMState* pNewState, int newStateIdx);
+		void UseTable(const std::vector<FSMState*>& states, const std::vector<FSMTransition*>& transitions, size_t nrTableStates, const int* pFirstEdge, const FSMEdge* pEdges);
+		void CompileEdges();
+		int GetStateIdx(FSMState* pState) const;
+		bool EvaluateTransition(int transitionIdx);
+		template<typename T> static int FindOrAdd(std::vector<T*>& items, T* pItem);
 	private:
-		typedef std::pair<FSMTransition*, FSMState*> TransitionStatePair;
-		typedef std::vector<TransitionStatePair> Transitions;
+		std::vector<FSMState*> m_States;
+		std::vector<FSMTransition*> m_Transitions;
 
-		std::map<FSMState*, Transitions> m_Transitions; //Key is the state, value are all the transitions for that current state 
-		FSMState* m_pCurrentState;
+		//the table in use, either a compiled table that outlives the FSM or the storage below
+		const int* m_pFirstEdge = nullptr;
+		const FSMEdge* m_pEdges = nullptr;
+		std::vector<FSMEdge> m_Edges; //as given, for AddTransition and load time tables
+		std::vector<int> m_CompiledFirstEdge;
+		std::vector<FSMEdge> m_CompiledEdges;
+
+		//per tick memo of the transition results, indexed by transition
+		static const size_t m_MaxMemoTransitions{ 64 };
+		std::bitset<m_MaxMemoTransitions> m_IsEvaluated;
+		std::bitset<m_MaxMemoTransitions> m_Results;
+
+		FSMState* m_pCurrentState = nullptr;
+		int m_CurrentStateIdx = -1; //-1 if the current state isn't part of the table
 		Blackboard* m_pBlackboard = nullptr; // takes ownership of the blackboard
 	};
 
+	template<size_t TNrStates, size_t TNrEdges>
+	void FiniteStateMachine::SetTransitionTable(const std::vector<FSMState*>& states, const std::vector<FSMTransition*>& transitions, const FSMTable<TNrStates, TNrEdges>& table)
+	{
+		m_Edges.assign(table.Edges.begin(), table.Edges.end());
+		UseTable(states, transitions, TNrStates, table.FirstEdge.data(), table.Edges.data());
+	}
 }
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,357 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "ELogger.h"
+#include <cstring>
+using namespace Elite;
+
+namespace
+{
+	const char* GetLevelName(eLogLevel level)
+	{
+		switch (level)
+		{
+		case eLogLevel::VERBOSE: return "VERBOSE";
+		case eLogLevel::INFO: return "INFO";
+		case eLogLevel::WARNING: return "WARNING";
+		case eLogLevel::CRITICAL: return "CRITICAL";
+		default: return "LOG";
+		}
+	}
+
+	size_t RoundUpToPowerOfTwo(size_t value)
+	{
+		size_t result{ 1 };
+		while (result < value)
+			result <<= 1;
+		return result;
+	}
+
+	template<typename T>
+	void AppendFormatted(std::string& line, const char* pSpec, T value)
+	{
+		char buffer[128]{};
+		const int nrChars{ snprintf(buffer, sizeof(buffer), pSpec, value) };
+		if (nrChars > 0)
+			line.append(buffer, (std::min)(static_cast<size_t>(nrChars), sizeof(buffer) - 1));
+	}
+}
+
+#pragma region LogRecord
+void Elite::LogRecord::Add(const char* pText)
+{
+	LogArg& arg{ NextArg(eLogArgType::STRING) };
+	//once Strings is full the string is empty, the offset points at the terminator the last one kept
+	arg.StringOffset = StringsSize < MaxStringChars ? StringsSize : MaxStringChars - 1;
+	if (!pText)
+		pText = "(null)";
+	//always keep room for the terminator, longer strings are cut off
+	while (*pText && StringsSize + 1 < MaxStringChars)
+	{
+		Strings[StringsSize++] = *pText++;
+	}
+	if (StringsSize < MaxStringChars)
+		Strings[StringsSize++] = '\0';
+	else
+		Strings[MaxStringChars - 1] = '\0';
+}
+
+LogArg& Elite::LogRecord::NextArg(eLogArgType type)
+{
+	LogArg& arg{ Args[NrArgs++] };
+	arg.Type = type;
+	return arg;
+}
+#pragma endregion
+
+#pragma region LogThreadRing
+Elite::LogThreadRing::LogThreadRing(size_t capacity)
+	: m_Records(RoundUpToPowerOfTwo((std::max)(capacity, size_t{ 1 })))
+	, m_Mask{ m_Records.size() - 1 }
+	, m_SiteWindows(64)
+{
+}
+
+LogRecord* Elite::LogThreadRing::BeginPush()
+{
+	const size_t writeIdx{ m_WriteIdx.load(std::memory_order_relaxed) };
+	if (writeIdx - m_ReadIdx.load(std::memory_order_acquire) >= m_Records.size())
+	{
+		m_NrDropped.fetch_add(1, std::memory_order_relaxed);
+		return nullptr;
+	}
+	return &m_Records[writeIdx & m_Mask];
+}
+
+LogThreadRing::SiteWindow& Elite::LogThreadRing::GetSiteWindow(int siteIdx)
+{
+	//only a site this thread never logged from before can grow it
+	if (siteIdx >= int(m_SiteWindows.size()))
+		m_SiteWindows.resize((std::max)(size_t(siteIdx) + 1, 2 * m_SiteWindows.size()));
+	return m_SiteWindows[siteIdx];
+}
+
+void Elite::LogThreadRing::ResetSiteWindows()
+{
+	for (SiteWindow& window : m_SiteWindows)
+		window = SiteWindow{};
+}
+
+const LogRecord* Elite::LogThreadRing::Peek() const
+{
+	const size_t readIdx{ m_ReadIdx.load(std::memory_order_relaxed) };
+	if (readIdx == m_WriteIdx.load(std::memory_order_acquire))
+		return nullptr;
+	return &m_Records[readIdx & m_Mask];
+}
+#pragma endregion
+
+#pragma region Logger
+Logger& Elite::Logger::GetInstance()
+{
+	static Logger logger{};
+	return logger;
+}
+
+Elite::Logger::Logger()
+	: m_Start{ std::chrono::steady_clock::now() }
+	, m_pOutput{ stdout }
+{
+	//room for this many logging threads up front, so the drain thread doesn't allocate next to a tick that's being counted
+	m_DrainRings.reserve(64);
+}
+
+Elite::Logger::~Logger()
+{
+	//the drain thread should be stopped by now, only write what's left
+	if (m_DrainThread.joinable())
+	{
+		{
+			std::lock_guard<std::mutex> lock{ m_ThreadMutex };
+			m_IsDrainThreadStopping = true;
+		}
+		m_WakeUp.notify_all();
+		m_DrainThread.join();
+	}
+	Flush();
+}
+
+void Elite::Logger::StartDrainThread()
+{
+	std::lock_guard<std::mutex> lock{ m_ThreadMutex };
+	if (m_NrDrainThreadUsers++ == 0)
+	{
+		m_IsDrainThreadStopping = false;
+		m_DrainThread = std::thread{ &Logger::DrainLoop, this };
+	}
+}
+
+void Elite::Logger::StopDrainThread()
+{
+	{
+		std::lock_guard<std::mutex> lock{ m_ThreadMutex };
+		if (m_NrDrainThreadUsers == 0 || --m_NrDrainThreadUsers > 0)
+			return;
+		m_IsDrainThreadStopping = true;
+	}
+	m_WakeUp.notify_all();
+	m_DrainThread.join();
+	Flush();
+}
+
+void Elite::Logger::Flush()
+{
+	Drain();
+}
+
+void Elite::Logger::SetOutput(FILE* pOutput)
+{
+	std::lock_guard<std::mutex> lock{ m_DrainMutex };
+	m_pOutput = pOutput;
+}
+
+void Elite::Logger::ResetRateLimits()
+{
+	GetThreadRing().ResetSiteWindows();
+}
+
+bool Elite::Logger::PassesRateLimit(LogThreadRing& ring, LogSite& site, long long timeNs)
+{
+	int siteIdx{ site.Index.load(std::memory_order_acquire) };
+	if (siteIdx == -1)
+	{
+		//two threads can race here, the loser's index is simply never used
+		const int newIdx{ m_NrSites.fetch_add(1, std::memory_order_relaxed) };
+		siteIdx = site.Index.compare_exchange_strong(siteIdx, newIdx, std::memory_order_acq_rel) ? newIdx : siteIdx;
+	}
+
+	const long long windowNs{ 1000000000 };
+	LogThreadRing::SiteWindow& window{ ring.GetSiteWindow(siteIdx) };
+	if (timeNs - window.StartNs >= windowNs)
+	{
+		window.StartNs = timeNs;
+		window.NrInWindow = 0;
+	}
+	if (window.NrInWindow++ < ELITE_LOG_MAX_PER_SITE_PER_SECOND)
+		return true;
+
+	site.NrSuppressed.fetch_add(1, std::memory_order_relaxed);
+	if (!site.IsListed.exchange(true, std::memory_order_acq_rel))
+	{
+		//lock-free push, sites are never removed
+		site.pNextListed = m_pFirstListedSite.load(std::memory_order_relaxed);
+		while (!m_pFirstListedSite.compare_exchange_weak(site.pNextListed, &site, std::memory_order_release, std::memory_order_relaxed))
+		{
+		}
+	}
+	m_HasPendingRecords.store(true, std::memory_order_release);
+	return false;
+}
+
+LogThreadRing& Elite::Logger::GetThreadRing()
+{
+	thread_local LogThreadRing* pRing{ nullptr };
+	if (!pRing)
+		pRing = AddThreadRing();
+	return *pRing;
+}
+
+LogThreadRing* Elite::Logger::AddThreadRing()
+{
+	std::lock_guard<std::mutex> lock{ m_RingsMutex };
+	m_Rings.push_back(std::make_unique<LogThreadRing>(256));
+	return m_Rings.back().get();
+}
+
+void Elite::Logger::DrainLoop()
+{
+	std::unique_lock<std::mutex> lock{ m_ThreadMutex };
+	while (!m_IsDrainThreadStopping)
+	{
+		//producers don't signal, that would cost them a syscall, so poll
+		m_WakeUp.wait_for(lock, std::chrono::milliseconds{ 10 });
+		if (m_HasPendingRecords.exchange(false, std::memory_order_acquire))
+		{
+			lock.unlock();
+			Drain();
+			lock.lock();
+		}
+	}
+}
+
+void Elite::Logger::Drain()
+{
+	std::lock_guard<std::mutex> drainLock{ m_DrainMutex };
+	{
+		//a thread logging for the first time only waits for this copy, not for the writing
+		std::lock_guard<std::mutex> ringsLock{ m_RingsMutex };
+		m_DrainRings.clear();
+		for (const std::unique_ptr<LogThreadRing>& pRing : m_Rings)
+			m_DrainRings.push_back(pRing.get());
+	}
+	for (LogThreadRing* pRing : m_DrainRings)
+	{
+		while (const LogRecord* pRecord{ pRing->Peek() })
+		{
+			Write(*pRecord, m_Line);
+			pRing->Pop();
+		}
+		const int nrDropped{ pRing->TakeNrDropped() };
+		if (nrDropped > 0 && m_pOutput)
+			fprintf(m_pOutput, "WARNING: Log ring was full, %d messages dropped\n", nrDropped);
+	}
+	for (LogSite* pSite{ m_pFirstListedSite.load(std::memory_order_acquire) }; pSite; pSite = pSite->pNextListed)
+	{
+		const int nrSuppressed{ pSite->NrSuppressed.exchange(0, std::memory_order_relaxed) };
+		if (nrSuppressed > 0 && m_pOutput)
+			fprintf(m_pOutput, "%s: %d more \"%s\" suppressed (%s:%d)\n", GetLevelName(pSite->Level), nrSuppressed, pSite->pFormat, pSite->pFile, pSite->Line);
+	}
+	if (m_pOutput)
+		fflush(m_pOutput);
+}
+
+void Elite::Logger::Write(const LogRecord& record, std::string& line) const
+{
+	if (!m_pOutput)
+		return;
+
+	const LogSite& site{ *record.pSite };
+	line.clear();
+	line += GetLevelName(site.Level);
+	line += ": ";
+
+	//printf on one argument at a time, with the length modifier replaced by the one of the stored type
+	unsigned int argIdx{ 0 };
+	for (const char* pChar{ site.pFormat }; *pChar; ++pChar)
+	{
+		if (*pChar != '%')
+		{
+			line += *pChar;
+			continue;
+		}
+		if (pChar[1] == '%')
+		{
+			line += '%';
+			++pChar;
+			continue;
+		}
+
+		std::string spec{ "%" };
+		const char* pSpecChar{ pChar + 1 };
+		while (*pSpecChar && strchr("-+ #0123456789.", *pSpecChar))
+			spec += *pSpecChar++;
+		while (*pSpecChar && strchr("hljztL", *pSpecChar))
+			++pSpecChar;
+		const char conversion{ *pSpecChar };
+		if (!conversion)
+			break;
+		pChar = pSpecChar;
+
+		if (argIdx >= record.NrArgs)
+		{
+			line += "<missing>";
+			continue;
+		}
+		const LogArg& arg{ record.Args[argIdx++] };
+		switch (arg.Type)
+		{
+		case eLogArgType::INT:
+		case eLogArgType::UINT:
+			if (strchr("diuoxXc", conversion))
+			{
+				const bool isSigned{ arg.Type == eLogArgType::INT };
+				spec += conversion == 'c' ? "c" : (isSigned ? "lld" : "llu");
+				if (strchr("oxX", conversion))
+					spec.back() = conversion;
+				if (conversion == 'c')
+					AppendFormatted(line, spec.c_str(), static_cast<int>(arg.Int));
+				else if (isSigned && spec.back() == 'd')
+					AppendFormatted(line, spec.c_str(), arg.Int);
+				else
+					AppendFormatted(line, spec.c_str(), arg.UInt);
+			}
+			else if (strchr("feEgGaA", conversion))
+				AppendFormatted(line, (spec + conversion).c_str(), arg.Type == eLogArgType::INT ? static_cast<double>(arg.Int) : static_cast<double>(arg.UInt));
+			else
+				AppendFormatted(line, "%lld", arg.Int);
+			break;
+		case eLogArgType::FLOAT:
+			AppendFormatted(line, (spec + (strchr("feEgGaA", conversion) ? conversion : 'f')).c_str(), arg.Float);
+			break;
+		case eLogArgType::POINTER:
+			AppendFormatted(line, "%p", arg.pPointer);
+			break;
+		case eLogArgType::STRING:
+			line += &record.Strings[arg.StringOffset];
+			break;
+		default:
+			break;
+		}
+	}
+
+	//the logger adds the newline, one in the format would leave an empty line
+	while (!line.empty() && line.back() == '\n')
+		line.pop_back();
+	line += '\n';
+	fwrite(line.data(), 1, line.size(), m_pOutput);
+}
+#pragma endregion
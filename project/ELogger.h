@@ -0,0 +1,277 @@
+/*=============================================================================*/
+// Copyright 2020-2021 Elite Engine
+/*=============================================================================*/
+// ELogger.h: Non-blocking logger, binary records in per-thread rings formatted by a drain thread
+/*=============================================================================*/
+#ifndef ELITE_LOGGER
+#define ELITE_LOGGER
+
+//--- Includes ---
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <memory>
+#include <string>
+#include <type_traits>
+
+//Levels below ELITE_LOG_LEVEL are compiled out, arguments included
+#define ELITE_LOG_LEVEL_VERBOSE 0
+#define ELITE_LOG_LEVEL_INFO 1
+#define ELITE_LOG_LEVEL_WARNING 2
+#define ELITE_LOG_LEVEL_CRITICAL 3
+#define ELITE_LOG_LEVEL_NONE 4
+#ifndef ELITE_LOG_LEVEL
+#define ELITE_LOG_LEVEL ELITE_LOG_LEVEL_INFO
+#endif
+
+//Messages per call site per second and per thread, the rest is counted and the drain thread reports how many were suppressed
+#ifndef ELITE_LOG_MAX_PER_SITE_PER_SECOND
+#define ELITE_LOG_MAX_PER_SITE_PER_SECOND 10
+#endif
+
+//printf style, the format has to be a literal, the logger adds the level prefix and the newline
+//usage: ELITE_LOG_WARNING("Data '%s' not found in Blackboard", name.c_str());
+#define ELITE_LOG(level, format, ...) \
+	do { \
+		static Elite::LogSite eliteLogSite{ Elite::eLogLevel::level, format, __FILE__, __LINE__ }; \
+		Elite::Logger::GetInstance().Log(eliteLogSite, ##__VA_ARGS__); \
+	} while (false)
+
+#if ELITE_LOG_LEVEL <= ELITE_LOG_LEVEL_VERBOSE
+#define ELITE_LOG_VERBOSE(format, ...) ELITE_LOG(VERBOSE, format, ##__VA_ARGS__)
+#else
+#define ELITE_LOG_VERBOSE(format, ...) do {} while (false)
+#endif
+#if ELITE_LOG_LEVEL <= ELITE_LOG_LEVEL_INFO
+#define ELITE_LOG_INFO(format, ...) ELITE_LOG(INFO, format, ##__VA_ARGS__)
+#else
+#define ELITE_LOG_INFO(format, ...) do {} while (false)
+#endif
+#if ELITE_LOG_LEVEL <= ELITE_LOG_LEVEL_WARNING
+#define ELITE_LOG_WARNING(format, ...) ELITE_LOG(WARNING, format, ##__VA_ARGS__)
+#else
+#define ELITE_LOG_WARNING(format, ...) do {} while (false)
+#endif
+#if ELITE_LOG_LEVEL <= ELITE_LOG_LEVEL_CRITICAL
+#define ELITE_LOG_CRITICAL(format, ...) ELITE_LOG(CRITICAL, format, ##__VA_ARGS__)
+#else
+#define ELITE_LOG_CRITICAL(format, ...) do {} while (false)
+#endif
+
+namespace Elite
+{
+	enum class eLogLevel
+	{
+		VERBOSE,
+		INFO,
+		WARNING,
+		CRITICAL,
+
+		//@END
+		_COUNT
+	};
+
+	//One per ELITE_LOG call, static so the records only need to point to it
+	struct LogSite
+	{
+		LogSite(eLogLevel level, const char* pFormat, const char* pFile, int line)
+			: Level{ level }, pFormat{ pFormat }, pFile{ pFile }, Line{ line }
+		{}
+
+		const eLogLevel Level;
+		const char* const pFormat;
+		const char* const pFile;
+		const int Line;
+
+		//the rate limit window of the site in every thread's ring, assigned the first time any thread logs from it
+		std::atomic<int> Index{ -1 };
+		std::atomic<int> NrSuppressed{ 0 };
+		//sites that ever suppressed a message form a list, so the drain thread can report them
+		std::atomic<bool> IsListed{ false };
+		LogSite* pNextListed = nullptr;
+	};
+
+	enum class eLogArgType : unsigned char
+	{
+		INT,
+		UINT,
+		FLOAT,
+		POINTER,
+		STRING,
+
+		//@END
+		_COUNT
+	};
+
+	struct LogArg
+	{
+		eLogArgType Type = eLogArgType::INT;
+		union
+		{
+			long long Int;
+			unsigned long long UInt;
+			double Float;
+			const void* pPointer;
+			unsigned int StringOffset; //into LogRecord::Strings
+		};
+	};
+
+	//Arguments are stored as values, strings are copied (and truncated) so they don't have to outlive the call
+	struct LogRecord
+	{
+		static const unsigned int MaxArgs{ 8 };
+		static const unsigned int MaxStringChars{ 160 };
+
+		const LogSite* pSite = nullptr;
+		long long TimeNs = 0;
+		unsigned int NrArgs = 0;
+		unsigned int StringsSize = 0;
+		LogArg Args[MaxArgs];
+		char Strings[MaxStringChars];
+
+		void Add(long long value) { LogArg& arg{ NextArg(eLogArgType::INT) }; arg.Int = value; }
+		void Add(unsigned long long value) { LogArg& arg{ NextArg(eLogArgType::UINT) }; arg.UInt = value; }
+		void Add(double value) { LogArg& arg{ NextArg(eLogArgType::FLOAT) }; arg.Float = value; }
+		void Add(const void* pValue) { LogArg& arg{ NextArg(eLogArgType::POINTER) }; arg.pPointer = pValue; }
+		void Add(const char* pText);
+		void Add(char* pText) { Add(static_cast<const char*>(pText)); }
+		void Add(const std::string& text) { Add(text.c_str()); }
+
+		//every other argument is widened to one of the stored types
+		template<typename T>
+		void Add(const T& value)
+		{
+			if constexpr (std::is_array_v<T>)
+				Add(static_cast<const char*>(value));
+			else if constexpr (std::is_enum_v<T>)
+				Add(static_cast<long long>(value));
+			else if constexpr (std::is_floating_point_v<T>)
+				Add(static_cast<double>(value));
+			else if constexpr (std::is_integral_v<T> && std::is_signed_v<T>)
+				Add(static_cast<long long>(value));
+			else if constexpr (std::is_integral_v<T>)
+				Add(static_cast<unsigned long long>(value));
+			else
+				Add(static_cast<const void*>(value));
+		}
+
+	private:
+		LogArg& NextArg(eLogArgType type);
+	};
+
+	//Single producer (the owning thread), single consumer (whoever holds the drain lock)
+	//when it's full new records are dropped and counted, the producer never waits
+	class LogThreadRing final
+	{
+	public:
+		explicit LogThreadRing(size_t capacity);
+
+		LogRecord* BeginPush();
+		void EndPush() { m_WriteIdx.store(m_WriteIdx.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+		const LogRecord* Peek() const;
+		void Pop() { m_ReadIdx.store(m_ReadIdx.load(std::memory_order_relaxed) + 1, std::memory_order_release); }
+
+		int TakeNrDropped() { return m_NrDropped.exchange(0, std::memory_order_relaxed); }
+
+		//the owning thread's rate limit of a site, nobody else touches these
+		struct SiteWindow
+		{
+			long long StartNs = 0;
+			int NrInWindow = 0;
+		};
+		SiteWindow& GetSiteWindow(int siteIdx);
+		void ResetSiteWindows();
+
+	private:
+		std::vector<LogRecord> m_Records;
+		size_t m_Mask;
+		std::vector<SiteWindow> m_SiteWindows;
+		std::atomic<size_t> m_WriteIdx{ 0 };
+		std::atomic<size_t> m_ReadIdx{ 0 };
+		std::atomic<int> m_NrDropped{ 0 };
+	};
+
+	class Logger final
+	{
+	public:
+		static Logger& GetInstance();
+		~Logger();
+
+		template<typename... TArgs>
+		void Log(LogSite& site, const TArgs&... args)
+		{
+			static_assert(sizeof...(TArgs) <= LogRecord::MaxArgs, "Too many log arguments");
+			const long long timeNs{ GetTimeNs() };
+			LogThreadRing& ring{ GetThreadRing() };
+			if (!PassesRateLimit(ring, site, timeNs))
+				return;
+
+			LogRecord* pRecord{ ring.BeginPush() };
+			if (!pRecord)
+				return;
+			pRecord->pSite = &site;
+			pRecord->TimeNs = timeNs;
+			pRecord->NrArgs = 0;
+			pRecord->StringsSize = 0;
+			(pRecord->Add(args), ...);
+			ring.EndPush();
+			m_HasPendingRecords.store(true, std::memory_order_release);
+		}
+
+		//reference counted, the last StopDrainThread joins it and writes what's left
+		//call these from plugin init/shutdown, never from static destructors (dll unload)
+		void StartDrainThread();
+		void StopDrainThread();
+
+		//starts the rate limit of every site over for the calling thread, so one plugin instance (an episode) doesn't use up the next one's
+		void ResetRateLimits();
+
+		//formats and writes everything recorded so far on the calling thread
+		void Flush();
+		//nullptr discards the output, stdout by default
+		void SetOutput(FILE* pOutput);
+
+		Logger(const Logger& other) = delete;
+		Logger& operator=(const Logger& rhs) = delete;
+		Logger(Logger&& other) = delete;
+		Logger& operator=(Logger&& rhs) = delete;
+	private:
+		Logger();
+		long long GetTimeNs() const
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_Start).count();
+		}
+		bool PassesRateLimit(LogThreadRing& ring, LogSite& site, long long timeNs);
+		LogThreadRing& GetThreadRing();
+		LogThreadRing* AddThreadRing();
+		void DrainLoop();
+		void Drain();
+		void Write(const LogRecord& record, std::string& line) const;
+
+		const std::chrono::steady_clock::time_point m_Start;
+		std::atomic<bool> m_HasPendingRecords{ false };
+		std::atomic<LogSite*> m_pFirstListedSite{ nullptr };
+		std::atomic<int> m_NrSites{ 0 };
+
+		//only locked when a thread logs for the first time and while the drain copies the list
+		std::mutex m_RingsMutex;
+		std::vector<std::unique_ptr<LogThreadRing>> m_Rings;
+
+		std::mutex m_DrainMutex;
+		//the rings are never removed, so a copy of the list can be drained without holding m_RingsMutex
+		std::vector<LogThreadRing*> m_DrainRings;
+		FILE* m_pOutput;
+		std::string m_Line;
+
+		std::mutex m_ThreadMutex;
+		std::condition_variable m_WakeUp;
+		std::thread m_DrainThread;
+		int m_NrDrainThreadUsers{ 0 };
+		bool m_IsDrainThreadStopping{ false };
+	};
+}
+#endif
@@ -0,0 +1,202 @@
+/*=============================================================================*/
+// Copyright 2020-2021 Elite Engine
+/*=============================================================================*/
+// EOpenHashMap.h: flat hash map with linear probing for integer keys
+/*=============================================================================*/
+#ifndef ELITE_OPEN_HASH_MAP
+#define ELITE_OPEN_HASH_MAP
+
+//Includes
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace Elite
+{
+	//Keys and values live in one array, a lookup probes neighbouring slots instead of chasing list nodes
+	//erasing shifts the following entries back, so there are no tombstones and probe runs stay short
+	//only grows when more than half the slots are used, after Reserve it doesn't allocate until that capacity is exceeded
+	template<typename TKey, typename TValue>
+	class OpenHashMap final
+	{
+		static_assert(std::is_integral<TKey>::value, "OpenHashMap only supports integer keys");
+	public:
+		OpenHashMap() = default;
+
+		void Reserve(size_t nrElements);
+		void Clear();
+		size_t Size() const { return m_Size; }
+		bool IsEmpty() const { return m_Size == 0; }
+
+		TValue* Find(TKey key);
+		const TValue* Find(TKey key) const;
+		//inserts a default constructed value if the key isn't in the map yet
+		TValue& FindOrAdd(TKey key, bool& isAdded);
+		//returns false if the key wasn't in the map
+		bool Erase(TKey key);
+
+		//calls visitor(key, value) for every element, in slot order
+		template<typename Visitor>
+		void ForEach(Visitor visitor) const;
+
+	private:
+		struct Slot
+		{
+			TKey Key;
+			TValue Value;
+			bool IsUsed;
+		};
+
+		size_t GetHomeSlot(TKey key) const
+		{
+			//fibonacci hashing, the high bits of the product are well mixed even for sequential keys
+			return size_t((uint64_t(key) * 0x9E3779B97F4A7C15ull) >> m_Shift);
+		}
+		size_t FindSlot(TKey key) const;
+		void Grow(size_t nrSlots);
+
+		std::vector<Slot> m_Slots;
+		size_t m_Size{ 0 };
+		unsigned int m_Shift{ 64 };
+	};
+
+	template<typename TKey, typename TValue>
+	void OpenHashMap<TKey, TValue>::Reserve(size_t nrElements)
+	{
+		size_t nrSlots{ 8 };
+		while (nrSlots < 2 * nrElements)
+		{
+			nrSlots *= 2;
+		}
+		if (nrSlots > m_Slots.size())
+		{
+			Grow(nrSlots);
+		}
+	}
+
+	template<typename TKey, typename TValue>
+	void OpenHashMap<TKey, TValue>::Clear()
+	{
+		for (Slot& slot : m_Slots)
+		{
+			slot = Slot{};
+		}
+		m_Size = 0;
+	}
+
+	template<typename TKey, typename TValue>
+	size_t OpenHashMap<TKey, TValue>::FindSlot(TKey key) const
+	{
+		//returns the slot holding the key, or the empty slot where it would go
+		const size_t mask{ m_Slots.size() - 1 };
+		size_t slotIdx{ GetHomeSlot(key) };
+		while (m_Slots[slotIdx].IsUsed && m_Slots[slotIdx].Key != key)
+		{
+			slotIdx = (slotIdx + 1) & mask;
+		}
+		return slotIdx;
+	}
+
+	template<typename TKey, typename TValue>
+	TValue* OpenHashMap<TKey, TValue>::Find(TKey key)
+	{
+		return const_cast<TValue*>(static_cast<const OpenHashMap*>(this)->Find(key));
+	}
+
+	template<typename TKey, typename TValue>
+	const TValue* OpenHashMap<TKey, TValue>::Find(TKey key) const
+	{
+		if (m_Slots.empty())
+		{
+			return nullptr;
+		}
+		const Slot& slot{ m_Slots[FindSlot(key)] };
+		return slot.IsUsed ? &slot.Value : nullptr;
+	}
+
+	template<typename TKey, typename TValue>
+	TValue& OpenHashMap<TKey, TValue>::FindOrAdd(TKey key, bool& isAdded)
+	{
+		if (2 * (m_Size + 1) > m_Slots.size())
+		{
+			Grow((std::max)(size_t(8), 2 * m_Slots.size()));
+		}
+
+		Slot& slot{ m_Slots[FindSlot(key)] };
+		isAdded = !slot.IsUsed;
+		if (isAdded)
+		{
+			slot.Key = key;
+			slot.Value = TValue{};
+			slot.IsUsed = true;
+			++m_Size;
+		}
+		return slot.Value;
+	}
+
+	template<typename TKey, typename TValue>
+	bool OpenHashMap<TKey, TValue>::Erase(TKey key)
+	{
+		if (m_Slots.empty())
+		{
+			return false;
+		}
+
+		const size_t mask{ m_Slots.size() - 1 };
+		size_t holeIdx{ FindSlot(key) };
+		if (!m_Slots[holeIdx].IsUsed)
+		{
+			return false;
+		}
+
+		//pull back every following entry of the probe run that may live in the hole, until an empty slot ends the run
+		for (size_t slotIdx{ (holeIdx + 1) & mask }; m_Slots[slotIdx].IsUsed; slotIdx = (slotIdx + 1) & mask)
+		{
+			const size_t homeIdx{ GetHomeSlot(m_Slots[slotIdx].Key) };
+			//the entry may move if its home slot isn't in the cyclic range (hole, slot]
+			const bool isHomeAfterHole{ ((slotIdx - homeIdx) & mask) < ((slotIdx - holeIdx) & mask) };
+			if (!isHomeAfterHole)
+			{
+				m_Slots[holeIdx] = m_Slots[slotIdx];
+				holeIdx = slotIdx;
+			}
+		}
+		m_Slots[holeIdx] = Slot{};
+		--m_Size;
+		return true;
+	}
+
+	template<typename TKey, typename TValue>
+	template<typename Visitor>
+	void OpenHashMap<TKey, TValue>::ForEach(Visitor visitor) const
+	{
+		for (const Slot& slot : m_Slots)
+		{
+			if (slot.IsUsed)
+			{
+				visitor(slot.Key, slot.Value);
+			}
+		}
+	}
+
+	template<typename TKey, typename TValue>
+	void OpenHashMap<TKey, TValue>::Grow(size_t nrSlots)
+	{
+		std::vector<Slot> oldSlots(nrSlots);
+		oldSlots.swap(m_Slots);
+		m_Shift = 64;
+		for (size_t size{ nrSlots }; size > 1; size /= 2)
+		{
+			--m_Shift;
+		}
+
+		for (const Slot& slot : oldSlots)
+		{
+			if (slot.IsUsed)
+			{
+				m_Slots[FindSlot(slot.Key)] = slot;
+			}
+		}
+	}
+}
+#endif
@@ -0,0 +1,120 @@
+//=== General Includes ===
+#include "stdafx.h"
+#include "EProfiler.h"
+#include "ELogger.h"
+
+#ifdef ELITE_PROFILING
+using namespace Elite;
+
+namespace
+{
+	size_t RoundUpToPowerOfTwo(size_t value)
+	{
+		size_t result{ 1 };
+		while (result < value)
+			result <<= 1;
+		return result;
+	}
+
+	//mangled type names and literals only, but a quote or backslash would break the file
+	void WriteJsonString(FILE* pFile, const char* pText)
+	{
+		fputc('"', pFile);
+		for (const char* pChar{ pText ? pText : "" }; *pChar; ++pChar)
+		{
+			if (*pChar == '"' || *pChar == '\\')
+				fputc('\\', pFile);
+			if (static_cast<unsigned char>(*pChar) >= 0x20)
+				fputc(*pChar, pFile);
+		}
+		fputc('"', pFile);
+	}
+}
+
+Elite::ProfileThreadBuffer::ProfileThreadBuffer(size_t capacity, int threadId)
+	: m_Events(RoundUpToPowerOfTwo((std::max)(capacity, size_t{ 1 })))
+	, m_Mask{ m_Events.size() - 1 }
+	, m_ThreadId{ threadId }
+{
+}
+
+void Elite::ProfileThreadBuffer::CopyEvents(std::vector<ProfileEvent>& events) const
+{
+	const size_t nrWritten{ m_NrWritten.load(std::memory_order_acquire) };
+	const size_t nrKept{ (std::min)(nrWritten, m_Events.size()) };
+	for (size_t i{ nrWritten - nrKept }; i < nrWritten; ++i)
+	{
+		events.push_back(m_Events[i & m_Mask]);
+	}
+}
+
+Profiler& Elite::Profiler::GetInstance()
+{
+	static Profiler profiler{};
+	return profiler;
+}
+
+Elite::Profiler::Profiler()
+	: m_Start{ std::chrono::steady_clock::now() }
+	, m_ThreadBufferCapacity{ size_t{ 1 } << 16 }
+{
+}
+
+bool Elite::Profiler::ExportChromeTrace(const std::string& path) const
+{
+	FILE* pFile{ fopen(path.c_str(), "w") };
+	if (!pFile)
+	{
+		ELITE_LOG_WARNING("Could not open '%s' to write the profile to", path);
+		return false;
+	}
+
+	//complete events ("ph":"X"), timestamps and durations in microseconds
+	fprintf(pFile, "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[");
+	bool isFirst{ true };
+	std::vector<ProfileEvent> events{};
+	std::lock_guard<std::mutex> lock{ m_BuffersMutex };
+	for (const std::unique_ptr<ProfileThreadBuffer>& pBuffer : m_Buffers)
+	{
+		events.clear();
+		pBuffer->CopyEvents(events);
+		for (const ProfileEvent& event : events)
+		{
+			fprintf(pFile, isFirst ? "\n" : ",\n");
+			isFirst = false;
+			fprintf(pFile, "{\"name\":");
+			WriteJsonString(pFile, event.pName);
+			fprintf(pFile, ",\"ph\":\"X\",\"pid\":0,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+				pBuffer->GetThreadId(), event.StartNs / 1000.0, event.DurationNs / 1000.0);
+		}
+	}
+	fprintf(pFile, "\n]}\n");
+	fclose(pFile);
+	return true;
+}
+
+void Elite::Profiler::Clear()
+{
+	std::lock_guard<std::mutex> lock{ m_BuffersMutex };
+	for (const std::unique_ptr<ProfileThreadBuffer>& pBuffer : m_Buffers)
+	{
+		pBuffer->Clear();
+	}
+}
+
+ProfileThreadBuffer& Elite::Profiler::GetThreadBuffer()
+{
+	thread_local ProfileThreadBuffer* pBuffer{ nullptr };
+	if (!pBuffer)
+		pBuffer = AddThreadBuffer();
+	return *pBuffer;
+}
+
+ProfileThreadBuffer* Elite::Profiler::AddThreadBuffer()
+{
+	std::lock_guard<std::mutex> lock{ m_BuffersMutex };
+	const int threadId{ static_cast<int>(m_Buffers.size()) };
+	m_Buffers.push_back(std::make_unique<ProfileThreadBuffer>(m_ThreadBufferCapacity.load(), threadId));
+	return m_Buffers.back().get();
+}
+#endif
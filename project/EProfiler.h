@@ -0,0 +1,122 @@
+/*=============================================================================*/
+// Copyright 2020-2021 Elite Engine
+/*=============================================================================*/
+// EProfiler.h: Scoped timers recorded into per-thread ring buffers, exported as a Chrome trace
+/*=============================================================================*/
+#ifndef ELITE_PROFILER
+#define ELITE_PROFILER
+
+//Only compiled in when ELITE_PROFILING is defined, otherwise ELITE_PROFILE_SCOPE expands to nothing
+//usage: ELITE_PROFILE_SCOPE("Plugin::UpdateSteering");
+//the name isn't copied, it has to outlive the profiler (string literals, typeid(...).name())
+#ifdef ELITE_PROFILING
+#define ELITE_PROFILE_CONCAT_IMPL(a, b) a##b
+#define ELITE_PROFILE_CONCAT(a, b) ELITE_PROFILE_CONCAT_IMPL(a, b)
+#define ELITE_PROFILE_SCOPE(name) const Elite::ProfileScope ELITE_PROFILE_CONCAT(profileScope, __LINE__){ name }
+#else
+#define ELITE_PROFILE_SCOPE(name)
+#endif
+
+#ifdef ELITE_PROFILING
+//--- Includes ---
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <vector>
+#include <memory>
+#include <string>
+
+namespace Elite
+{
+	struct ProfileEvent
+	{
+		const char* pName = nullptr;
+		long long StartNs = 0; //since the profiler started
+		long long DurationNs = 0;
+	};
+
+	//Single writer (the owning thread), the oldest events get overwritten once it's full
+	class ProfileThreadBuffer final
+	{
+	public:
+		ProfileThreadBuffer(size_t capacity, int threadId);
+
+		void Push(const ProfileEvent& event)
+		{
+			const size_t writeIdx{ m_NrWritten.load(std::memory_order_relaxed) };
+			m_Events[writeIdx & m_Mask] = event;
+			m_NrWritten.store(writeIdx + 1, std::memory_order_release);
+		}
+
+		//the events still in the buffer, oldest first
+		void CopyEvents(std::vector<ProfileEvent>& events) const;
+		void Clear() { m_NrWritten.store(0, std::memory_order_release); }
+		int GetThreadId() const { return m_ThreadId; }
+
+	private:
+		std::vector<ProfileEvent> m_Events;
+		size_t m_Mask;
+		std::atomic<size_t> m_NrWritten{ 0 };
+		int m_ThreadId;
+	};
+
+	class Profiler final
+	{
+	public:
+		static Profiler& GetInstance();
+
+		long long GetTimeNs() const
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - m_Start).count();
+		}
+		void Record(const char* pName, long long startNs, long long durationNs)
+		{
+			GetThreadBuffer().Push(ProfileEvent{ pName, startNs, durationNs });
+		}
+
+		//export and clear while the profiled threads are idle (between frames or after a run)
+		bool ExportChromeTrace(const std::string& path) const;
+		void Clear();
+
+		//events per thread, rounded up to a power of two, only affects threads that haven't recorded yet
+		void SetThreadBufferCapacity(size_t capacity) { m_ThreadBufferCapacity = capacity; }
+
+		Profiler(const Profiler& other) = delete;
+		Profiler& operator=(const Profiler& rhs) = delete;
+		Profiler(Profiler&& other) = delete;
+		Profiler& operator=(Profiler&& rhs) = delete;
+	private:
+		Profiler();
+		ProfileThreadBuffer& GetThreadBuffer();
+		ProfileThreadBuffer* AddThreadBuffer();
+
+		const std::chrono::steady_clock::time_point m_Start;
+		std::atomic<size_t> m_ThreadBufferCapacity;
+		//only locked when a thread records its first event and when exporting
+		mutable std::mutex m_BuffersMutex;
+		//owned by the profiler, so the events of finished threads can still be exported
+		std::vector<std::unique_ptr<ProfileThreadBuffer>> m_Buffers;
+	};
+
+	class ProfileScope final
+	{
+	public:
+		explicit ProfileScope(const char* pName)
+			: m_pName{ pName }
+			, m_StartNs{ Profiler::GetInstance().GetTimeNs() }
+		{}
+		~ProfileScope()
+		{
+			Profiler& profiler{ Profiler::GetInstance() };
+			profiler.Record(m_pName, m_StartNs, profiler.GetTimeNs() - m_StartNs);
+		}
+
+		ProfileScope(const ProfileScope& other) = delete;
+		ProfileScope& operator=(const ProfileScope& rhs) = delete;
+	private:
+		const char* m_pName;
+		long long m_StartNs;
+	};
+}
+#endif
+#endif
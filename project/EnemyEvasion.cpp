@@ -0,0 +1,103 @@
+#include "stdafx.h"
+#include "EnemyEvasion.h"
+
+//x64 always has SSE2, a 32 bit build only with /arch:SSE2 or -msse2
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ENEMY_EVASION_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	//below this the enemy moves along with the agent, the closest approach is now
+	const float g_MinRelativeSpeedSq{ 1e-6f };
+	//an approach closer than this has no direction of its own, head on, the agent is pushed away from where the enemy is now
+	const float g_MinDistanceSq{ 1e-4f };
+
+	//what one enemy adds to the avoidance, relative to the agent, the SSE path does the same per lane
+	void AddAvoidance(float x, float y, float velocityX, float velocityY, float collisionDistance, float horizon, Elite::Vector2& avoidance)
+	{
+		const float approachTime{ Elite::Clamp(-(x * velocityX + y * velocityY) / (std::max)(velocityX * velocityX + velocityY * velocityY, g_MinRelativeSpeedSq), 0.f, horizon) };
+		const float closestX{ x + velocityX * approachTime };
+		const float closestY{ y + velocityY * approachTime };
+		const float closestDistanceSq{ closestX * closestX + closestY * closestY };
+		if (closestDistanceSq >= collisionDistance * collisionDistance)
+		{
+			return;
+		}
+		const float urgency{ (1.f - approachTime / horizon) * (1.f - sqrtf(closestDistanceSq) / collisionDistance) };
+		const bool isHeadOn{ closestDistanceSq < g_MinDistanceSq };
+		const float awayX{ isHeadOn ? x : closestX };
+		const float awayY{ isHeadOn ? y : closestY };
+		const float push{ urgency / sqrtf((std::max)(awayX * awayX + awayY * awayY, g_MinDistanceSq)) };
+		avoidance.x -= awayX * push;
+		avoidance.y -= awayY * push;
+	}
+}
+
+Elite::Vector2 EnemyEvasion::GetAvoidance(const EnemyFrame& enemies, const AgentInfo& agentInfo, float clearance, float horizon)
+{
+	const size_t nrEnemies{ enemies.Size() };
+	//an enemy bites within its size plus the agent's
+	const float agentDistance{ agentInfo.AgentSize + clearance };
+	Elite::Vector2 avoidance{};
+	size_t idx{ 0 };
+#ifdef ENEMY_EVASION_SSE2
+	const __m128 agentX{ _mm_set1_ps(agentInfo.Position.x) };
+	const __m128 agentY{ _mm_set1_ps(agentInfo.Position.y) };
+	const __m128 agentVelocityX{ _mm_set1_ps(agentInfo.LinearVelocity.x) };
+	const __m128 agentVelocityY{ _mm_set1_ps(agentInfo.LinearVelocity.y) };
+	const __m128 agentDistance4{ _mm_set1_ps(agentDistance) };
+	const __m128 horizon4{ _mm_set1_ps(horizon) };
+	const __m128 minRelativeSpeedSq4{ _mm_set1_ps(g_MinRelativeSpeedSq) };
+	const __m128 minDistanceSq4{ _mm_set1_ps(g_MinDistanceSq) };
+	const __m128 one4{ _mm_set1_ps(1.f) };
+	__m128 avoidanceX{ _mm_setzero_ps() };
+	__m128 avoidanceY{ _mm_setzero_ps() };
+	for (; idx + 4 <= nrEnemies; idx += 4)
+	{
+		const __m128 x{ _mm_sub_ps(_mm_loadu_ps(enemies.X.data() + idx), agentX) };
+		const __m128 y{ _mm_sub_ps(_mm_loadu_ps(enemies.Y.data() + idx), agentY) };
+		const __m128 velocityX{ _mm_sub_ps(_mm_loadu_ps(enemies.VelocityX.data() + idx), agentVelocityX) };
+		const __m128 velocityY{ _mm_sub_ps(_mm_loadu_ps(enemies.VelocityY.data() + idx), agentVelocityY) };
+		const __m128 collisionDistance{ _mm_add_ps(_mm_loadu_ps(enemies.BodySize.data() + idx), agentDistance4) };
+
+		const __m128 relativeSpeedSq{ _mm_max_ps(_mm_add_ps(_mm_mul_ps(velocityX, velocityX), _mm_mul_ps(velocityY, velocityY)), minRelativeSpeedSq4) };
+		const __m128 closing{ _mm_sub_ps(_mm_setzero_ps(), _mm_add_ps(_mm_mul_ps(x, velocityX), _mm_mul_ps(y, velocityY))) };
+		const __m128 approachTime{ _mm_min_ps(_mm_max_ps(_mm_div_ps(closing, relativeSpeedSq), _mm_setzero_ps()), horizon4) };
+		const __m128 closestX{ _mm_add_ps(x, _mm_mul_ps(velocityX, approachTime)) };
+		const __m128 closestY{ _mm_add_ps(y, _mm_mul_ps(velocityY, approachTime)) };
+		const __m128 closestDistanceSq{ _mm_add_ps(_mm_mul_ps(closestX, closestX), _mm_mul_ps(closestY, closestY)) };
+		const __m128 isColliding{ _mm_cmplt_ps(closestDistanceSq, _mm_mul_ps(collisionDistance, collisionDistance)) };
+		if (_mm_movemask_ps(isColliding) == 0)
+		{
+			continue;
+		}
+
+		const __m128 urgency{ _mm_mul_ps(
+			_mm_sub_ps(one4, _mm_div_ps(approachTime, horizon4)),
+			_mm_sub_ps(one4, _mm_div_ps(_mm_sqrt_ps(closestDistanceSq), collisionDistance))) };
+		const __m128 isHeadOn{ _mm_cmplt_ps(closestDistanceSq, minDistanceSq4) };
+		const __m128 awayX{ _mm_or_ps(_mm_and_ps(isHeadOn, x), _mm_andnot_ps(isHeadOn, closestX)) };
+		const __m128 awayY{ _mm_or_ps(_mm_and_ps(isHeadOn, y), _mm_andnot_ps(isHeadOn, closestY)) };
+		const __m128 awayDistance{ _mm_sqrt_ps(_mm_max_ps(_mm_add_ps(_mm_mul_ps(awayX, awayX), _mm_mul_ps(awayY, awayY)), minDistanceSq4)) };
+		const __m128 push{ _mm_and_ps(_mm_div_ps(urgency, awayDistance), isColliding) };
+		avoidanceX = _mm_sub_ps(avoidanceX, _mm_mul_ps(awayX, push));
+		avoidanceY = _mm_sub_ps(avoidanceY, _mm_mul_ps(awayY, push));
+	}
+	alignas(16) float sumX[4];
+	alignas(16) float sumY[4];
+	_mm_store_ps(sumX, avoidanceX);
+	_mm_store_ps(sumY, avoidanceY);
+	avoidance.x = (sumX[0] + sumX[1]) + (sumX[2] + sumX[3]);
+	avoidance.y = (sumY[0] + sumY[1]) + (sumY[2] + sumY[3]);
+#endif
+	//the last 1 to 3 enemies, every one of them without SSE2
+	for (; idx < nrEnemies; ++idx)
+	{
+		AddAvoidance(enemies.X[idx] - agentInfo.Position.x, enemies.Y[idx] - agentInfo.Position.y,
+			enemies.VelocityX[idx] - agentInfo.LinearVelocity.x, enemies.VelocityY[idx] - agentInfo.LinearVelocity.y,
+			enemies.BodySize[idx] + agentDistance, horizon, avoidance);
+	}
+	return avoidance;
+}
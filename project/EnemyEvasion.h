@@ -0,0 +1,13 @@
+#pragma once
+#include "EnemyFrame.h"
+
+//Evading every enemy in view by where it's heading, 4 enemies at a time
+//for each enemy the time of closest approach to the agent is solved from their relative position and velocity,
+//the ones that come within biting distance before the horizon push the agent away from where that approach happens
+namespace EnemyEvasion
+{
+	//sum of the directions away from the closest approach of every enemy on a collision course within horizon seconds
+	//each weighs up to 1, the sooner and the closer the more, an enemy counts as colliding within its size plus the agent's plus clearance
+	//zero if nothing is on a collision course
+	Elite::Vector2 GetAvoidance(const EnemyFrame& enemies, const AgentInfo& agentInfo, float clearance, float horizon);
+}
@@ -0,0 +1,35 @@
+#include "stdafx.h"
+#include "EnemyFrame.h"
+
+void EnemyFrame::Reserve(size_t capacity)
+{
+	Infos.reserve(capacity);
+	X.reserve(capacity);
+	Y.reserve(capacity);
+	VelocityX.reserve(capacity);
+	VelocityY.reserve(capacity);
+	BodySize.reserve(capacity);
+	Health.reserve(capacity);
+}
+
+void EnemyFrame::Clear()
+{
+	Infos.clear();
+	X.clear();
+	Y.clear();
+	VelocityX.clear();
+	VelocityY.clear();
+	BodySize.clear();
+	Health.clear();
+}
+
+void EnemyFrame::Add(const EnemyInfo& enemyInfo)
+{
+	Infos.push_back(enemyInfo);
+	X.push_back(enemyInfo.Location.x);
+	Y.push_back(enemyInfo.Location.y);
+	VelocityX.push_back(enemyInfo.LinearVelocity.x);
+	VelocityY.push_back(enemyInfo.LinearVelocity.y);
+	BodySize.push_back(enemyInfo.Size);
+	Health.push_back(float(enemyInfo.Health));
+}
@@ -0,0 +1,22 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+
+//Every enemy in view this frame, fetched once with Enemy_GetInfo in UpdateDangers
+//the fields the evasion and the target selection read are kept as separate arrays so both go through them 4 enemies at a time
+//refilled every tick, it only allocates once more enemies are added than were reserved
+struct EnemyFrame
+{
+	std::vector<EnemyInfo> Infos;
+	std::vector<float> X;
+	std::vector<float> Y;
+	std::vector<float> VelocityX;
+	std::vector<float> VelocityY;
+	std::vector<float> BodySize; //EnemyInfo::Size
+	std::vector<float> Health;
+
+	size_t Size() const { return Infos.size(); }
+	bool IsEmpty() const { return Infos.empty(); }
+	void Reserve(size_t capacity);
+	void Clear();
+	void Add(const EnemyInfo& enemyInfo);
+};
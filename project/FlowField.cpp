@@ -0,0 +1,241 @@
+#include "stdafx.h"
+#include "FlowField.h"
+#include "LevelFile.h"
+#include "ELogger.h"
+#include <mutex>
+#include <map>
+
+namespace
+{
+	//the 8 neighbours counter clockwise starting east, opposite directions are 4 apart
+	const int g_NeighbourX[8]{ 1, 1, 0, -1, -1, -1, 0, 1 };
+	const int g_NeighbourY[8]{ 0, 1, 1, 1, 0, -1, -1, -1 };
+	const float g_Diagonal{ 0.70710678f };
+	const Elite::Vector2 g_Directions[8]
+	{
+		{ 1.f, 0.f }, { g_Diagonal, g_Diagonal }, { 0.f, 1.f }, { -g_Diagonal, g_Diagonal },
+		{ -1.f, 0.f }, { -g_Diagonal, -g_Diagonal }, { 0.f, -1.f }, { g_Diagonal, -g_Diagonal }
+	};
+
+	//octile distance in tenths of a cell, a step through a wall costs as much as walking 50 cells around it
+	const uint32_t g_StraightCost{ 10 };
+	const uint32_t g_DiagonalCost{ 14 };
+	const uint32_t g_WallCostFactor{ 50 };
+}
+
+bool FlowField::Build(const LevelFile& level, const Elite::Vector2& worldCenter, const std::vector<Elite::Vector2>& goals, float cellSize, float margin)
+{
+	Clear();
+	if (!level.IsOpen())
+	{
+		return false;
+	}
+
+	const Elite::Vector2 extent{ level.GetWorldSize() + Elite::Vector2{ 2.f * margin, 2.f * margin } };
+	m_CellSize = cellSize;
+	m_InvCellSize = 1.f / cellSize;
+	m_Width = int(ceilf(extent.x * m_InvCellSize));
+	m_Height = int(ceilf(extent.y * m_InvCellSize));
+	m_Origin = worldCenter - extent / 2.f;
+	m_Goals = goals;
+
+	m_IsBlocked.assign(size_t(m_Width) * m_Height, 0);
+	BuildBlockedCells(level);
+
+	m_Directions.resize(m_Goals.size() * m_IsBlocked.size());
+	std::vector<uint32_t> costs(m_IsBlocked.size());
+	for (int goalIdx{ 0 }; goalIdx < int(m_Goals.size()); ++goalIdx)
+	{
+		BuildGoal(goalIdx, costs);
+	}
+	return true;
+}
+
+void FlowField::Clear()
+{
+	m_Width = 0;
+	m_Height = 0;
+	m_Goals.clear();
+	m_Directions.clear();
+	m_IsBlocked.clear();
+}
+
+int FlowField::FindGoal(const Elite::Vector2& position) const
+{
+	const int cellIdx{ GetCellIdx(position) };
+	for (int goalIdx{ 0 }; cellIdx != -1 && goalIdx < int(m_Goals.size()); ++goalIdx)
+	{
+		if (GetCellIdx(m_Goals[goalIdx]) == cellIdx)
+		{
+			return goalIdx;
+		}
+	}
+	return -1;
+}
+
+bool FlowField::GetDirection(int goalIdx, const Elite::Vector2& position, Elite::Vector2& direction) const
+{
+	const int cellIdx{ GetCellIdx(position) };
+	if (cellIdx == -1)
+	{
+		return false;
+	}
+
+	const uint8_t neighbourIdx{ m_Directions[size_t(goalIdx) * m_Width * m_Height + cellIdx] };
+	if (neighbourIdx >= m_GoalCell)
+	{
+		return false;
+	}
+	direction = g_Directions[neighbourIdx];
+	return true;
+}
+
+float FlowField::GetWallDistance(const Elite::Vector2& position, const Elite::Vector2& direction, float maxDistance) const
+{
+	const float step{ 0.5f / m_InvCellSize };
+	for (float distance{ step }; distance < maxDistance; distance += step)
+	{
+		const int cellIdx{ GetCellIdx(position + direction * distance) };
+		if (cellIdx != -1 && m_IsBlocked[cellIdx])
+		{
+			return distance;
+		}
+	}
+	return maxDistance;
+}
+
+std::shared_ptr<const FlowField> FlowField::GetShared(const std::string& levelPath, const Elite::Vector2& worldCenter)
+{
+	static std::mutex s_Mutex;
+	//kept for the rest of the process, a tournament starts episodes on the same few levels over and over
+	static std::map<std::string, std::shared_ptr<const FlowField>> s_Fields;
+
+	//the same file can be used around a different center
+	const std::string key{ levelPath + '@' + std::to_string(worldCenter.x) + ',' + std::to_string(worldCenter.y) };
+	const std::lock_guard<std::mutex> lock{ s_Mutex };
+	const auto it{ s_Fields.find(key) };
+	if (it != s_Fields.end())
+	{
+		return it->second;
+	}
+
+	LevelFile level{};
+	if (!level.Open(levelPath))
+	{
+		ELITE_LOG_INFO("No flow field, level '%s' can't be opened", levelPath);
+		return nullptr;
+	}
+
+	//only GoToWorldCenterState follows a field, the houses are walked to over the navmesh
+	std::shared_ptr<FlowField> pField{ std::make_shared<FlowField>() };
+	pField->Build(level, worldCenter, { worldCenter });
+	s_Fields[key] = pField;
+	return pField;
+}
+
+int FlowField::GetCellIdx(const Elite::Vector2& position) const
+{
+	const int cellX{ int(floorf((position.x - m_Origin.x) * m_InvCellSize)) };
+	const int cellY{ int(floorf((position.y - m_Origin.y) * m_InvCellSize)) };
+	if (cellX < 0 || cellX >= m_Width || cellY < 0 || cellY >= m_Height)
+	{
+		return -1;
+	}
+	return cellY * m_Width + cellX;
+}
+
+void FlowField::BuildBlockedCells(const LevelFile& level)
+{
+	//the walls are axis aligned boxes, a cell is blocked if it overlaps the inside of one
+	for (unsigned int wallIdx{ 0 }; wallIdx < level.GetNrWalls(); ++wallIdx)
+	{
+		const LevelPolygon& wall{ level.GetWall(wallIdx) };
+		if (wall.NrVertices == 0)
+		{
+			continue;
+		}
+
+		Elite::Vector2 minCorner{ wall.GetVertex(0) };
+		Elite::Vector2 maxCorner{ minCorner };
+		for (unsigned int i{ 1 }; i < wall.NrVertices; ++i)
+		{
+			const Elite::Vector2 vertex{ wall.GetVertex(i) };
+			minCorner = Elite::Vector2{ (std::min)(minCorner.x, vertex.x), (std::min)(minCorner.y, vertex.y) };
+			maxCorner = Elite::Vector2{ (std::max)(maxCorner.x, vertex.x), (std::max)(maxCorner.y, vertex.y) };
+		}
+
+		const int minX{ (std::max)(0, int(floorf((minCorner.x - m_Origin.x) * m_InvCellSize))) };
+		const int minY{ (std::max)(0, int(floorf((minCorner.y - m_Origin.y) * m_InvCellSize))) };
+		const int maxX{ (std::min)(m_Width, int(ceilf((maxCorner.x - m_Origin.x) * m_InvCellSize))) };
+		const int maxY{ (std::min)(m_Height, int(ceilf((maxCorner.y - m_Origin.y) * m_InvCellSize))) };
+		for (int cellY{ minY }; cellY < maxY; ++cellY)
+		{
+			for (int cellX{ minX }; cellX < maxX; ++cellX)
+			{
+				m_IsBlocked[size_t(cellY) * m_Width + cellX] = 1;
+			}
+		}
+	}
+}
+
+void FlowField::BuildGoal(int goalIdx, std::vector<uint32_t>& costs)
+{
+	const std::vector<uint8_t>& isBlocked{ m_IsBlocked };
+	uint8_t* pDirections{ m_Directions.data() + size_t(goalIdx) * isBlocked.size() };
+	std::fill(pDirections, pDirections + isBlocked.size(), m_Unreachable);
+	std::fill(costs.begin(), costs.end(), UINT32_MAX);
+
+	const int goalCellIdx{ GetCellIdx(m_Goals[goalIdx]) };
+	if (goalCellIdx == -1)
+	{
+		ELITE_LOG_WARNING("Flow field goal (%f, %f) is outside the grid", m_Goals[goalIdx].x, m_Goals[goalIdx].y);
+		return;
+	}
+
+	//searched outwards from the goal, a cell's direction points back at the cell it was reached from
+	using QueueEntry = std::pair<uint32_t, int>;
+	std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> openCells{};
+	costs[goalCellIdx] = 0;
+	pDirections[goalCellIdx] = m_GoalCell;
+	openCells.push(QueueEntry{ 0, goalCellIdx });
+	while (!openCells.empty())
+	{
+		const QueueEntry entry{ openCells.top() };
+		openCells.pop();
+		const int cellIdx{ entry.second };
+		if (entry.first > costs[cellIdx])
+		{
+			continue;
+		}
+
+		const int cellX{ cellIdx % m_Width };
+		const int cellY{ cellIdx / m_Width };
+		for (int neighbourIdx{ 0 }; neighbourIdx < 8; ++neighbourIdx)
+		{
+			const int nextX{ cellX + g_NeighbourX[neighbourIdx] };
+			const int nextY{ cellY + g_NeighbourY[neighbourIdx] };
+			if (nextX < 0 || nextX >= m_Width || nextY < 0 || nextY >= m_Height)
+			{
+				continue;
+			}
+
+			const int nextIdx{ nextY * m_Width + nextX };
+			const bool isDiagonal{ (neighbourIdx & 1) != 0 };
+			const bool isThroughWall{ isBlocked[cellIdx] || isBlocked[nextIdx] };
+			//no cutting corners past a wall
+			if (isDiagonal && !isThroughWall && (isBlocked[cellY * m_Width + nextX] || isBlocked[nextY * m_Width + cellX]))
+			{
+				continue;
+			}
+
+			const uint32_t stepCost{ (isDiagonal ? g_DiagonalCost : g_StraightCost) * (isThroughWall ? g_WallCostFactor : 1) };
+			const uint32_t nextCost{ costs[cellIdx] + stepCost };
+			if (nextCost < costs[nextIdx])
+			{
+				costs[nextIdx] = nextCost;
+				pDirections[nextIdx] = uint8_t((neighbourIdx + 4) % 8);
+				openCells.push(QueueEntry{ nextCost, nextIdx });
+			}
+		}
+	}
+}
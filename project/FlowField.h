@@ -0,0 +1,51 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+
+class LevelFile;
+
+//Per goal, the direction to walk in from every cell of a grid over the level, so following it steers around the walls
+//built once when a level is loaded (a Dijkstra search from each goal), stored as one byte per cell per goal:
+//the index of the neighbouring cell to walk to next, out of the 8 around it
+//walls aren't left out of the search but made very expensive, so an agent pushed into a wall is still led out the shortest way
+class FlowField final
+{
+public:
+	//covers the world plus margin on every side, the agent can wander a bit past the world's border
+	bool Build(const LevelFile& level, const Elite::Vector2& worldCenter, const std::vector<Elite::Vector2>& goals, float cellSize = 2.f, float margin = 50.f);
+	void Clear();
+	bool IsEmpty() const { return m_Goals.empty(); }
+
+	int GetNrGoals() const { return int(m_Goals.size()); }
+	const Elite::Vector2& GetGoal(int goalIdx) const { return m_Goals[goalIdx]; }
+	//index of the goal in the same cell as position, -1 if there's none
+	int FindGoal(const Elite::Vector2& position) const;
+
+	//the unit direction to walk in from position towards the goal
+	//false outside the grid and in the goal's own cell, seek the goal directly there
+	bool GetDirection(int goalIdx, const Elite::Vector2& position, Elite::Vector2& direction) const;
+
+	//a feeler from position along direction (normalized), the distance to the first cell with a wall in it, maxDistance if there's none that close
+	//walks the grid in steps of half a cell, a wall thinner than that can be stepped over
+	float GetWallDistance(const Elite::Vector2& position, const Elite::Vector2& direction, float maxDistance) const;
+
+	//shares the fields of a level between every plugin instance in the process (tournament threads), built by the first one asking
+	//nullptr if the level can't be opened
+	static std::shared_ptr<const FlowField> GetShared(const std::string& levelPath, const Elite::Vector2& worldCenter);
+
+private:
+	static constexpr uint8_t m_GoalCell{ 8 };
+	static constexpr uint8_t m_Unreachable{ 9 };
+
+	int GetCellIdx(const Elite::Vector2& position) const;
+	void BuildBlockedCells(const LevelFile& level);
+	void BuildGoal(int goalIdx, std::vector<uint32_t>& costs);
+
+	Elite::Vector2 m_Origin{}; //lower left corner of the grid
+	float m_CellSize{ 1.f };
+	float m_InvCellSize{ 1.f };
+	int m_Width{ 0 };
+	int m_Height{ 0 };
+	std::vector<Elite::Vector2> m_Goals;
+	std::vector<uint8_t> m_Directions; //m_Width * m_Height per goal, row by row
+	std::vector<uint8_t> m_IsBlocked; //m_Width * m_Height, 1 where a wall overlaps the cell
+};
@@ -0,0 +1,59 @@
+#include "stdafx.h"
+#include "HouseRegistry.h"
+
+void HouseRegistry::RegisterVisit(const HouseInfo& house, float time)
+{
+	bool isAdded{};
+	HouseVisit& visit{ m_Visits.FindOrAdd(GetKey(house), isAdded) };
+	visit.LastVisitTime = time;
+	++visit.NrVisits;
+}
+
+void HouseRegistry::RegisterItemGrabbed(const HouseInfo& house, float time)
+{
+	bool isAdded{};
+	HouseVisit& visit{ m_Visits.FindOrAdd(GetKey(house), isAdded) };
+	visit.LastVisitTime = time;
+	++visit.NrItemsGrabbed;
+}
+
+bool HouseRegistry::IsWorthVisiting(const HouseInfo& house, float time) const
+{
+	const HouseVisit* pVisit{ Find(house) };
+	return !pVisit || pVisit->NrVisits == 0 || time - pVisit->LastVisitTime >= m_RevisitDelay;
+}
+
+int HouseRegistry::FindBestHouse(const std::vector<HouseInfo>& houses, const Elite::Vector2& position, float time, const HouseInfo& excludedHouse) const
+{
+	int bestIdx{ -1 };
+	float bestScore{ FLT_MAX };
+	float bestLastVisitTime{ FLT_MAX };
+	for (int i{ 0 }; i < int(houses.size()); ++i)
+	{
+		const HouseInfo& house{ houses[i] };
+		if (house.Center == excludedHouse.Center)
+		{
+			continue;
+		}
+
+		const HouseVisit* pVisit{ Find(house) };
+		const bool isVisited{ pVisit && pVisit->NrVisits > 0 };
+		if (isVisited && time - pVisit->LastVisitTime < m_RevisitDelay)
+		{
+			continue;
+		}
+
+		//never searched counts as searched infinitely long ago
+		const float lastVisitTime{ isVisited ? pVisit->LastVisitTime : -FLT_MAX };
+		//a house that never yielded an item counts as farther away, once more for every search that came up empty
+		const float barrenFactor{ isVisited && pVisit->NrItemsGrabbed == 0 ? float(1 + pVisit->NrVisits) : 1.f };
+		const float score{ Elite::DistanceSquared(house.Center, position) * barrenFactor * barrenFactor };
+		if (score < bestScore || (score == bestScore && lastVisitTime < bestLastVisitTime))
+		{
+			bestIdx = i;
+			bestScore = score;
+			bestLastVisitTime = lastVisitTime;
+		}
+	}
+	return bestIdx;
+}
@@ -0,0 +1,49 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+#include "EOpenHashMap.h"
+
+//What the agent knows about a house it has searched
+struct HouseVisit
+{
+	float LastVisitTime; //when the agent last walked in or grabbed an item there
+	int NrVisits; //times the agent walked in
+	int NrItemsGrabbed; //over all visits
+};
+
+//Every house the agent has searched, keyed by its center quantized to a quarter unit, so float noise in the reported center maps to the same house
+//picks which of the houses in view to go to next, in one pass over them
+class HouseRegistry final
+{
+public:
+	//after this, registering up to nrHouses houses doesn't allocate
+	void Reserve(size_t nrHouses) { m_Visits.Reserve(nrHouses); }
+	void Clear() { m_Visits.Clear(); }
+	size_t Size() const { return m_Visits.Size(); }
+
+	//seconds before a searched house is worth searching again, items respawn in random houses
+	void SetRevisitDelay(float delay) { m_RevisitDelay = delay; }
+	float GetRevisitDelay() const { return m_RevisitDelay; }
+
+	void RegisterVisit(const HouseInfo& house, float time);
+	//the house counts as searched until the item was grabbed
+	void RegisterItemGrabbed(const HouseInfo& house, float time);
+	//nullptr if the house was never searched
+	const HouseVisit* Find(const HouseInfo& house) const { return m_Visits.Find(GetKey(house)); }
+	bool IsWorthVisiting(const HouseInfo& house, float time) const;
+
+	//index of the house worth visiting closest to position, -1 if none is worth it
+	//a house searched without grabbing anything ranks as if it were 1 + NrVisits times as far, houses searched longer ago win ties
+	//excludedHouse is skipped as well, it's the house the agent is already heading for or just left
+	int FindBestHouse(const std::vector<HouseInfo>& houses, const Elite::Vector2& position, float time, const HouseInfo& excludedHouse) const;
+
+private:
+	static uint64_t GetKey(const HouseInfo& house)
+	{
+		const int32_t x{ int32_t(roundf(house.Center.x * 4.f)) };
+		const int32_t y{ int32_t(roundf(house.Center.y * 4.f)) };
+		return (uint64_t(uint32_t(x)) << 32) | uint32_t(y);
+	}
+
+	Elite::OpenHashMap<uint64_t, HouseVisit> m_Visits;
+	float m_RevisitDelay{ 120.f };
+};
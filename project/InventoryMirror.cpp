@@ -0,0 +1,140 @@
+#include "stdafx.h"
+#include "InventoryMirror.h"
+#include "IExamInterface.h"
+#include "ELogger.h"
+
+bool InventoryMirror::Sync(IExamInterface* pInterface)
+{
+	m_TimeSinceSync = 0.f;
+	const UINT capacity{ (std::min)(pInterface->Inventory_GetCapacity(), MaxCapacity) };
+	bool isSame{ capacity == m_Capacity };
+	m_Capacity = capacity;
+	for (UINT slotId{ 0 }; slotId < MaxCapacity; ++slotId)
+	{
+		ItemInfo item{};
+		if (slotId >= capacity || !pInterface->Inventory_GetItem(slotId, item))
+		{
+			isSame = isSame && !IsUsed(slotId);
+			ClearSlot(slotId);
+			continue;
+		}
+
+		const int value{ GetItemValue(pInterface, item) };
+		isSame = isSame && IsUsed(slotId) && m_Slots[slotId].Item.ItemHash == item.ItemHash
+			&& m_Slots[slotId].Item.Type == item.Type && m_Slots[slotId].Value == value;
+		ClearSlot(slotId);
+		SetSlot(slotId, item, value);
+	}
+	UpdateWeaponSlot();
+	return isSame;
+}
+
+void InventoryMirror::Update(IExamInterface* pInterface, float dt)
+{
+	m_TimeSinceSync += dt;
+	if (m_TimeSinceSync < m_SyncInterval)
+	{
+		return;
+	}
+	if (!Sync(pInterface))
+	{
+		ELITE_LOG_WARNING("Inventory mirror was out of date with the host, change the inventory through the mirror");
+	}
+}
+
+bool InventoryMirror::AddItem(IExamInterface* pInterface, UINT slotId, const ItemInfo& item, int value)
+{
+	if (!pInterface->Inventory_AddItem(slotId, item))
+	{
+		return false;
+	}
+	SetSlot(slotId, item, value);
+	//a new gun is the one to use next
+	if (item.Type == eItemType::PISTOL)
+	{
+		m_WeaponSlot = int(slotId);
+	}
+	return true;
+}
+
+bool InventoryMirror::UseItem(IExamInterface* pInterface, UINT slotId)
+{
+	if (!pInterface->Inventory_UseItem(slotId))
+	{
+		return false;
+	}
+	//a shot costs one bullet, a medkit or food is used up all at once
+	int& value{ m_Slots[slotId].Value };
+	value = m_Slots[slotId].Item.Type == eItemType::PISTOL ? value - 1 : 0;
+	return true;
+}
+
+bool InventoryMirror::RemoveItem(IExamInterface* pInterface, UINT slotId)
+{
+	if (!pInterface->Inventory_RemoveItem(slotId))
+	{
+		return false;
+	}
+	ClearSlot(slotId);
+	UpdateWeaponSlot();
+	return true;
+}
+
+int InventoryMirror::GetItemValue(IExamInterface* pInterface, ItemInfo& item)
+{
+	switch (item.Type)
+	{
+	case eItemType::PISTOL:
+		return pInterface->Weapon_GetAmmo(item);
+	case eItemType::MEDKIT:
+		return pInterface->Medkit_GetHealth(item);
+	case eItemType::FOOD:
+		return pInterface->Food_GetEnergy(item);
+	default:
+		return 0;
+	}
+}
+
+int InventoryMirror::GetFirstSlot(uint32_t slots)
+{
+	for (int slotId{ 0 }; slots != 0; ++slotId, slots >>= 1)
+	{
+		if (slots & 1u)
+		{
+			return slotId;
+		}
+	}
+	return -1;
+}
+
+void InventoryMirror::SetSlot(UINT slotId, const ItemInfo& item, int value)
+{
+	m_Slots[slotId] = Slot{ item, value };
+	const uint32_t slotBit{ 1u << slotId };
+	m_UsedSlots |= slotBit;
+	if (item.Type <= eItemType::_LAST)
+	{
+		m_TypeSlots[int(item.Type)] |= slotBit;
+	}
+}
+
+void InventoryMirror::ClearSlot(UINT slotId)
+{
+	const uint32_t slotBit{ 1u << slotId };
+	m_UsedSlots &= ~slotBit;
+	for (uint32_t& typeSlots : m_TypeSlots)
+	{
+		typeSlots &= ~slotBit;
+	}
+	m_Slots[slotId] = Slot{};
+}
+
+void InventoryMirror::UpdateWeaponSlot()
+{
+	//only runs when a slot is emptied or synced, asking for the weapon stays a lookup
+	const uint32_t pistols{ GetSlots(eItemType::PISTOL) };
+	if (m_WeaponSlot == -1 || !((pistols >> m_WeaponSlot) & 1u))
+	{
+		m_WeaponSlot = GetFirstSlot(pistols);
+	}
+}
@@ -0,0 +1,65 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+
+class IExamInterface;
+
+//Our own copy of the inventory, every slot with its item and what the item is worth (ammo, health or energy)
+//only the plugin changes the inventory, so the mirror follows along with the adds, uses and removes that go through it
+//and never has to ask the host, Update compares it against the host every so often in case something else did change it
+//per item type the slots holding one are a bitmask, the weapon to use is kept up to date on every change
+class InventoryMirror final
+{
+public:
+	//reads every slot from the host, the mirror takes the host's word for everything
+	//returns false if the host's inventory differed from the mirror
+	bool Sync(IExamInterface* pInterface);
+	//syncs once every m_SyncInterval seconds
+	void Update(IExamInterface* pInterface, float dt);
+
+	//these go to the host and only change the mirror if the host did it
+	//value is what Weapon_GetAmmo, Medkit_GetHealth or Food_GetEnergy says the item is worth
+	bool AddItem(IExamInterface* pInterface, UINT slotId, const ItemInfo& item, int value);
+	bool UseItem(IExamInterface* pInterface, UINT slotId);
+	bool RemoveItem(IExamInterface* pInterface, UINT slotId);
+
+	//asks the host what an item that isn't in the inventory yet is worth, 0 for garbage
+	static int GetItemValue(IExamInterface* pInterface, ItemInfo& item);
+
+	UINT GetCapacity() const { return m_Capacity; }
+	bool IsUsed(UINT slotId) const { return (m_UsedSlots >> slotId) & 1u; }
+	const ItemInfo& GetItem(UINT slotId) const { return m_Slots[slotId].Item; }
+	int GetValue(UINT slotId) const { return m_Slots[slotId].Value; }
+
+	//bit i is set if slot i holds an item of that type
+	uint32_t GetSlots(eItemType type) const { return m_TypeSlots[int(type)]; }
+	uint32_t GetFreeSlots() const { return ~m_UsedSlots & GetCapacityMask(); }
+	//lowest slot of the mask, -1 if it's empty
+	static int GetFirstSlot(uint32_t slots);
+
+	//the pistol grabbed last, or the first one left once that's thrown away, -1 if there is none
+	//it can be out of ammo until KillZombieState throws it away
+	int GetWeaponSlot() const { return m_WeaponSlot; }
+
+	static constexpr UINT MaxCapacity{ 32 };
+
+private:
+	struct Slot
+	{
+		ItemInfo Item;
+		int Value;
+	};
+
+	void SetSlot(UINT slotId, const ItemInfo& item, int value);
+	void ClearSlot(UINT slotId);
+	void UpdateWeaponSlot();
+	uint32_t GetCapacityMask() const { return m_Capacity == MaxCapacity ? ~0u : (1u << m_Capacity) - 1u; }
+
+	Slot m_Slots[MaxCapacity]{};
+	UINT m_Capacity{ 0 };
+	uint32_t m_UsedSlots{ 0 };
+	uint32_t m_TypeSlots[int(eItemType::_LAST) + 1]{};
+	int m_WeaponSlot{ -1 };
+
+	static constexpr float m_SyncInterval{ 2.f };
+	float m_TimeSinceSync{ 0.f };
+};
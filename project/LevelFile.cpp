@@ -0,0 +1,127 @@
+#include "stdafx.h"
+#include "LevelFile.h"
+#include "ELogger.h"
+
+LevelFile::~LevelFile()
+{
+	Close();
+}
+
+bool LevelFile::Open(const std::string& path)
+{
+	Close();
+	if (!m_File.Map(path))
+	{
+		return false;
+	}
+	m_pData = m_File.GetData();
+	m_Size = m_File.GetSize();
+
+	if (!Parse())
+	{
+		ELITE_LOG_WARNING("Level file '%s' is not a valid level", path);
+		Close();
+		return false;
+	}
+	return true;
+}
+
+void LevelFile::Close()
+{
+	m_HouseOffsets.clear();
+	m_Walls.clear();
+	m_Outlines.clear();
+	m_File.Unmap();
+	m_pData = nullptr;
+	m_Size = 0;
+}
+
+Elite::Vector2 LevelFile::GetWorldSize() const
+{
+	const float* pWorldSize{ reinterpret_cast<const float*>(m_pData) };
+	return Elite::Vector2{ pWorldSize[0], pWorldSize[1] };
+}
+
+const float* LevelFile::GetHouseData(unsigned int houseIdx) const
+{
+	return reinterpret_cast<const float*>(m_pData + m_HouseOffsets[houseIdx]);
+}
+
+HouseInfo LevelFile::GetHouse(unsigned int houseIdx) const
+{
+	const float* pHouse{ GetHouseData(houseIdx) };
+	HouseInfo house{};
+	house.Center = Elite::Vector2{ pHouse[0], pHouse[1] };
+	house.Size = Elite::Vector2{ pHouse[2], pHouse[3] };
+	return house;
+}
+
+bool LevelFile::Parse()
+{
+	size_t offset{ 2 * sizeof(float) };
+	unsigned int nrHouses{};
+	if (!ReadUInt(offset, nrHouses))
+	{
+		return false;
+	}
+
+	m_HouseOffsets.reserve(nrHouses);
+	for (unsigned int i{ 0 }; i < nrHouses; ++i)
+	{
+		const size_t houseSize{ 4 * sizeof(float) };
+		if (offset + houseSize > m_Size)
+		{
+			return false;
+		}
+		m_HouseOffsets.push_back(offset);
+		offset += houseSize;
+
+		if (!ParsePolygons(offset, i, m_Walls) || !ParsePolygons(offset, i, m_Outlines))
+		{
+			return false;
+		}
+	}
+
+	return offset == m_Size;
+}
+
+bool LevelFile::ParsePolygons(size_t& offset, unsigned int houseIdx, std::vector<LevelPolygon>& polygons) const
+{
+	unsigned int nrPolygons{};
+	if (!ReadUInt(offset, nrPolygons))
+	{
+		return false;
+	}
+
+	for (unsigned int i{ 0 }; i < nrPolygons; ++i)
+	{
+		LevelPolygon polygon{};
+		if (!ReadUInt(offset, polygon.NrVertices))
+		{
+			return false;
+		}
+
+		const size_t verticesSize{ size_t(polygon.NrVertices) * 2 * sizeof(float) };
+		if (offset + verticesSize > m_Size)
+		{
+			return false;
+		}
+		polygon.pVertices = reinterpret_cast<const float*>(m_pData + offset);
+		polygon.HouseIdx = houseIdx;
+		offset += verticesSize;
+		polygons.push_back(polygon);
+	}
+	return true;
+}
+
+bool LevelFile::ReadUInt(size_t& offset, unsigned int& value) const
+{
+	if (offset + sizeof(unsigned int) > m_Size)
+	{
+		return false;
+	}
+
+	value = *reinterpret_cast<const unsigned int*>(m_pData + offset);
+	offset += sizeof(unsigned int);
+	return true;
+}
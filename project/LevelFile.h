@@ -0,0 +1,64 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+#include "MappedFile.h"
+
+//Polygon stored in a level file, vertices are x,y float pairs that point straight into the mapped file
+struct LevelPolygon
+{
+	const float* pVertices = nullptr;
+	unsigned int NrVertices = 0;
+	unsigned int HouseIdx = 0;
+
+	Elite::Vector2 GetVertex(unsigned int idx) const { return Elite::Vector2{ pVertices[2 * idx], pVertices[2 * idx + 1] }; }
+};
+
+//Read-only, zero-copy view over a memory mapped .gppl level file
+//layout (little endian, 4 byte fields):
+//	float worldWidth, float worldHeight, uint houseCount
+//	per house: float centerX, centerY, sizeX, sizeY
+//	           uint wallCount, per wall: uint vertexCount, vertexCount * (float x, float y)
+//	           uint outlineCount, per outline: uint vertexCount, vertexCount * (float x, float y)
+//the walls are the separate wall boxes of a house, the outlines are those walls merged into one polygon per connected piece
+class LevelFile final
+{
+public:
+	LevelFile() = default;
+	~LevelFile();
+
+	//returns false if the file can't be mapped or isn't a valid level, the previous level is closed either way
+	bool Open(const std::string& path);
+	void Close();
+	bool IsOpen() const { return m_pData != nullptr; }
+
+	Elite::Vector2 GetWorldSize() const;
+
+	unsigned int GetNrHouses() const { return static_cast<unsigned int>(m_HouseOffsets.size()); }
+	//center x, center y, size x, size y
+	const float* GetHouseData(unsigned int houseIdx) const;
+	HouseInfo GetHouse(unsigned int houseIdx) const;
+
+	unsigned int GetNrWalls() const { return static_cast<unsigned int>(m_Walls.size()); }
+	const LevelPolygon& GetWall(unsigned int wallIdx) const { return m_Walls[wallIdx]; }
+
+	unsigned int GetNrOutlines() const { return static_cast<unsigned int>(m_Outlines.size()); }
+	const LevelPolygon& GetOutline(unsigned int outlineIdx) const { return m_Outlines[outlineIdx]; }
+
+	LevelFile(const LevelFile& other) = delete;
+	LevelFile& operator=(const LevelFile& rhs) = delete;
+	LevelFile(LevelFile&& other) = delete;
+	LevelFile& operator=(LevelFile&& rhs) = delete;
+private:
+	bool Parse();
+	bool ParsePolygons(size_t& offset, unsigned int houseIdx, std::vector<LevelPolygon>& polygons) const;
+	bool ReadUInt(size_t& offset, unsigned int& value) const;
+
+	MappedFile m_File;
+	//m_File's data, kept next to the offsets the parsing walks
+	const unsigned char* m_pData = nullptr;
+	size_t m_Size = 0;
+
+	//only offsets and pointers into the mapping, no level data is copied
+	std::vector<size_t> m_HouseOffsets;
+	std::vector<LevelPolygon> m_Walls;
+	std::vector<LevelPolygon> m_Outlines;
+};
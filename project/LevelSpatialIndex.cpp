@@ -0,0 +1,194 @@
+#include "stdafx.h"
+#include "LevelSpatialIndex.h"
+#include "LevelFile.h"
+
+namespace
+{
+	b2AABB GetPolygonBox(const LevelPolygon& polygon)
+	{
+		b2AABB box{};
+		box.lowerBound = b2Vec2{ FLT_MAX, FLT_MAX };
+		box.upperBound = b2Vec2{ -FLT_MAX, -FLT_MAX };
+		for (unsigned int i{ 0 }; i < polygon.NrVertices; ++i)
+		{
+			const b2Vec2 vertex{ polygon.pVertices[2 * i], polygon.pVertices[2 * i + 1] };
+			box.lowerBound = b2Min(box.lowerBound, vertex);
+			box.upperBound = b2Max(box.upperBound, vertex);
+		}
+		return box;
+	}
+
+	//fraction along p1->p2 where it crosses the segment q1->q2
+	bool IntersectSegments(const Elite::Vector2& p1, const Elite::Vector2& p2, const Elite::Vector2& q1, const Elite::Vector2& q2, float& fraction)
+	{
+		const Elite::Vector2 r{ p2 - p1 };
+		const Elite::Vector2 s{ q2 - q1 };
+		const float denominator{ Elite::Cross(r, s) };
+		if (Elite::AreEqual(denominator, 0.f))
+		{
+			//parallel, grazing a wall along its side doesn't count as a hit
+			return false;
+		}
+
+		const Elite::Vector2 qp{ q1 - p1 };
+		const float t{ Elite::Cross(qp, s) / denominator };
+		const float u{ Elite::Cross(qp, r) / denominator };
+		if (t < 0.f || t > 1.f || u < 0.f || u > 1.f)
+		{
+			return false;
+		}
+
+		fraction = t;
+		return true;
+	}
+}
+
+#pragma region StaticAABBTree
+void StaticAABBTree::Build(const std::vector<b2AABB>& boxes)
+{
+	Clear();
+	if (boxes.empty())
+	{
+		return;
+	}
+
+	const int nrItems{ int(boxes.size()) };
+	m_Items.resize(nrItems);
+	std::vector<b2Vec2> centers(nrItems);
+	for (int i{ 0 }; i < nrItems; ++i)
+	{
+		m_Items[i] = i;
+		centers[i] = boxes[i].GetCenter();
+	}
+
+	//a balanced binary tree never has more than 2n - 1 nodes
+	m_Nodes.reserve(2 * nrItems);
+	BuildNode(0, nrItems, boxes, centers);
+
+	m_ItemBoxes.reserve(nrItems);
+	for (int itemIdx : m_Items)
+	{
+		m_ItemBoxes.push_back(boxes[itemIdx]);
+	}
+}
+
+void StaticAABBTree::Clear()
+{
+	m_Nodes.clear();
+	m_Items.clear();
+	m_ItemBoxes.clear();
+}
+
+int StaticAABBTree::BuildNode(int firstItem, int nrItems, const std::vector<b2AABB>& boxes, std::vector<b2Vec2>& centers)
+{
+	const int nodeIdx{ int(m_Nodes.size()) };
+	m_Nodes.push_back(Node{});
+
+	b2AABB box{ boxes[m_Items[firstItem]] };
+	b2AABB centerBox{};
+	centerBox.lowerBound = centers[m_Items[firstItem]];
+	centerBox.upperBound = centerBox.lowerBound;
+	for (int i{ firstItem + 1 }; i < firstItem + nrItems; ++i)
+	{
+		box.Combine(boxes[m_Items[i]]);
+		centerBox.lowerBound = b2Min(centerBox.lowerBound, centers[m_Items[i]]);
+		centerBox.upperBound = b2Max(centerBox.upperBound, centers[m_Items[i]]);
+	}
+	m_Nodes[nodeIdx].Box = box;
+
+	if (nrItems <= m_MaxLeafItems)
+	{
+		m_Nodes[nodeIdx].FirstItem = firstItem;
+		m_Nodes[nodeIdx].NrItems = nrItems;
+		return nodeIdx;
+	}
+
+	//median split along the axis where the centers are spread out the most
+	const b2Vec2 extents{ centerBox.upperBound - centerBox.lowerBound };
+	const bool splitX{ extents.x >= extents.y };
+	const int nrLeft{ nrItems / 2 };
+	std::nth_element(m_Items.begin() + firstItem, m_Items.begin() + firstItem + nrLeft, m_Items.begin() + firstItem + nrItems,
+		[&centers, splitX](int a, int b) { return splitX ? centers[a].x < centers[b].x : centers[a].y < centers[b].y; });
+
+	BuildNode(firstItem, nrLeft, boxes, centers);
+	const int rightChild{ BuildNode(firstItem + nrLeft, nrItems - nrLeft, boxes, centers) };
+	m_Nodes[nodeIdx].NrItems = 0;
+	m_Nodes[nodeIdx].RightChild = rightChild;
+	return nodeIdx;
+}
+#pragma endregion
+
+#pragma region LevelSpatialIndex
+void LevelSpatialIndex::Build(const LevelFile& level)
+{
+	m_pLevel = &level;
+
+	m_HouseBoxes.clear();
+	m_HouseBoxes.reserve(level.GetNrHouses());
+	for (unsigned int i{ 0 }; i < level.GetNrHouses(); ++i)
+	{
+		const HouseInfo house{ level.GetHouse(i) };
+		b2AABB box{};
+		box.lowerBound = b2Vec2{ house.Center.x - house.Size.x / 2.f, house.Center.y - house.Size.y / 2.f };
+		box.upperBound = b2Vec2{ house.Center.x + house.Size.x / 2.f, house.Center.y + house.Size.y / 2.f };
+		m_HouseBoxes.push_back(box);
+	}
+	m_HouseTree.Build(m_HouseBoxes);
+
+	std::vector<b2AABB> wallBoxes{};
+	wallBoxes.reserve(level.GetNrWalls());
+	for (unsigned int i{ 0 }; i < level.GetNrWalls(); ++i)
+	{
+		wallBoxes.push_back(GetPolygonBox(level.GetWall(i)));
+	}
+	m_WallTree.Build(wallBoxes);
+}
+
+int LevelSpatialIndex::FindHouseAt(const Elite::Vector2& point) const
+{
+	//the tree boxes are the houses themselves, so overlapping the point means being inside
+	int houseIdx{ -1 };
+	m_HouseTree.QueryPoint(point, [&houseIdx](int itemIdx)
+	{
+		houseIdx = itemIdx;
+		return false;
+	});
+	return houseIdx;
+}
+
+bool LevelSpatialIndex::RayCastWalls(const Elite::Vector2& p1, const Elite::Vector2& p2, float& fraction) const
+{
+	if (!m_pLevel)
+	{
+		return false;
+	}
+
+	b2AABB rayBox{};
+	rayBox.lowerBound = b2Min(b2Vec2{ p1.x, p1.y }, b2Vec2{ p2.x, p2.y });
+	rayBox.upperBound = b2Max(b2Vec2{ p1.x, p1.y }, b2Vec2{ p2.x, p2.y });
+
+	bool isHit{ false };
+	fraction = 1.f;
+	m_WallTree.Query(rayBox, [this, &p1, &p2, &isHit, &fraction](int wallIdx)
+	{
+		const LevelPolygon& wall{ m_pLevel->GetWall(wallIdx) };
+		for (unsigned int i{ 0 }; i < wall.NrVertices; ++i)
+		{
+			float edgeFraction{};
+			if (IntersectSegments(p1, p2, wall.GetVertex(i), wall.GetVertex((i + 1) % wall.NrVertices), edgeFraction) && edgeFraction <= fraction)
+			{
+				fraction = edgeFraction;
+				isHit = true;
+			}
+		}
+		return true;
+	});
+	return isHit;
+}
+
+bool LevelSpatialIndex::RayCastWalls(const Elite::Vector2& p1, const Elite::Vector2& p2) const
+{
+	float fraction{};
+	return RayCastWalls(p1, p2, fraction);
+}
+#pragma endregion
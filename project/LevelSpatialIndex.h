@@ -0,0 +1,111 @@
+#pragma once
+#include <Box2D/Collision/b2Collision.h>
+
+class LevelFile;
+
+//Bounding volume tree over a fixed set of boxes, built once in bulk
+//nodes are stored depth first in one array: the left child of a node directly follows it, so a query walks memory mostly forward
+class StaticAABBTree final
+{
+public:
+	void Build(const std::vector<b2AABB>& boxes);
+	void Clear();
+	bool IsEmpty() const { return m_Nodes.empty(); }
+
+	//calls visitor(itemIdx) for every item whose box overlaps the query box, stops early when the visitor returns false
+	template<typename Visitor>
+	void Query(const b2AABB& box, Visitor visitor) const;
+	//calls visitor(itemIdx) for every item whose box contains the point, stops early when the visitor returns false
+	template<typename Visitor>
+	void QueryPoint(const Elite::Vector2& point, Visitor visitor) const;
+
+private:
+	struct Node
+	{
+		b2AABB Box;
+		int FirstItem; //leaf only, index into m_Items
+		int NrItems; //0 for inner nodes
+		int RightChild; //inner only, the left child is the next node
+	};
+
+	int BuildNode(int firstItem, int nrItems, const std::vector<b2AABB>& boxes, std::vector<b2Vec2>& centers);
+
+	static const int m_MaxLeafItems{ 2 };
+	static const int m_MaxDepth{ 64 };
+	std::vector<Node> m_Nodes;
+	std::vector<int> m_Items;
+	std::vector<b2AABB> m_ItemBoxes; //same order as m_Items, so a leaf's boxes are contiguous
+};
+
+//Point-in-house and ray-vs-wall queries over a level
+class LevelSpatialIndex final
+{
+public:
+	void Build(const LevelFile& level);
+	bool IsEmpty() const { return m_pLevel == nullptr; }
+
+	//index of the house containing the point, -1 if none
+	int FindHouseAt(const Elite::Vector2& point) const;
+	//calls visitor(houseIdx) for every house overlapping the box
+	template<typename Visitor>
+	void QueryHouses(const b2AABB& box, Visitor visitor) const { m_HouseTree.Query(box, visitor); }
+
+	//true if the segment from p1 to p2 crosses a wall, fraction is the closest hit along the segment
+	bool RayCastWalls(const Elite::Vector2& p1, const Elite::Vector2& p2, float& fraction) const;
+	bool RayCastWalls(const Elite::Vector2& p1, const Elite::Vector2& p2) const;
+
+private:
+	const LevelFile* m_pLevel = nullptr;
+	StaticAABBTree m_HouseTree;
+	StaticAABBTree m_WallTree;
+	std::vector<b2AABB> m_HouseBoxes;
+};
+
+#pragma region StaticAABBTree Templates
+template<typename Visitor>
+void StaticAABBTree::Query(const b2AABB& box, Visitor visitor) const
+{
+	if (m_Nodes.empty())
+	{
+		return;
+	}
+
+	int stack[m_MaxDepth];
+	int stackSize{ 0 };
+	stack[stackSize++] = 0;
+	while (stackSize > 0)
+	{
+		const int nodeIdx{ stack[--stackSize] };
+		const Node& node{ m_Nodes[nodeIdx] };
+		if (!b2TestOverlap(node.Box, box))
+		{
+			continue;
+		}
+
+		if (node.NrItems > 0)
+		{
+			for (int i{ node.FirstItem }; i < node.FirstItem + node.NrItems; ++i)
+			{
+				if (b2TestOverlap(m_ItemBoxes[i], box) && !visitor(m_Items[i]))
+				{
+					return;
+				}
+			}
+			continue;
+		}
+
+		//push the right child first so the left one, right after this node in memory, is visited first
+		stack[stackSize++] = node.RightChild;
+		stack[stackSize++] = nodeIdx + 1;
+	}
+}
+
+template<typename Visitor>
+void StaticAABBTree::QueryPoint(const Elite::Vector2& point, Visitor visitor) const
+{
+	b2AABB box{};
+	box.lowerBound = b2Vec2{ point.x, point.y };
+	box.upperBound = box.lowerBound;
+	Query(box, visitor);
+}
+#pragma endregion
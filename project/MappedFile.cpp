@@ -0,0 +1,108 @@
+#include "stdafx.h"
+#include "MappedFile.h"
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+MappedFile::~MappedFile()
+{
+	Unmap();
+}
+
+#ifdef _WIN32
+bool MappedFile::Map(const std::string& path)
+{
+	Unmap();
+	HANDLE hFile{ CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr) };
+	if (hFile == INVALID_HANDLE_VALUE)
+	{
+		return false;
+	}
+
+	LARGE_INTEGER fileSize{};
+	HANDLE hMapping{ nullptr };
+	if (GetFileSizeEx(hFile, &fileSize) && fileSize.QuadPart > 0)
+	{
+		hMapping = CreateFileMappingA(hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	}
+	if (!hMapping)
+	{
+		CloseHandle(hFile);
+		return false;
+	}
+
+	m_pData = static_cast<const unsigned char*>(MapViewOfFile(hMapping, FILE_MAP_READ, 0, 0, 0));
+	if (!m_pData)
+	{
+		CloseHandle(hMapping);
+		CloseHandle(hFile);
+		return false;
+	}
+
+	m_Size = size_t(fileSize.QuadPart);
+	m_hFile = hFile;
+	m_hMapping = hMapping;
+	return true;
+}
+
+void MappedFile::Unmap()
+{
+	if (m_pData)
+	{
+		UnmapViewOfFile(m_pData);
+		CloseHandle(m_hMapping);
+		CloseHandle(m_hFile);
+	}
+	m_pData = nullptr;
+	m_Size = 0;
+	m_hFile = nullptr;
+	m_hMapping = nullptr;
+}
+#else
+bool MappedFile::Map(const std::string& path)
+{
+	Unmap();
+	const int fd{ open(path.c_str(), O_RDONLY) };
+	if (fd < 0)
+	{
+		return false;
+	}
+
+	struct stat fileStat{};
+	void* pMapping{ MAP_FAILED };
+	if (fstat(fd, &fileStat) == 0 && fileStat.st_size > 0)
+	{
+		pMapping = mmap(nullptr, size_t(fileStat.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+	}
+	//the mapping stays valid after closing the descriptor
+	close(fd);
+
+	if (pMapping == MAP_FAILED)
+	{
+		return false;
+	}
+
+	m_pData = static_cast<const unsigned char*>(pMapping);
+	m_Size = size_t(fileStat.st_size);
+	return true;
+}
+
+void MappedFile::Unmap()
+{
+	if (m_pData)
+	{
+		munmap(const_cast<unsigned char*>(m_pData), m_Size);
+	}
+	m_pData = nullptr;
+	m_Size = 0;
+}
+#endif
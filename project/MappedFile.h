@@ -0,0 +1,29 @@
+#pragma once
+
+//Read-only memory mapping of a whole file, the data stays valid until Unmap or destruction
+class MappedFile final
+{
+public:
+	MappedFile() = default;
+	~MappedFile();
+
+	//returns false if the file doesn't exist, is empty or can't be mapped, the previous mapping is closed either way
+	bool Map(const std::string& path);
+	void Unmap();
+	bool IsMapped() const { return m_pData != nullptr; }
+
+	const unsigned char* GetData() const { return m_pData; }
+	size_t GetSize() const { return m_Size; }
+
+	MappedFile(const MappedFile& other) = delete;
+	MappedFile& operator=(const MappedFile& rhs) = delete;
+	MappedFile(MappedFile&& other) = delete;
+	MappedFile& operator=(MappedFile&& rhs) = delete;
+private:
+	const unsigned char* m_pData = nullptr;
+	size_t m_Size = 0;
+#ifdef _WIN32
+	void* m_hFile = nullptr;
+	void* m_hMapping = nullptr;
+#endif
+};
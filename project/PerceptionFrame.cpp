@@ -0,0 +1,79 @@
+#include "stdafx.h"
+#include "PerceptionFrame.h"
+#include "IExamInterface.h"
+#include "EProfiler.h"
+
+#pragma region EntityPartition
+void EntityPartition::Reserve(size_t capacity)
+{
+	X.reserve(capacity);
+	Y.reserve(capacity);
+	Hash.reserve(capacity);
+}
+
+void EntityPartition::Clear()
+{
+	X.clear();
+	Y.clear();
+	Hash.clear();
+}
+
+void EntityPartition::Add(const EntityInfo& entityInfo)
+{
+	X.push_back(entityInfo.Location.x);
+	Y.push_back(entityInfo.Location.y);
+	Hash.push_back(entityInfo.EntityHash);
+}
+
+EntityInfo EntityPartition::GetEntity(size_t idx, eEntityType type) const
+{
+	EntityInfo entityInfo{};
+	entityInfo.Type = type;
+	entityInfo.Location = GetLocation(idx);
+	entityInfo.EntityHash = Hash[idx];
+	return entityInfo;
+}
+#pragma endregion
+
+#pragma region PerceptionFrame
+void PerceptionFrame::Reserve(size_t maxHouses, size_t maxEntitiesPerType)
+{
+	m_Houses.reserve(maxHouses);
+	m_Enemies.Reserve(maxEntitiesPerType);
+	m_Items.Reserve(maxEntitiesPerType);
+	m_PurgeZones.Reserve(maxEntitiesPerType);
+}
+
+void PerceptionFrame::Refresh(IExamInterface* pInterface)
+{
+	ELITE_PROFILE_SCOPE("PerceptionFrame::Refresh");
+	m_Houses.clear();
+	HouseInfo houseInfo{};
+	for (int i{ 0 }; pInterface->Fov_GetHouseByIndex(i, houseInfo); ++i)
+	{
+		m_Houses.push_back(houseInfo);
+	}
+
+	m_Enemies.Clear();
+	m_Items.Clear();
+	m_PurgeZones.Clear();
+	EntityInfo entityInfo{};
+	for (int i{ 0 }; pInterface->Fov_GetEntityByIndex(i, entityInfo); ++i)
+	{
+		switch (entityInfo.Type)
+		{
+		case eEntityType::ENEMY:
+			m_Enemies.Add(entityInfo);
+			break;
+		case eEntityType::ITEM:
+			m_Items.Add(entityInfo);
+			break;
+		case eEntityType::PURGEZONE:
+			m_PurgeZones.Add(entityInfo);
+			break;
+		default:
+			break;
+		}
+	}
+}
+#pragma endregion
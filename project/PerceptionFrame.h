@@ -0,0 +1,42 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+
+class IExamInterface;
+
+//Entities of one type seen this frame, stored as separate arrays so a scan only touches the fields it needs
+struct EntityPartition
+{
+	std::vector<float> X;
+	std::vector<float> Y;
+	std::vector<int> Hash;
+
+	size_t Size() const { return Hash.size(); }
+	bool IsEmpty() const { return Hash.empty(); }
+	void Reserve(size_t capacity);
+	void Clear();
+	void Add(const EntityInfo& entityInfo);
+
+	Elite::Vector2 GetLocation(size_t idx) const { return Elite::Vector2{ X[idx], Y[idx] }; }
+	//rebuilds the EntityInfo the interface expects (Enemy_GetInfo, Item_Grab, ...)
+	EntityInfo GetEntity(size_t idx, eEntityType type) const;
+};
+
+//Everything the agent sees this frame, refilled in place every UpdateSteering so its capacity is kept across frames
+//entities are partitioned by type, in the order the interface reports them
+class PerceptionFrame final
+{
+public:
+	void Reserve(size_t maxHouses, size_t maxEntitiesPerType);
+	void Refresh(IExamInterface* pInterface);
+
+	const std::vector<HouseInfo>& GetHouses() const { return m_Houses; }
+	const EntityPartition& GetEnemies() const { return m_Enemies; }
+	const EntityPartition& GetItems() const { return m_Items; }
+	const EntityPartition& GetPurgeZones() const { return m_PurgeZones; }
+
+private:
+	std::vector<HouseInfo> m_Houses;
+	EntityPartition m_Enemies;
+	EntityPartition m_Items;
+	EntityPartition m_PurgeZones;
+};
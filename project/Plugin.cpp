@@ -3,9 +3,20 @@
 #include "IExamInterface.h"
 #include "SteeringBehaviors.h"
 #include "EFiniteStateMachine.h"
-#include "EBlackboard.h"
+#include "AgentBlackboard.h"
 #include "StatesAndTransitions.h"
+#include "AgentStateGraph.h"
 #include "SteeringController.h"
+#include "EProfiler.h"
+#include "FlowField.h"
+#include "ELogger.h"
+#ifdef ELITE_REPLAY_RECORDING
+#include "RecordingExamInterface.h"
+#include "ReplayFile.h"
+#ifndef ELITE_REPLAY_FILE
+#define ELITE_REPLAY_FILE "replay.gppr"
+#endif
+#endif
 
 //Called only once, during initialization
 void Plugin::Initialize(IBaseInterface* pInterface, PluginInfo& info)
@@ -13,7 +24,27 @@ void Plugin::Initialize(IBaseInterface* pInterface, PluginInfo& info)
 	//Retrieving the interface
 	//This interface gives you access to certain actions the AI_Framework can perform for you
 	m_pInterface = static_cast<IExamInterface*>(pInterface);
-	m_pBlackboard->AddData("Interface", m_pInterface);
+#ifdef ELITE_REPLAY_RECORDING
+	//a new interface starts a new recording
+	SAFE_DELETE(m_pRecordingInterface);
+	if (!m_pReplayWriter)
+	{
+		m_pReplayWriter = new ReplayWriter();
+	}
+	if (m_pReplayWriter->Open(ELITE_REPLAY_FILE, m_Seed, m_LevelFile))
+	{
+		m_pRecordingInterface = new RecordingExamInterface(m_pInterface, m_pReplayWriter);
+		m_pInterface = m_pRecordingInterface;
+	}
+#endif
+	m_pBlackboard->Get<BB::Interface>() = m_pInterface;
+	//directions around the walls of the level towards the world center
+	m_pFlowField = FlowField::GetShared(m_LevelFile, m_pInterface->World_GetInfo().Center);
+	m_pBlackboard->Get<BB::FlowField>() = m_pFlowField.get();
+	//sized to this world, a map left over from an earlier one is dropped
+	m_pBlackboard->Get<BB::Threats>().Initialize(m_pInterface->World_GetInfo());
+	//whatever the agent starts out with, from here on the mirror follows our own changes
+	m_pBlackboard->Get<BB::Inventory>().Sync(m_pInterface);
 
 	//Bit information about the plugin
 	//Please fill this in!!
@@ -21,116 +52,76 @@ void Plugin::Initialize(IBaseInterface* pInterface, PluginInfo& info)
 	info.Student_FirstName = "Bryn";
 	info.Student_LastName = "Couvreur";
 	info.Student_Class = "2DAE01";
+
+#ifdef ELITE_REPLAY_RECORDING
+	if (m_pRecordingInterface)
+	{
+		m_pRecordingInterface->EndFrame(0.f, SteeringPlugin_Output{});
+	}
+#endif
 }
 
 //Called only once
 void Plugin::DllInit()
 {
 	//Called when the plugin is loaded
+	//diagnostics are written by a background thread, so they never block a tick
+	Elite::Logger::GetInstance().StartDrainThread();
+	//the messages of an earlier plugin instance on this thread don't count against this one
+	Elite::Logger::GetInstance().ResetRateLimits();
 	m_pSteeringController = new SteeringController();
 
 	//setup blackboard
 	m_pBlackboard = new Elite::Blackboard();
-	m_pBlackboard->AddData("SteeringController", m_pSteeringController);
-
-	std::vector<HouseInfo> houseInfoRef{};
-	m_pBlackboard->AddData("HousesInFOV", houseInfoRef);
-
-	std::vector<EntityInfo> entityInfoRef{};
-	m_pBlackboard->AddData("EntitiesInFOV", entityInfoRef);
-
-	TargetData targetData{};
-	m_pBlackboard->AddData("Target", targetData);
-
-	HouseInfo targetHouseInfo{};
-	m_pBlackboard->AddData("TargetHouse", targetHouseInfo);
-
-	EntityInfo targetItem{};
-	m_pBlackboard->AddData("TargetItem", targetItem);
-
-	EnemyInfo targetEnemy{};
-	m_pBlackboard->AddData("TargetEnemy", targetEnemy);
-
-	m_pBlackboard->AddData("HouseEntryPoint", Elite::Vector2{});
-	m_pBlackboard->AddData("WeaponInventoryIndex", int{-1});
-	m_pBlackboard->AddData("AutoOrient", bool{ true });
-	m_pBlackboard->AddData("NrTimesToShoot", int{ 0 });
-	m_pBlackboard->AddData("TargetPurgeZone", PurgeZoneInfo{});
+	m_pBlackboard->CreateSlots<AgentBlackboardSlots>();
+	BB::AddSlotAliases(m_pBlackboard);
+	m_pBlackboard->Get<BB::SteeringController>() = m_pSteeringController;
+	//the perception frame is refilled in place every frame, size it up front so that never allocates
+	const size_t maxHousesInFOV{ 16 };
+	const size_t maxEntitiesPerTypeInFOV{ 64 };
+	m_pBlackboard->Get<BB::Perception>().Reserve(maxHousesInFOV, maxEntitiesPerTypeInFOV);
+	m_pBlackboard->Get<BB::Enemies>().Reserve(maxEntitiesPerTypeInFOV);
+	//same for the world memory, it only allocates once more entities are remembered than this
+	const size_t maxRememberedEntities{ 4096 };
+	m_pBlackboard->Get<BB::Memory>().Reserve(maxRememberedEntities);
+	const size_t maxVisitedHouses{ 256 };
+	m_pBlackboard->Get<BB::VisitedHouses>().Reserve(maxVisitedHouses);
 
 	//state machine setup
 
 	//STATES
-	m_pWanderState = new WanderState();	
-	m_pFleeState = new FleeState();
-	m_pEnterHouseState = new EnterHouseState();
-	m_pSearchCurrentHouseState = new SearchCurrentHouseState();
-	m_pExitCurrentHouseState = new ExitCurrentHouseState();
-	m_pGrabItemState = new GrabItemState();
-	m_pKillZombieState = new KillZombieState();
-	m_pGoToWorldCenterState = new GoToWorldCenterState();
-	m_pFleePurgeZoneState = new FleePurgeZoneState();
+	m_States.resize(AgentStateGraph::NrStates);
+	m_States[int(eAgentState::WANDER)] = new WanderState();
+	m_States[int(eAgentState::FLEE)] = new FleeState();
+	m_States[int(eAgentState::ENTER_HOUSE)] = new EnterHouseState();
+	m_States[int(eAgentState::SEARCH_CURRENT_HOUSE)] = new SearchCurrentHouseState();
+	m_States[int(eAgentState::EXIT_CURRENT_HOUSE)] = new ExitCurrentHouseState();
+	m_States[int(eAgentState::GRAB_ITEM)] = new GrabItemState();
+	m_States[int(eAgentState::KILL_ZOMBIE)] = new KillZombieState();
+	m_States[int(eAgentState::GO_TO_WORLD_CENTER)] = new GoToWorldCenterState();
+	m_States[int(eAgentState::FLEE_PURGE_ZONE)] = new FleePurgeZoneState();
 
 	//TRANSITIONS
-	m_pSeesZombieTransition = new SeesZombieTransition();
-	m_pSeesHouseTransition = new SeesHouseTransition();
-	m_pSeesItemTransition = new SeesItemTransition();
-	m_pFinishedFleeingTransition = new FinishedFleeingTransition();
-	m_pIsInsideHouseTransition = new IsInsideHouseTransition();
-	m_pIsNotInsideHouseTransition = new IsNotInsideHouseTransition();
-	m_pFinishedSearchingHouseTransition = new FinishedSearchingHouseTransition();
-	m_pHasGrabbedItemTransition = new HasGrabbedItemTransition();
-	m_pCanKillZombieTransition = new CanKillZombieTransition();
-	m_pHasKilledZombieTransition = new HasKilledZombieTransition();
-	m_pHasLeftWorldTransition = new HasLeftWorldTransition();
-	m_pIsAtWorldCenterTransition = new IsAtWorldCenterTransition();
-	m_pSeesPurgeZoneTransition = new SeesPurgeZoneTransition();
-	m_pHasLeftPurgeZoneTransition = new HasLeftPurgeZoneTransition();
+	m_Transitions.resize(AgentStateGraph::NrTransitions);
+	m_Transitions[int(eAgentTransition::SEES_ZOMBIE)] = new SeesZombieTransition();
+	m_Transitions[int(eAgentTransition::SEES_HOUSE)] = new SeesHouseTransition();
+	m_Transitions[int(eAgentTransition::SEES_ITEM)] = new SeesItemTransition();
+	m_Transitions[int(eAgentTransition::FINISHED_FLEEING)] = new FinishedFleeingTransition();
+	m_Transitions[int(eAgentTransition::IS_INSIDE_HOUSE)] = new IsInsideHouseTransition();
+	m_Transitions[int(eAgentTransition::IS_NOT_INSIDE_HOUSE)] = new IsNotInsideHouseTransition();
+	m_Transitions[int(eAgentTransition::FINISHED_SEARCHING_HOUSE)] = new FinishedSearchingHouseTransition();
+	m_Transitions[int(eAgentTransition::HAS_GRABBED_ITEM)] = new HasGrabbedItemTransition();
+	m_Transitions[int(eAgentTransition::CAN_KILL_ZOMBIE)] = new CanKillZombieTransition();
+	m_Transitions[int(eAgentTransition::HAS_KILLED_ZOMBIE)] = new HasKilledZombieTransition();
+	m_Transitions[int(eAgentTransition::HAS_LEFT_WORLD)] = new HasLeftWorldTransition();
+	m_Transitions[int(eAgentTransition::IS_AT_WORLD_CENTER)] = new IsAtWorldCenterTransition();
+	m_Transitions[int(eAgentTransition::SEES_PURGE_ZONE)] = new SeesPurgeZoneTransition();
+	m_Transitions[int(eAgentTransition::HAS_LEFT_PURGE_ZONE)] = new HasLeftPurgeZoneTransition();
 
 	//STATE MACHINE
-	m_pFiniteStateMachine = new FiniteStateMachine( m_pWanderState, m_pBlackboard);
-	//from wander
-	m_pFiniteStateMachine->AddTransition(m_pWanderState, m_pFleePurgeZoneState, m_pSeesPurgeZoneTransition);
-	m_pFiniteStateMachine->AddTransition(m_pWanderState, m_pExitCurrentHouseState, m_pIsInsideHouseTransition); //safety measure in case agent ends up wandering inside a house
-	m_pFiniteStateMachine->AddTransition(m_pWanderState, m_pKillZombieState, m_pCanKillZombieTransition);
-	m_pFiniteStateMachine->AddTransition(m_pWanderState, m_pFleeState, m_pSeesZombieTransition);
-	m_pFiniteStateMachine->AddTransition(m_pWanderState, m_pEnterHouseState, m_pSeesHouseTransition);	
-	m_pFiniteStateMachine->AddTransition(m_pWanderState, m_pGoToWorldCenterState, m_pHasLeftWorldTransition);
-	
-	//from flee
-	m_pFiniteStateMachine->AddTransition(m_pFleeState, m_pFleePurgeZoneState, m_pSeesPurgeZoneTransition);	
-	m_pFiniteStateMachine->AddTransition(m_pFleeState, m_pEnterHouseState, m_pSeesHouseTransition);
-	m_pFiniteStateMachine->AddTransition(m_pFleeState, m_pKillZombieState, m_pCanKillZombieTransition);
-	m_pFiniteStateMachine->AddTransition(m_pFleeState, m_pWanderState, m_pFinishedFleeingTransition);
-	
-	//from exiting a house
-	m_pFiniteStateMachine->AddTransition(m_pExitCurrentHouseState, m_pKillZombieState, m_pCanKillZombieTransition);
-	m_pFiniteStateMachine->AddTransition(m_pExitCurrentHouseState, m_pGrabItemState, m_pSeesItemTransition);
-	m_pFiniteStateMachine->AddTransition(m_pExitCurrentHouseState, m_pFleeState, m_pIsNotInsideHouseTransition);
-	
-	//from searching a house
-	m_pFiniteStateMachine->AddTransition(m_pSearchCurrentHouseState, m_pExitCurrentHouseState, m_pSeesPurgeZoneTransition);
-	m_pFiniteStateMachine->AddTransition(m_pSearchCurrentHouseState, m_pKillZombieState, m_pCanKillZombieTransition);
-	m_pFiniteStateMachine->AddTransition(m_pSearchCurrentHouseState, m_pGrabItemState, m_pSeesItemTransition);	
-	m_pFiniteStateMachine->AddTransition(m_pSearchCurrentHouseState, m_pExitCurrentHouseState, m_pFinishedSearchingHouseTransition);
-	
-	//from entering a house	
-	m_pFiniteStateMachine->AddTransition(m_pEnterHouseState, m_pFleePurgeZoneState, m_pSeesPurgeZoneTransition);
-	m_pFiniteStateMachine->AddTransition(m_pEnterHouseState, m_pSearchCurrentHouseState, m_pIsInsideHouseTransition);
-	m_pFiniteStateMachine->AddTransition(m_pEnterHouseState, m_pKillZombieState, m_pCanKillZombieTransition);
-	
-	//from killing a zombie
-	m_pFiniteStateMachine->AddTransition(m_pKillZombieState, m_pWanderState, m_pHasKilledZombieTransition);
-
-	//from grabbing an item
-	m_pFiniteStateMachine->AddTransition(m_pGrabItemState, m_pSearchCurrentHouseState, m_pHasGrabbedItemTransition);
-	
-	//from traveling to the world center
-	m_pFiniteStateMachine->AddTransition(m_pGoToWorldCenterState, m_pEnterHouseState, m_pSeesHouseTransition);
-	m_pFiniteStateMachine->AddTransition(m_pGoToWorldCenterState, m_pKillZombieState, m_pCanKillZombieTransition);
-	m_pFiniteStateMachine->AddTransition(m_pGoToWorldCenterState, m_pWanderState, m_pIsAtWorldCenterTransition);
-
-	//from fleeing a purge zone
-	m_pFiniteStateMachine->AddTransition(m_pFleePurgeZoneState, m_pWanderState, m_pHasLeftPurgeZoneTransition);
+	//the graph itself lives in AgentStateGraph.h
+	m_pFiniteStateMachine = new FiniteStateMachine(m_States[int(eAgentState::WANDER)], m_pBlackboard);
+	m_pFiniteStateMachine->SetTransitionTable(m_States, m_Transitions, AgentStateGraph::Table);
 }
 
 //Called only once
@@ -140,31 +131,26 @@ void Plugin::DllShutdown()
 
 	//delete m_pBlackboard;
 	delete m_pFiniteStateMachine;
-	//STATES
-	delete m_pWanderState;
-	delete m_pEnterHouseState;
-	delete m_pSearchCurrentHouseState;
-	delete m_pExitCurrentHouseState;
-	delete m_pGrabItemState;
-	delete m_pKillZombieState;
-	delete m_pGoToWorldCenterState;
-	delete m_pFleePurgeZoneState;
-	//TRANSITIONS
-	delete m_pSeesZombieTransition;
-	delete m_pSeesHouseTransition;
-	delete m_pFinishedFleeingTransition;
-	delete m_pSeesItemTransition;
-	delete m_pIsInsideHouseTransition;
-	delete m_pIsNotInsideHouseTransition;
-	delete m_pHasGrabbedItemTransition;
-	delete m_pCanKillZombieTransition;
-	delete m_pHasKilledZombieTransition;
-	delete m_pHasLeftWorldTransition;
-	delete m_pIsAtWorldCenterTransition;
-	delete m_pSeesPurgeZoneTransition;
-	delete m_pHasLeftPurgeZoneTransition;
+	for (Elite::FSMState* pState : m_States)
+	{
+		delete pState;
+	}
+	m_States.clear();
+	for (Elite::FSMTransition* pTransition : m_Transitions)
+	{
+		delete pTransition;
+	}
+	m_Transitions.clear();
 
 	delete m_pSteeringController;
+	m_pFlowField.reset();
+#ifdef ELITE_REPLAY_RECORDING
+	//writes out the last chunk
+	SAFE_DELETE(m_pRecordingInterface);
+	SAFE_DELETE(m_pReplayWriter);
+#endif
+
+	Elite::Logger::GetInstance().StopDrainThread();
 }
 
 //Called only once, during initialization
@@ -176,6 +162,14 @@ void Plugin::InitGameDebugParams(GameDebugParams& params)
 	params.EnemyCount = 20; //How many enemies? (Default = 20)
 	params.GodMode = false; //GodMode > You can't die, can be usefull to inspect certain behaviours (Default = false)
 	params.AutoGrabClosestItem = true; //A call to Item_Grab(...) returns the closest item that can be grabbed. (EntityInfo argument is ignored)
+
+	//derive the steering randomness from the game seed, so a run with the same seed is reproducible
+	m_pSteeringController->SetRandomSeed(static_cast<unsigned int>(params.Seed));
+	//the same level file the host loads, Initialize builds the flow field from its walls
+	m_LevelFile = params.LevelFile;
+#ifdef ELITE_REPLAY_RECORDING
+	m_Seed = params.Seed;
+#endif
 }
 
 //Only Active in DEBUG Mode
@@ -225,14 +219,20 @@ void Plugin::Update(float dt)
 //This function calculates the new SteeringOutput, called once per frame
 SteeringPlugin_Output Plugin::UpdateSteering(float dt)
 {
-	std::vector<HouseInfo> vHousesInFOV = GetHousesInFOV();//uses m_pInterface->Fov_GetHouseByIndex(...)
-	m_pBlackboard->ChangeData("HousesInFOV", vHousesInFOV);
-	std::vector<EntityInfo> vEntitiesInFOV = GetEntitiesInFOV(); //uses m_pInterface->Fov_GetEntityByIndex(...)
-	m_pBlackboard->ChangeData("EntitiesInFOV", vEntitiesInFOV);
-	
-	
+	ELITE_PROFILE_SCOPE("Plugin::UpdateSteering");
+	//one Agent_GetInfo() per tick, the states and transitions read the cached copy
+	AgentInfo& agentInfo{ m_pBlackboard->Get<BB::Agent>() };
+	agentInfo = m_pInterface->Agent_GetInfo();
+	PerceptionFrame& perception{ m_pBlackboard->Get<BB::Perception>() };
+	perception.Refresh(m_pInterface); //uses m_pInterface->Fov_Get...ByIndex(...)
+	m_pBlackboard->Get<BB::Memory>().Update(perception, agentInfo, dt);
+	UpdateDangers(perception, agentInfo, dt);
+	m_pBlackboard->Get<BB::Inventory>().Update(m_pInterface, dt);
+
 	m_pFiniteStateMachine->Update(dt);
-	auto agentInfo = m_pInterface->Agent_GetInfo();
+#ifdef _DEBUG
+	ValidateAgentCache();
+#endif
 	//items
 	UseConsumables(agentInfo);
 	//return steering;
@@ -250,7 +250,13 @@ SteeringPlugin_Output Plugin::UpdateSteering(float dt)
 	steering.RunMode = m_CanRun;
 
 	//set auto orient
-	m_pBlackboard->GetData("AutoOrient", steering.AutoOrient);
+	steering.AutoOrient = m_pBlackboard->Get<BB::AutoOrient>();
+#ifdef ELITE_REPLAY_RECORDING
+	if (m_pRecordingInterface)
+	{
+		m_pRecordingInterface->EndFrame(dt, steering);
+	}
+#endif
 	return steering;
 }
 
@@ -261,80 +267,91 @@ void Plugin::Render(float dt) const
 	m_pInterface->Draw_SolidCircle(m_Target, .7f, { 0,0 }, { 1, 0, 0 });
 }
 
-vector<HouseInfo> Plugin::GetHousesInFOV() const
+#ifdef _DEBUG
+void Plugin::ValidateAgentCache() const
 {
-	vector<HouseInfo> vHousesInFOV = {};
-
-	HouseInfo hi = {};
-	for (int i = 0;; ++i)
+	//nothing moves the agent during a tick, only using an item changes it and that refreshes the cache
+	const AgentInfo& cached{ m_pBlackboard->Get<BB::Agent>() };
+	const AgentInfo host{ m_pInterface->Agent_GetInfo() };
+	const bool isSame{ cached.Position == host.Position && cached.Orientation == host.Orientation
+		&& cached.LinearVelocity == host.LinearVelocity && cached.AngularVelocity == host.AngularVelocity
+		&& cached.Health == host.Health && cached.Energy == host.Energy && cached.Stamina == host.Stamina
+		&& cached.IsInHouse == host.IsInHouse && cached.Bitten == host.Bitten && cached.WasBitten == host.WasBitten
+		&& cached.RunMode == host.RunMode && cached.Death == host.Death };
+	if (!isSame)
 	{
-		if (m_pInterface->Fov_GetHouseByIndex(i, hi))
-		{
-			vHousesInFOV.push_back(hi);
-			continue;
-		}
-
-		break;
+		ELITE_LOG_WARNING("Cached agent info is out of date with the host, call Agent_GetInfo() again after changing the agent");
 	}
-
-	return vHousesInFOV;
 }
+#endif
 
-vector<EntityInfo> Plugin::GetEntitiesInFOV() const
+void Plugin::UpdateDangers(const PerceptionFrame& perception, const AgentInfo& agentInfo, float dt)
 {
-	vector<EntityInfo> vEntitiesInFOV = {};
-
-	EntityInfo ei = {};
-	for (int i = 0;; ++i)
+	ELITE_PROFILE_SCOPE("Plugin::UpdateDangers");
+	ThreatMap& threats{ m_pBlackboard->Get<BB::Threats>() };
+	threats.Update(dt);
+	SteeringContext& context{ m_pBlackboard->Get<BB::Context>() };
+	context.Clear();
+	EnemyFrame& enemyFrame{ m_pBlackboard->Get<BB::Enemies>() };
+	enemyFrame.Clear();
+
+	//the only Enemy_GetInfo of the tick, the evasion and the target selection read the enemies from the frame
+	//only the enemies in view are splatted, the ones seen before are still in the map, fading and spreading around where they were
+	const EntityPartition& enemies{ perception.GetEnemies() };
+	for (size_t i{ 0 }; i < enemies.Size(); ++i)
 	{
-		if (m_pInterface->Fov_GetEntityByIndex(i, ei))
+		EnemyInfo enemyInfo{};
+		if (m_pInterface->Enemy_GetInfo(enemies.GetEntity(i, eEntityType::ENEMY), enemyInfo))
 		{
-			vEntitiesInFOV.push_back(ei);
-			continue;
+			threats.Splat(enemyInfo, dt);
+			context.AddObstacle(agentInfo.Position, enemyInfo.Location, enemyInfo.Size / 2.f, m_EnemyClearance, m_EnemyDangerRange);
+			enemyFrame.Add(enemyInfo);
 		}
+	}
 
-		break;
+	const EntityPartition& purgeZones{ perception.GetPurgeZones() };
+	for (size_t i{ 0 }; i < purgeZones.Size(); ++i)
+	{
+		PurgeZoneInfo zoneInfo{};
+		if (m_pInterface->PurgeZone_GetInfo(purgeZones.GetEntity(i, eEntityType::PURGEZONE), zoneInfo))
+		{
+			context.AddObstacle(agentInfo.Position, zoneInfo.Center, zoneInfo.Radius, m_PurgeZoneClearance, m_PurgeZoneDangerRange);
+		}
 	}
 
-	return vEntitiesInFOV;
+	//a feeler along every slot, the closer the wall the more dangerous
+	if (m_pFlowField)
+	{
+		for (int slotIdx{ 0 }; slotIdx < SteeringContext::NrSlots; ++slotIdx)
+		{
+			const float wallDistance{ m_pFlowField->GetWallDistance(agentInfo.Position, SteeringContext::GetSlotDirection(slotIdx), m_WallFeelerLength) };
+			context.AddSlotDanger(slotIdx, 1.f - wallDistance / m_WallFeelerLength);
+		}
+	}
 }
 
 void Plugin::UseConsumables(const AgentInfo& agentInfo)
 {
-	const unsigned int invCapacity{ m_pInterface->Inventory_GetCapacity() };
+	ELITE_PROFILE_SCOPE("Plugin::UseConsumables");
+	InventoryMirror& inventory{ m_pBlackboard->Get<BB::Inventory>() };
 
-	//check all inventory items
-	for (unsigned int i{ 0 }; i < invCapacity; ++i)
+	//only the food and medkit slots, what they're worth comes from the mirror
+	uint32_t foodSlots{ inventory.GetSlots(eItemType::FOOD) };
+	for (UINT i{ 0 }; foodSlots != 0; ++i, foodSlots >>= 1)
 	{
-		ItemInfo invItem{};
-
-		if (!m_pInterface->Inventory_GetItem(i, invItem))
+		if ((foodSlots & 1u) && agentInfo.Energy + inventory.GetValue(i) < 10.f)
 		{
-			//if this slot is empty, continue
-			continue;
+			inventory.UseItem(m_pInterface, i);
+			inventory.RemoveItem(m_pInterface, i);
 		}
-		
-		int itemValue{};
-		switch (invItem.Type)
+	}
+	uint32_t medkitSlots{ inventory.GetSlots(eItemType::MEDKIT) };
+	for (UINT i{ 0 }; medkitSlots != 0; ++i, medkitSlots >>= 1)
+	{
+		if ((medkitSlots & 1u) && agentInfo.Health + inventory.GetValue(i) < 10.f)
 		{
-		case eItemType::FOOD:
-			itemValue = m_pInterface->Food_GetEnergy(invItem);
-			if (agentInfo.Energy + itemValue < 10.f)
-			{
-				m_pInterface->Inventory_UseItem(i);
-				m_pInterface->Inventory_RemoveItem(i);
-			}		
-			break;
-		case eItemType::MEDKIT:
-			itemValue = m_pInterface->Medkit_GetHealth(invItem);
-			if (agentInfo.Health + itemValue < 10.f)
-			{
-				m_pInterface->Inventory_UseItem(i);
-				m_pInterface->Inventory_RemoveItem(i);
-			}
-			break;
-		default:
-			break;
+			inventory.UseItem(m_pInterface, i);
+			inventory.RemoveItem(m_pInterface, i);
 		}
 	}
 }
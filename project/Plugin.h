@@ -6,6 +6,10 @@ class IBaseInterface;
 class IExamInterface;
 
 class SteeringController;
+class FlowField;
+class ReplayWriter;
+class RecordingExamInterface;
+class PerceptionFrame;
 namespace Elite
 {
 	class FiniteStateMachine;
@@ -33,9 +37,11 @@ public:
 private:
 	//Interface, used to request data from/perform actions with the AI Framework
 	IExamInterface* m_pInterface = nullptr;
-	vector<HouseInfo> GetHousesInFOV() const;
-	vector<EntityInfo> GetEntitiesInFOV() const;
 	void UseConsumables(const AgentInfo& agentInfo);
+	void UpdateDangers(const PerceptionFrame& perception, const AgentInfo& agentInfo, float dt);
+#ifdef _DEBUG
+	void ValidateAgentCache() const;
+#endif
 
 	Elite::Vector2 m_Target = {};
 	bool m_CanRun = false; //Demo purpose
@@ -47,32 +53,28 @@ private:
 	//=========
 	Elite::FiniteStateMachine* m_pFiniteStateMachine = nullptr;
 	Elite::Blackboard* m_pBlackboard = nullptr;
-	Elite::FSMState* m_pWanderState = nullptr;
-	Elite::FSMState* m_pFleeState = nullptr;
-	Elite::FSMState* m_pEnterHouseState = nullptr;
-	Elite::FSMState* m_pSearchCurrentHouseState = nullptr;
-	Elite::FSMState* m_pExitCurrentHouseState = nullptr;
-	Elite::FSMState* m_pGrabItemState = nullptr;
-	Elite::FSMState* m_pKillZombieState = nullptr;
-	Elite::FSMState* m_pGoToWorldCenterState = nullptr;
-	Elite::FSMState* m_pFleePurgeZoneState = nullptr;
-
-	Elite::FSMTransition* m_pSeesZombieTransition = nullptr;
-	Elite::FSMTransition* m_pSeesHouseTransition = nullptr;
-	Elite::FSMTransition* m_pSeesItemTransition = nullptr;
-	Elite::FSMTransition* m_pFinishedFleeingTransition = nullptr;
-	Elite::FSMTransition* m_pIsInsideHouseTransition = nullptr;
-	Elite::FSMTransition* m_pIsNotInsideHouseTransition = nullptr;
-	Elite::FSMTransition* m_pFinishedSearchingHouseTransition = nullptr;
-	Elite::FSMTransition* m_pHasGrabbedItemTransition = nullptr;
-	Elite::FSMTransition* m_pCanKillZombieTransition = nullptr;
-	Elite::FSMTransition* m_pHasKilledZombieTransition = nullptr;
-	Elite::FSMTransition* m_pHasLeftWorldTransition = nullptr;
-	Elite::FSMTransition* m_pIsAtWorldCenterTransition = nullptr;
-	Elite::FSMTransition* m_pSeesPurgeZoneTransition = nullptr;
-	Elite::FSMTransition* m_pHasLeftPurgeZoneTransition = nullptr;
+	//indexed by eAgentState and eAgentTransition, wired together by AgentStateGraph::Table
+	std::vector<Elite::FSMState*> m_States;
+	std::vector<Elite::FSMTransition*> m_Transitions;
 
 	SteeringController* m_pSteeringController = nullptr;
+	//shared with the other plugin instances on the same level, built when the first one loads it
+	std::shared_ptr<const FlowField> m_pFlowField;
+	std::string m_LevelFile;
+
+	//how the enemies, purge zones and walls around the agent weigh in on the danger of the steering context
+	static constexpr float m_EnemyClearance{ 1.5f };
+	static constexpr float m_EnemyDangerRange{ 15.f };
+	static constexpr float m_PurgeZoneClearance{ 2.f };
+	static constexpr float m_PurgeZoneDangerRange{ 10.f };
+	static constexpr float m_WallFeelerLength{ 6.f };
+
+#ifdef ELITE_REPLAY_RECORDING
+	//every call to the framework is recorded, a bad episode can be replayed with the headless host
+	ReplayWriter* m_pReplayWriter = nullptr;
+	RecordingExamInterface* m_pRecordingInterface = nullptr;
+	int m_Seed = 0;
+#endif
 	//=========
 };
 
@@ -81,7 +83,10 @@ private:
 //The plugin returned by this function is also the plugin used by the host program
 extern "C"
 {
-	__declspec (dllexport) IPluginBase* Register()
+#ifdef _WIN32
+	__declspec (dllexport)
+#endif
+	IPluginBase* Register()
 	{
 		return new Plugin();
 	}
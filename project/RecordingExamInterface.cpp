@@ -0,0 +1,158 @@
+#include "stdafx.h"
+#include "RecordingExamInterface.h"
+#include "ReplayFile.h"
+
+RecordingExamInterface::RecordingExamInterface(IExamInterface* pInterface, ReplayWriter* pWriter)
+	: m_pInterface{ pInterface }
+	, m_pWriter{ pWriter }
+{
+}
+
+void RecordingExamInterface::EndFrame(float deltaTime, const SteeringPlugin_Output& steering)
+{
+	//Initialize has no output, frame 0 ends on its calls
+	if (m_pWriter->GetNrFrames() > 0)
+	{
+		m_pWriter->Record(eReplayCall::STEERING_OUTPUT, steering);
+	}
+	m_pWriter->EndFrame(deltaTime);
+}
+
+#pragma region World
+WorldInfo RecordingExamInterface::World_GetInfo() const
+{
+	const WorldInfo worldInfo{ m_pInterface->World_GetInfo() };
+	m_pWriter->Record(eReplayCall::WORLD_GET_INFO, worldInfo);
+	return worldInfo;
+}
+
+StatisticsInfo RecordingExamInterface::World_GetStats() const
+{
+	const StatisticsInfo stats{ m_pInterface->World_GetStats() };
+	m_pWriter->Record(eReplayCall::WORLD_GET_STATS, stats);
+	return stats;
+}
+
+bool RecordingExamInterface::Fov_GetHouseByIndex(UINT index, HouseInfo& houseInfo) const
+{
+	const bool isValid{ m_pInterface->Fov_GetHouseByIndex(index, houseInfo) };
+	m_pWriter->Record(eReplayCall::FOV_GET_HOUSE_BY_INDEX, index, isValid, houseInfo);
+	return isValid;
+}
+
+bool RecordingExamInterface::Fov_GetEntityByIndex(UINT index, EntityInfo& enemyInfo) const
+{
+	const bool isValid{ m_pInterface->Fov_GetEntityByIndex(index, enemyInfo) };
+	m_pWriter->Record(eReplayCall::FOV_GET_ENTITY_BY_INDEX, index, isValid, enemyInfo);
+	return isValid;
+}
+
+AgentInfo RecordingExamInterface::Agent_GetInfo() const
+{
+	const AgentInfo agentInfo{ m_pInterface->Agent_GetInfo() };
+	m_pWriter->Record(eReplayCall::AGENT_GET_INFO, agentInfo);
+	return agentInfo;
+}
+
+bool RecordingExamInterface::Enemy_GetInfo(EntityInfo entity, EnemyInfo& enemy)
+{
+	const bool isValid{ m_pInterface->Enemy_GetInfo(entity, enemy) };
+	m_pWriter->Record(eReplayCall::ENEMY_GET_INFO, entity, isValid, enemy);
+	return isValid;
+}
+
+Elite::Vector2 RecordingExamInterface::NavMesh_GetClosestPathPoint(Elite::Vector2 goal) const
+{
+	const Elite::Vector2 pathPoint{ m_pInterface->NavMesh_GetClosestPathPoint(goal) };
+	m_pWriter->Record(eReplayCall::NAVMESH_GET_CLOSEST_PATH_POINT, goal, pathPoint);
+	return pathPoint;
+}
+#pragma endregion
+
+#pragma region Inventory
+bool RecordingExamInterface::Inventory_AddItem(UINT slotId, ItemInfo item)
+{
+	const bool isAdded{ m_pInterface->Inventory_AddItem(slotId, item) };
+	m_pWriter->Record(eReplayCall::INVENTORY_ADD_ITEM, slotId, item, isAdded);
+	return isAdded;
+}
+
+bool RecordingExamInterface::Inventory_UseItem(UINT slotId)
+{
+	const bool isUsed{ m_pInterface->Inventory_UseItem(slotId) };
+	m_pWriter->Record(eReplayCall::INVENTORY_USE_ITEM, slotId, isUsed);
+	return isUsed;
+}
+
+bool RecordingExamInterface::Inventory_RemoveItem(UINT slotId)
+{
+	const bool isRemoved{ m_pInterface->Inventory_RemoveItem(slotId) };
+	m_pWriter->Record(eReplayCall::INVENTORY_REMOVE_ITEM, slotId, isRemoved);
+	return isRemoved;
+}
+
+bool RecordingExamInterface::Inventory_GetItem(UINT slotId, ItemInfo& item)
+{
+	const bool isValid{ m_pInterface->Inventory_GetItem(slotId, item) };
+	m_pWriter->Record(eReplayCall::INVENTORY_GET_ITEM, slotId, isValid, item);
+	return isValid;
+}
+
+UINT RecordingExamInterface::Inventory_GetCapacity() const
+{
+	const UINT capacity{ m_pInterface->Inventory_GetCapacity() };
+	m_pWriter->Record(eReplayCall::INVENTORY_GET_CAPACITY, capacity);
+	return capacity;
+}
+#pragma endregion
+
+#pragma region Items
+bool RecordingExamInterface::Item_GetInfo(EntityInfo entity, ItemInfo& item)
+{
+	const bool isValid{ m_pInterface->Item_GetInfo(entity, item) };
+	m_pWriter->Record(eReplayCall::ITEM_GET_INFO, entity, isValid, item);
+	return isValid;
+}
+
+bool RecordingExamInterface::Item_Grab(EntityInfo entity, ItemInfo& item)
+{
+	const bool isGrabbed{ m_pInterface->Item_Grab(entity, item) };
+	m_pWriter->Record(eReplayCall::ITEM_GRAB, entity, isGrabbed, item);
+	return isGrabbed;
+}
+
+bool RecordingExamInterface::Item_Destroy(EntityInfo entity)
+{
+	const bool isDestroyed{ m_pInterface->Item_Destroy(entity) };
+	m_pWriter->Record(eReplayCall::ITEM_DESTROY, entity, isDestroyed);
+	return isDestroyed;
+}
+
+int RecordingExamInterface::Weapon_GetAmmo(ItemInfo& item)
+{
+	const int ammo{ m_pInterface->Weapon_GetAmmo(item) };
+	m_pWriter->Record(eReplayCall::WEAPON_GET_AMMO, item, ammo);
+	return ammo;
+}
+
+int RecordingExamInterface::Medkit_GetHealth(ItemInfo& item)
+{
+	const int health{ m_pInterface->Medkit_GetHealth(item) };
+	m_pWriter->Record(eReplayCall::MEDKIT_GET_HEALTH, item, health);
+	return health;
+}
+
+int RecordingExamInterface::Food_GetEnergy(ItemInfo& item)
+{
+	const int energy{ m_pInterface->Food_GetEnergy(item) };
+	m_pWriter->Record(eReplayCall::FOOD_GET_ENERGY, item, energy);
+	return energy;
+}
+
+bool RecordingExamInterface::PurgeZone_GetInfo(EntityInfo entity, PurgeZoneInfo& zone)
+{
+	const bool isValid{ m_pInterface->PurgeZone_GetInfo(entity, zone) };
+	m_pWriter->Record(eReplayCall::PURGEZONE_GET_INFO, entity, isValid, zone);
+	return isValid;
+}
+#pragma endregion
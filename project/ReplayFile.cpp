@@ -0,0 +1,413 @@
+#include "stdafx.h"
+#include "ReplayFile.h"
+#include "ELogger.h"
+
+namespace
+{
+	const char g_FileMagic[4]{ 'G', 'P', 'P', 'R' };
+	const char g_ChunkMagic[4]{ 'C', 'H', 'N', 'K' };
+	const uint32_t g_Version{ 1 };
+
+	constexpr uint32_t GetLayoutHash()
+	{
+		const size_t sizes[]{ sizeof(WorldInfo), sizeof(StatisticsInfo), sizeof(HouseInfo), sizeof(EntityInfo), sizeof(AgentInfo),
+			sizeof(EnemyInfo), sizeof(ItemInfo), sizeof(PurgeZoneInfo), sizeof(SteeringPlugin_Output), sizeof(Elite::Vector2), sizeof(bool), sizeof(UINT) };
+		uint32_t hash{ 2166136261u };
+		for (size_t size : sizes)
+		{
+			hash = (hash ^ uint32_t(size)) * 16777619u;
+		}
+		return hash;
+	}
+
+	//every struct the writer stores whole adds up to its fields, padding in one would be recorded as garbage
+	static_assert(sizeof(WorldInfo) == 2 * sizeof(Elite::Vector2), "WorldInfo has padding");
+	static_assert(sizeof(StatisticsInfo) == 3 * sizeof(float) + 6 * sizeof(int), "StatisticsInfo has padding");
+	static_assert(sizeof(HouseInfo) == 2 * sizeof(Elite::Vector2), "HouseInfo has padding");
+	static_assert(sizeof(EntityInfo) == sizeof(eEntityType) + sizeof(Elite::Vector2) + sizeof(int), "EntityInfo has padding");
+	static_assert(sizeof(EnemyInfo) == sizeof(eEnemyType) + 2 * sizeof(Elite::Vector2) + 2 * sizeof(int) + sizeof(float), "EnemyInfo has padding");
+	static_assert(sizeof(ItemInfo) == sizeof(eItemType) + sizeof(Elite::Vector2) + sizeof(int), "ItemInfo has padding");
+	static_assert(sizeof(PurgeZoneInfo) == sizeof(Elite::Vector2) + sizeof(float) + sizeof(int), "PurgeZoneInfo has padding");
+
+	template<typename TField>
+	void WriteField(uint8_t* pValue, size_t fieldOffset, const TField& field)
+	{
+		static_assert(std::is_trivially_copyable_v<TField>, "a recorded field is stored as its raw bytes");
+		memcpy(pValue + fieldOffset, &field, sizeof(field));
+	}
+
+	//LEB128, 7 bits per byte, the high bit set on every byte but the last
+	void WriteVarUInt(std::vector<uint8_t>& buffer, size_t value)
+	{
+		while (value >= 0x80)
+		{
+			buffer.push_back(uint8_t(value | 0x80));
+			value >>= 7;
+		}
+		buffer.push_back(uint8_t(value));
+	}
+
+	bool ReadVarUInt(const uint8_t*& pData, const uint8_t* pEnd, size_t& value)
+	{
+		value = 0;
+		for (int shift{ 0 }; pData < pEnd && shift < 64; shift += 7)
+		{
+			const uint8_t byte{ *pData++ };
+			value |= size_t(byte & 0x7F) << shift;
+			if (!(byte & 0x80))
+			{
+				return true;
+			}
+		}
+		return false;
+	}
+
+	uint8_t GetPreviousByte(const std::vector<uint8_t>& previous, size_t idx)
+	{
+		return idx < previous.size() ? previous[idx] : 0;
+	}
+
+	//frame XOR previous as (zero run, literal run, literals) triplets, a literal run only ends at a few zeros in a row
+	void EncodeFrame(const std::vector<uint8_t>& frame, const std::vector<uint8_t>& previous, std::vector<uint8_t>& encoded)
+	{
+		const size_t minZeroRun{ 3 };
+		size_t idx{ 0 };
+		while (idx < frame.size())
+		{
+			const size_t zeroStart{ idx };
+			while (idx < frame.size() && frame[idx] == GetPreviousByte(previous, idx))
+				++idx;
+			WriteVarUInt(encoded, idx - zeroStart);
+
+			const size_t literalStart{ idx };
+			size_t nrZeros{ 0 };
+			while (idx < frame.size() && nrZeros < minZeroRun)
+			{
+				nrZeros = frame[idx] == GetPreviousByte(previous, idx) ? nrZeros + 1 : 0;
+				++idx;
+			}
+			//the zeros that ended the run start the next one
+			if (nrZeros == minZeroRun)
+				idx -= nrZeros;
+			WriteVarUInt(encoded, idx - literalStart);
+			for (size_t literalIdx{ literalStart }; literalIdx < idx; ++literalIdx)
+			{
+				encoded.push_back(frame[literalIdx] ^ GetPreviousByte(previous, literalIdx));
+			}
+		}
+	}
+
+	bool DecodeFrame(const uint8_t* pEncoded, size_t encodedSize, const std::vector<uint8_t>& previous, std::vector<uint8_t>& frame)
+	{
+		const uint8_t* pEnd{ pEncoded + encodedSize };
+		size_t idx{ 0 };
+		while (pEncoded < pEnd)
+		{
+			size_t nrZeros{};
+			size_t nrLiterals{};
+			if (!ReadVarUInt(pEncoded, pEnd, nrZeros) || !ReadVarUInt(pEncoded, pEnd, nrLiterals)
+				|| idx + nrZeros + nrLiterals > frame.size() || nrLiterals > size_t(pEnd - pEncoded))
+			{
+				return false;
+			}
+			for (const size_t zerosEnd{ idx + nrZeros }; idx < zerosEnd; ++idx)
+			{
+				frame[idx] = GetPreviousByte(previous, idx);
+			}
+			for (const size_t literalsEnd{ idx + nrLiterals }; idx < literalsEnd; ++idx)
+			{
+				frame[idx] = *pEncoded++ ^ GetPreviousByte(previous, idx);
+			}
+		}
+		return idx == frame.size();
+	}
+}
+
+const char* GetReplayCallName(eReplayCall call)
+{
+	switch (call)
+	{
+	case eReplayCall::WORLD_GET_INFO: return "World_GetInfo";
+	case eReplayCall::WORLD_GET_STATS: return "World_GetStats";
+	case eReplayCall::FOV_GET_HOUSE_BY_INDEX: return "Fov_GetHouseByIndex";
+	case eReplayCall::FOV_GET_ENTITY_BY_INDEX: return "Fov_GetEntityByIndex";
+	case eReplayCall::AGENT_GET_INFO: return "Agent_GetInfo";
+	case eReplayCall::ENEMY_GET_INFO: return "Enemy_GetInfo";
+	case eReplayCall::NAVMESH_GET_CLOSEST_PATH_POINT: return "NavMesh_GetClosestPathPoint";
+	case eReplayCall::INVENTORY_ADD_ITEM: return "Inventory_AddItem";
+	case eReplayCall::INVENTORY_USE_ITEM: return "Inventory_UseItem";
+	case eReplayCall::INVENTORY_REMOVE_ITEM: return "Inventory_RemoveItem";
+	case eReplayCall::INVENTORY_GET_ITEM: return "Inventory_GetItem";
+	case eReplayCall::INVENTORY_GET_CAPACITY: return "Inventory_GetCapacity";
+	case eReplayCall::ITEM_GET_INFO: return "Item_GetInfo";
+	case eReplayCall::ITEM_GRAB: return "Item_Grab";
+	case eReplayCall::ITEM_DESTROY: return "Item_Destroy";
+	case eReplayCall::WEAPON_GET_AMMO: return "Weapon_GetAmmo";
+	case eReplayCall::MEDKIT_GET_HEALTH: return "Medkit_GetHealth";
+	case eReplayCall::FOOD_GET_ENERGY: return "Food_GetEnergy";
+	case eReplayCall::PURGEZONE_GET_INFO: return "PurgeZone_GetInfo";
+	case eReplayCall::STEERING_OUTPUT: return "UpdateSteering";
+	default: return "Unknown";
+	}
+}
+
+#pragma region Writer
+ReplayWriter::~ReplayWriter()
+{
+	Close();
+}
+
+bool ReplayWriter::Open(const std::string& path, int seed, const std::string& levelFile)
+{
+	Close();
+	m_pFile = fopen(path.c_str(), "wb");
+	if (!m_pFile)
+	{
+		ELITE_LOG_WARNING("Can't create replay file '%s'", path);
+		return false;
+	}
+
+	ReplayHeader header{};
+	memcpy(header.Magic, g_FileMagic, sizeof(header.Magic));
+	header.Version = g_Version;
+	header.LayoutHash = GetLayoutHash();
+	header.Seed = seed;
+	header.LevelFileLength = uint32_t(levelFile.size());
+	fwrite(&header, sizeof(header), 1, m_pFile);
+	fwrite(levelFile.data(), 1, levelFile.size(), m_pFile);
+	fflush(m_pFile);
+
+	m_Frame.clear();
+	m_PreviousFrame.clear();
+	m_Chunk.clear();
+	m_NrChunkFrames = 0;
+	m_NrFrames = 0;
+	m_NrRawBytes = 0;
+	m_NrWrittenBytes = sizeof(header) + levelFile.size();
+	return true;
+}
+
+void ReplayWriter::Close()
+{
+	if (!m_pFile)
+	{
+		return;
+	}
+
+	WriteChunk();
+	fclose(m_pFile);
+	m_pFile = nullptr;
+}
+
+void ReplayWriter::Append(const void* pData, size_t size)
+{
+	const uint8_t* pBytes{ static_cast<const uint8_t*>(pData) };
+	m_Frame.insert(m_Frame.end(), pBytes, pBytes + size);
+}
+
+void ReplayWriter::AppendValue(const AgentInfo& agentInfo)
+{
+	const size_t offset{ m_Frame.size() };
+	m_Frame.resize(offset + sizeof(AgentInfo), 0);
+	uint8_t* pValue{ m_Frame.data() + offset };
+	WriteField(pValue, offsetof(AgentInfo, Stamina), agentInfo.Stamina);
+	WriteField(pValue, offsetof(AgentInfo, Health), agentInfo.Health);
+	WriteField(pValue, offsetof(AgentInfo, Energy), agentInfo.Energy);
+	WriteField(pValue, offsetof(AgentInfo, RunMode), agentInfo.RunMode);
+	WriteField(pValue, offsetof(AgentInfo, IsInHouse), agentInfo.IsInHouse);
+	WriteField(pValue, offsetof(AgentInfo, Bitten), agentInfo.Bitten);
+	WriteField(pValue, offsetof(AgentInfo, WasBitten), agentInfo.WasBitten);
+	WriteField(pValue, offsetof(AgentInfo, Death), agentInfo.Death);
+	WriteField(pValue, offsetof(AgentInfo, FOV_Angle), agentInfo.FOV_Angle);
+	WriteField(pValue, offsetof(AgentInfo, FOV_Range), agentInfo.FOV_Range);
+	WriteField(pValue, offsetof(AgentInfo, LinearVelocity), agentInfo.LinearVelocity);
+	WriteField(pValue, offsetof(AgentInfo, AngularVelocity), agentInfo.AngularVelocity);
+	WriteField(pValue, offsetof(AgentInfo, CurrentLinearSpeed), agentInfo.CurrentLinearSpeed);
+	WriteField(pValue, offsetof(AgentInfo, Position), agentInfo.Position);
+	WriteField(pValue, offsetof(AgentInfo, Orientation), agentInfo.Orientation);
+	WriteField(pValue, offsetof(AgentInfo, MaxLinearSpeed), agentInfo.MaxLinearSpeed);
+	WriteField(pValue, offsetof(AgentInfo, MaxAngularSpeed), agentInfo.MaxAngularSpeed);
+	WriteField(pValue, offsetof(AgentInfo, GrabRange), agentInfo.GrabRange);
+	WriteField(pValue, offsetof(AgentInfo, AgentSize), agentInfo.AgentSize);
+}
+
+void ReplayWriter::AppendValue(const SteeringPlugin_Output& steering)
+{
+	const size_t offset{ m_Frame.size() };
+	m_Frame.resize(offset + sizeof(SteeringPlugin_Output), 0);
+	uint8_t* pValue{ m_Frame.data() + offset };
+	WriteField(pValue, offsetof(SteeringPlugin_Output, LinearVelocity), steering.LinearVelocity);
+	WriteField(pValue, offsetof(SteeringPlugin_Output, AngularVelocity), steering.AngularVelocity);
+	WriteField(pValue, offsetof(SteeringPlugin_Output, AutoOrient), steering.AutoOrient);
+	WriteField(pValue, offsetof(SteeringPlugin_Output, RunMode), steering.RunMode);
+}
+
+void ReplayWriter::EndFrame(float deltaTime)
+{
+	if (!m_pFile)
+	{
+		m_Frame.clear();
+		return;
+	}
+
+	//the header goes in front of the encoded bytes once their size is known
+	const size_t headerOffset{ m_Chunk.size() };
+	m_Chunk.resize(headerOffset + sizeof(ReplayFrameHeader));
+	EncodeFrame(m_Frame, m_PreviousFrame, m_Chunk);
+
+	ReplayFrameHeader header{};
+	header.DeltaTime = deltaTime;
+	header.RawSize = uint32_t(m_Frame.size());
+	header.EncodedSize = uint32_t(m_Chunk.size() - headerOffset - sizeof(ReplayFrameHeader));
+	memcpy(m_Chunk.data() + headerOffset, &header, sizeof(header));
+
+	m_NrRawBytes += m_Frame.size();
+	++m_NrFrames;
+	++m_NrChunkFrames;
+	m_PreviousFrame.swap(m_Frame);
+	m_Frame.clear();
+	if (m_NrChunkFrames == m_FramesPerChunk)
+	{
+		WriteChunk();
+	}
+}
+
+void ReplayWriter::WriteChunk()
+{
+	if (m_NrChunkFrames == 0)
+	{
+		return;
+	}
+
+	ReplayChunkHeader header{};
+	memcpy(header.Magic, g_ChunkMagic, sizeof(header.Magic));
+	header.NrFrames = m_NrChunkFrames;
+	header.Size = uint32_t(m_Chunk.size());
+	fwrite(&header, sizeof(header), 1, m_pFile);
+	fwrite(m_Chunk.data(), 1, m_Chunk.size(), m_pFile);
+	//a crash after this loses nothing that was written
+	fflush(m_pFile);
+
+	m_NrWrittenBytes += sizeof(header) + m_Chunk.size();
+	m_Chunk.clear();
+	m_NrChunkFrames = 0;
+	//the next chunk starts from nothing, so it can be decoded without this one
+	m_PreviousFrame.clear();
+}
+#pragma endregion
+
+#pragma region Reader
+bool ReplayReader::Open(const std::string& path)
+{
+	Close();
+	if (!m_File.Map(path))
+	{
+		ELITE_LOG_WARNING("Can't open replay file '%s'", path);
+		return false;
+	}
+
+	const uint8_t* pData{ m_File.GetData() };
+	const size_t size{ m_File.GetSize() };
+	ReplayHeader header{};
+	if (size < sizeof(header))
+	{
+		ELITE_LOG_WARNING("Replay file '%s' is too small", path);
+		Close();
+		return false;
+	}
+	memcpy(&header, pData, sizeof(header));
+	if (memcmp(header.Magic, g_FileMagic, sizeof(header.Magic)) != 0 || header.Version != g_Version
+		|| sizeof(header) + header.LevelFileLength > size)
+	{
+		ELITE_LOG_WARNING("Replay file '%s' is not a valid replay", path);
+		Close();
+		return false;
+	}
+	if (header.LayoutHash != GetLayoutHash())
+	{
+		ELITE_LOG_WARNING("Replay file '%s' was recorded by a build with different structs", path);
+		Close();
+		return false;
+	}
+	m_Seed = header.Seed;
+	m_LevelFile.assign(reinterpret_cast<const char*>(pData + sizeof(header)), header.LevelFileLength);
+
+	//counts the frames of the complete chunks, a recording that was cut off ends at the last one
+	const size_t firstChunkOffset{ sizeof(header) + header.LevelFileLength };
+	size_t offset{ firstChunkOffset };
+	ReplayChunkHeader chunk{};
+	while (offset + sizeof(chunk) <= size)
+	{
+		memcpy(&chunk, pData + offset, sizeof(chunk));
+		if (memcmp(chunk.Magic, g_ChunkMagic, sizeof(chunk.Magic)) != 0 || offset + sizeof(chunk) + chunk.Size > size)
+		{
+			ELITE_LOG_WARNING("Replay file '%s' is cut off after %u frames", path, m_NrFrames);
+			break;
+		}
+		m_NrFrames += chunk.NrFrames;
+		offset += sizeof(chunk) + chunk.Size;
+	}
+	m_EndOffset = offset;
+	m_Offset = firstChunkOffset;
+	return true;
+}
+
+void ReplayReader::Close()
+{
+	m_File.Unmap();
+	m_Seed = 0;
+	m_LevelFile.clear();
+	m_NrFrames = 0;
+	m_EndOffset = 0;
+	m_Offset = 0;
+	m_NrChunkFramesLeft = 0;
+	m_FrameIdx = -1;
+	m_DeltaTime = 0.f;
+	m_Frame.clear();
+	m_PreviousFrame.clear();
+	m_ReadOffset = 0;
+}
+
+bool ReplayReader::NextFrame()
+{
+	const uint8_t* pData{ m_File.GetData() };
+	if (m_NrChunkFramesLeft == 0)
+	{
+		if (m_Offset + sizeof(ReplayChunkHeader) > m_EndOffset)
+		{
+			return false;
+		}
+		ReplayChunkHeader chunk{};
+		memcpy(&chunk, pData + m_Offset, sizeof(chunk));
+		m_Offset += sizeof(chunk);
+		m_NrChunkFramesLeft = chunk.NrFrames;
+		m_Frame.clear();
+	}
+
+	ReplayFrameHeader header{};
+	if (m_Offset + sizeof(header) > m_EndOffset)
+	{
+		return false;
+	}
+	memcpy(&header, pData + m_Offset, sizeof(header));
+	m_Offset += sizeof(header);
+	if (m_Offset + header.EncodedSize > m_EndOffset)
+	{
+		return false;
+	}
+
+	m_PreviousFrame.swap(m_Frame);
+	m_Frame.resize(header.RawSize);
+	if (!DecodeFrame(pData + m_Offset, header.EncodedSize, m_PreviousFrame, m_Frame))
+	{
+		ELITE_LOG_WARNING("Replay frame %d is corrupt", m_FrameIdx + 1);
+		return false;
+	}
+	m_Offset += header.EncodedSize;
+	--m_NrChunkFramesLeft;
+	++m_FrameIdx;
+	m_DeltaTime = header.DeltaTime;
+	m_ReadOffset = 0;
+	return true;
+}
+#pragma endregion
@@ -0,0 +1,181 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+#include "MappedFile.h"
+#include <cstring>
+#include <type_traits>
+
+//Every IExamInterface call that answers something, in the order the plugin makes them
+//a record is the call, then its arguments, then its answers, all as raw bytes
+enum class eReplayCall : uint8_t
+{
+	WORLD_GET_INFO,
+	WORLD_GET_STATS,
+	FOV_GET_HOUSE_BY_INDEX,
+	FOV_GET_ENTITY_BY_INDEX,
+	AGENT_GET_INFO,
+	ENEMY_GET_INFO,
+	NAVMESH_GET_CLOSEST_PATH_POINT,
+	INVENTORY_ADD_ITEM,
+	INVENTORY_USE_ITEM,
+	INVENTORY_REMOVE_ITEM,
+	INVENTORY_GET_ITEM,
+	INVENTORY_GET_CAPACITY,
+	ITEM_GET_INFO,
+	ITEM_GRAB,
+	ITEM_DESTROY,
+	WEAPON_GET_AMMO,
+	MEDKIT_GET_HEALTH,
+	FOOD_GET_ENERGY,
+	PURGEZONE_GET_INFO,
+	//not a call, what UpdateSteering returned, the last record of every frame after the first
+	STEERING_OUTPUT,
+
+	//@END
+	_COUNT
+};
+
+const char* GetReplayCallName(eReplayCall call);
+
+//Replay file layout (little endian):
+//	ReplayHeader, then LevelFileLength chars of the level file the episode ran on
+//	chunks until the end of the file, each a ReplayChunkHeader followed by NrFrames frames
+//	a frame is a ReplayFrameHeader followed by EncodedSize bytes
+//frame 0 holds the calls made by Initialize, frame i the calls of the i-th UpdateSteering, ending with its STEERING_OUTPUT
+//a frame is stored as the XOR of its records with those of the frame before it, runs of zeros in that are counted instead of stored
+//the first frame of a chunk is XORed with nothing, so every chunk decodes on its own and a crash only loses the chunk being written
+struct ReplayHeader
+{
+	char Magic[4];
+	uint32_t Version;
+	uint32_t LayoutHash; //sizes of the recorded structs, a build with different ones can't read the file
+	int32_t Seed;
+	uint32_t LevelFileLength;
+};
+
+struct ReplayChunkHeader
+{
+	char Magic[4];
+	uint32_t NrFrames;
+	uint32_t Size; //bytes of frames after this header
+};
+
+struct ReplayFrameHeader
+{
+	float DeltaTime;
+	uint32_t RawSize;
+	uint32_t EncodedSize;
+};
+
+//Appends the frames of one episode to a replay file, a chunk at a time
+//the records of a frame are gathered in memory, the buffers only grow until they fit the biggest frame and chunk
+class ReplayWriter final
+{
+public:
+	ReplayWriter() = default;
+	~ReplayWriter();
+
+	//truncates the file and writes the header, false if it can't be created
+	bool Open(const std::string& path, int seed, const std::string& levelFile);
+	//writes out the chunk being gathered, frames not ended yet are dropped
+	void Close();
+	bool IsOpen() const { return m_pFile != nullptr; }
+
+	template<typename... TValues>
+	void Record(eReplayCall call, const TValues&... values)
+	{
+		Append(&call, sizeof(call));
+		(AppendValue(values), ...);
+	}
+	void EndFrame(float deltaTime);
+
+	uint32_t GetNrFrames() const { return m_NrFrames; }
+	size_t GetNrRawBytes() const { return m_NrRawBytes; }
+	size_t GetNrWrittenBytes() const { return m_NrWrittenBytes; }
+
+	ReplayWriter(const ReplayWriter& other) = delete;
+	ReplayWriter& operator=(const ReplayWriter& rhs) = delete;
+	ReplayWriter(ReplayWriter&& other) = delete;
+	ReplayWriter& operator=(ReplayWriter&& rhs) = delete;
+private:
+	//a chunk every ~4 seconds of game time
+	static const uint32_t m_FramesPerChunk{ 256 };
+
+	void Append(const void* pData, size_t size);
+	//a value is stored as its bytes, ReplayFile.cpp checks that the structs written whole have no padding
+	template<typename TValue>
+	void AppendValue(const TValue& value)
+	{
+		static_assert(std::is_trivially_copyable_v<TValue>, "a recorded value is stored as its raw bytes");
+		Append(&value, sizeof(value));
+	}
+	//these have padding, they're written field by field over zeroed bytes so the padding is the same in every frame and file
+	void AppendValue(const AgentInfo& agentInfo);
+	void AppendValue(const SteeringPlugin_Output& steering);
+	void WriteChunk();
+
+	FILE* m_pFile = nullptr;
+	std::vector<uint8_t> m_Frame; //records of the frame being gathered
+	std::vector<uint8_t> m_PreviousFrame; //what m_Frame is XORed with, empty at the start of a chunk
+	std::vector<uint8_t> m_Chunk; //encoded frames of the chunk being gathered
+	uint32_t m_NrChunkFrames = 0;
+	uint32_t m_NrFrames = 0;
+	size_t m_NrRawBytes = 0;
+	size_t m_NrWrittenBytes = 0;
+};
+
+//Reads a replay file frame by frame, straight from a read-only mapping of it
+class ReplayReader final
+{
+public:
+	ReplayReader() = default;
+	~ReplayReader() = default;
+
+	//false if the file can't be mapped or isn't a replay of this build, a truncated last chunk is left out
+	bool Open(const std::string& path);
+	void Close();
+	bool IsOpen() const { return m_File.IsMapped(); }
+
+	int GetSeed() const { return m_Seed; }
+	const std::string& GetLevelFile() const { return m_LevelFile; }
+	uint32_t GetNrFrames() const { return m_NrFrames; }
+
+	//decodes the next frame, false after the last one or if it's corrupt
+	bool NextFrame();
+	//index of the frame decoded last, -1 before the first
+	int GetFrameIdx() const { return m_FrameIdx; }
+	float GetDeltaTime() const { return m_DeltaTime; }
+	bool IsFrameDone() const { return m_ReadOffset == m_Frame.size(); }
+
+	//the next bytes of the frame, false (and value untouched) if the frame has fewer left
+	template<typename TValue>
+	bool Read(TValue& value)
+	{
+		if (m_ReadOffset + sizeof(TValue) > m_Frame.size())
+		{
+			return false;
+		}
+		memcpy(&value, m_Frame.data() + m_ReadOffset, sizeof(TValue));
+		m_ReadOffset += sizeof(TValue);
+		return true;
+	}
+
+	ReplayReader(const ReplayReader& other) = delete;
+	ReplayReader& operator=(const ReplayReader& rhs) = delete;
+	ReplayReader(ReplayReader&& other) = delete;
+	ReplayReader& operator=(ReplayReader&& rhs) = delete;
+private:
+	MappedFile m_File;
+	int m_Seed = 0;
+	std::string m_LevelFile;
+	uint32_t m_NrFrames = 0;
+	size_t m_EndOffset = 0; //end of the last complete chunk
+
+	size_t m_Offset = 0; //of the next chunk header once m_NrChunkFramesLeft is 0, of the next frame header before that
+	uint32_t m_NrChunkFramesLeft = 0;
+
+	int m_FrameIdx = -1;
+	float m_DeltaTime = 0.f;
+	std::vector<uint8_t> m_Frame;
+	std::vector<uint8_t> m_PreviousFrame;
+	size_t m_ReadOffset = 0;
+};
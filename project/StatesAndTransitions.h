@@ -7,8 +7,10 @@
 #define ELITE_APPLICATION_FSM_STATES_TRANSITIONS
 
 #include "SteeringController.h"
+#include "FlowField.h"
 #include "EFiniteStateMachine.h"
-#include "EBlackboard.h"
+#include "AgentBlackboard.h"
+#include "TargetSelection.h"
 #include "IExamInterface.h"
 
 using namespace Elite;
@@ -19,15 +21,7 @@ public:
 	WanderState() : FSMState() {};
 	virtual void OnEnter(Blackboard* pBlackboard) override
 	{
-		SteeringController* pSteeringController{ nullptr };
-		bool isDataAvailable{ pBlackboard->GetData("SteeringController", pSteeringController) };
-
-		if (!isDataAvailable)
-		{
-			return;
-		}
-
-		pSteeringController->SetToWander();
+		pBlackboard->Get<BB::SteeringController>()->SetToWander();
 	}
 };
 
@@ -37,18 +31,31 @@ public:
 	FleeState() : FSMState() {};
 	virtual void OnEnter(Blackboard* pBlackboard) override
 	{
-		SteeringController* pSteeringController{ nullptr };
-		bool isDataAvailable{ pBlackboard->GetData("SteeringController", pSteeringController) };
-
-		if (!isDataAvailable)
+		Flee(pBlackboard);
+	}
+	virtual void Update(Blackboard* pBlackboard, float deltaTime) override
+	{
+		Flee(pBlackboard);
+	}
+private:
+	//down the threat of every enemy around, away from the one seen first where the threat map is flat
+	//through the context, so it doesn't run into another enemy, a purge zone or a wall on the way,
+	//turned aside from the enemies whose closest approach would catch the agent
+	void Flee(Blackboard* pBlackboard) const
+	{
+		const Elite::Vector2 agentPos{ pBlackboard->Get<BB::Agent>().Position };
+		const SteeringContext& context{ pBlackboard->Get<BB::Context>() };
+		const EnemyFrame& enemies{ pBlackboard->Get<BB::Enemies>() };
+		Elite::Vector2 fleeDirection{};
+		if (!pBlackboard->Get<BB::Threats>().GetFleeDirection(agentPos, fleeDirection))
 		{
+			pBlackboard->Get<BB::SteeringController>()->SetToContextEvade(context, enemies, pBlackboard->Get<BB::Target>());
 			return;
 		}
 
-		TargetData target{};
-		pBlackboard->GetData("Target", target);
-
-		pSteeringController->SetToImperfectFlee(target);
+		TargetData threat{};
+		threat.Position = agentPos - fleeDirection;
+		pBlackboard->Get<BB::SteeringController>()->SetToContextEvade(context, enemies, threat);
 	}
 };
 
@@ -58,72 +65,44 @@ public:
 	EnterHouseState() : FSMState() {};
 	virtual void OnEnter(Blackboard* pBlackboard) override
 	{
-		SteeringController* pSteeringController{ nullptr };
-		bool isDataAvailable{ pBlackboard->GetData("SteeringController", pSteeringController) };
-
-		if (!isDataAvailable)
-		{
-			return;
-		}
-
-		TargetData target{};
-		pBlackboard->GetData("Target", target);
-		
-		pSteeringController->SetToSeek(target);
+		pBlackboard->Get<BB::SteeringController>()->SetToSeek(pBlackboard->Get<BB::Target>());
 	}
 	virtual void Update(Blackboard* pBlackboard, float deltaTime) override
 	{
-		IExamInterface* pInterface{ nullptr };
-		bool isDataAvailable = pBlackboard->GetData("Interface", pInterface);
-		if (!isDataAvailable)
-		{
-			return;
-		}
+		IExamInterface* pInterface{ pBlackboard->Get<BB::Interface>() };
+		TargetData& target{ pBlackboard->Get<BB::Target>() };
 
-		TargetData target{};
-		pBlackboard->GetData("Target", target);
-		
 		//check if agent has arrived
-		const Elite::Vector2 agentPos{ pInterface->Agent_GetInfo().Position };
+		const Elite::Vector2 agentPos{ pBlackboard->Get<BB::Agent>().Position };
 		const float nearbyRange{ 1.f };
 		if (Elite::DistanceSquared(target.Position, agentPos) <= nearbyRange * nearbyRange)
 		{
-			HouseInfo targetHouseInfo{};
-			pBlackboard->GetData("TargetHouse", targetHouseInfo);
+			const HouseInfo& targetHouseInfo{ pBlackboard->Get<BB::TargetHouse>() };
 			//now that agent has arrived at the goal, go to the next closest navmesh point to the house
-			//this will repeat, making the agent get closer and closer to the entrance, until a transition returns true and this state is exited 
+			//this will repeat, making the agent get closer and closer to the entrance, until a transition returns true and this state is exited
 			//(likely because the agent got inside the house)
 			TargetData nextTarget{};
 			nextTarget.Position = pInterface->NavMesh_GetClosestPathPoint(targetHouseInfo.Center);
 			if (nextTarget.Position != target.Position)
 			{
-				SteeringController* pSteeringController{ nullptr };
-				isDataAvailable = pBlackboard->GetData("SteeringController", pSteeringController);
-				if (!isDataAvailable)
-				{
-					return;
-				}
-
-				pSteeringController->SetToSeek(nextTarget);
+				pBlackboard->Get<BB::SteeringController>()->SetToSeek(nextTarget);
 				//mark the previous position as the house entry point, so the agent can exit this way later
-				pBlackboard->ChangeData("HouseEntryPoint", target.Position);
-				pBlackboard->ChangeData("Target", nextTarget);
+				pBlackboard->Get<BB::HouseEntryPoint>() = target.Position;
+				target = nextTarget;
 			}
 		}
 	}
 
 	virtual void OnExit(Blackboard* pBlackboard) override
 	{
-		IExamInterface* pInterface{};
-		bool isDataAvailable = pBlackboard->GetData("Interface", pInterface);
-		if (!isDataAvailable)
+		pBlackboard->Get<BB::HouseEntryPoint>() = pBlackboard->Get<BB::Agent>().Position;
+		//one visit per time the agent walks in, searching again after grabbing an item doesn't count
+		if (pBlackboard->Get<BB::Agent>().IsInHouse)
 		{
-			return;
+			pBlackboard->Get<BB::VisitedHouses>().RegisterVisit(pBlackboard->Get<BB::TargetHouse>(), pBlackboard->Get<BB::Memory>().GetTime());
 		}
-
-		pBlackboard->ChangeData("HouseEntryPoint", pInterface->Agent_GetInfo().Position);
 	}
-	
+
 };
 
 class GrabItemState final : public FSMState
@@ -132,50 +111,39 @@ public:
 	GrabItemState() : FSMState() {};
 	virtual void OnEnter(Blackboard* pBlackboard) override
 	{
-		EntityInfo entityInfo{};
-		pBlackboard->GetData("TargetItem", entityInfo);
-		
-		SteeringController* pSteeringController;
-		bool isDataAvailable = pBlackboard->GetData("SteeringController", pSteeringController);
-		if (!isDataAvailable)
-		{
-			return;
-		}
-
 		TargetData seekTarget{};
-		seekTarget.Position = entityInfo.Location;
-		pSteeringController->SetToSeek(seekTarget);
+		seekTarget.Position = pBlackboard->Get<BB::TargetItem>().Location;
+		pBlackboard->Get<BB::SteeringController>()->SetToSeek(seekTarget);
 	}
 
 	virtual void OnExit(Blackboard* pBlackboard) override
 	{
-		IExamInterface* pInterface{ nullptr };
-		bool isDataAvailable = pBlackboard->GetData("Interface", pInterface);
-		if (!isDataAvailable)
-		{
-			return;
-		}
+		IExamInterface* pInterface{ pBlackboard->Get<BB::Interface>() };
+		const EntityInfo& targetItem{ pBlackboard->Get<BB::TargetItem>() };
+		const AgentInfo& agentInfo{ pBlackboard->Get<BB::Agent>() };
 
-		EntityInfo targetItem{};
-		pBlackboard->GetData("TargetItem", targetItem);
-		AgentInfo agentInfo{ pInterface->Agent_GetInfo() };
-				
 		const Elite::Vector2 agentPos{ agentInfo.Position };
 		const float nearbyRange{ 1.0f };
 		//check if agent has arrived
 		if (Elite::DistanceSquared(targetItem.Location, agentPos) <= nearbyRange * nearbyRange)
 		{
-			EvaluateItem(targetItem, pBlackboard, pInterface);
+			if (EvaluateItem(targetItem, pBlackboard, pInterface))
+			{
+				pBlackboard->Get<BB::VisitedHouses>().RegisterItemGrabbed(pBlackboard->Get<BB::TargetHouse>(), pBlackboard->Get<BB::Memory>().GetTime());
+			}
+			//grabbed, destroyed or not worth a slot, the memory shouldn't pull the agent back to it
+			pBlackboard->Get<BB::Memory>().Forget(targetItem);
 		}
 	}
 private:
-	void EvaluateItem(const EntityInfo& newItemEntityInfo, Blackboard* pBlackboard ,IExamInterface* const pInterface) const
-	{	
+	//returns true if the item ended up in the inventory
+	bool EvaluateItem(const EntityInfo& newItemEntityInfo, Blackboard* pBlackboard ,IExamInterface* const pInterface) const
+	{
 		ItemInfo newItem{};
 		if (!pInterface->Item_GetInfo(newItemEntityInfo, newItem))
 		{
 			//trying to pick up an invalid item
-			return;
+			return false;
 		}
 
 		eItemType newItemType{ newItem.Type };
@@ -183,78 +151,68 @@ private:
 		{
 			//don't pick up garbage
 			pInterface->Item_Destroy(newItemEntityInfo);
-			return;
+			return false;
 		}
 
-		const unsigned int invCapacity{ pInterface->Inventory_GetCapacity() };
-		std::vector<ItemInfo> invItems{};
-		invItems.reserve(invCapacity);
-		invItems.resize(invCapacity);
-		//check inventory
-		for (unsigned int i{ 0 }; i < invCapacity; ++i)
+		InventoryMirror& inventory{ pBlackboard->Get<BB::Inventory>() };
+		int newItemValue{ InventoryMirror::GetItemValue(pInterface, newItem) };
+		//if there's an empty inventory slot, pick up the item
+		const int freeSlot{ InventoryMirror::GetFirstSlot(inventory.GetFreeSlots()) };
+		if (freeSlot != -1)
 		{
-			ItemInfo inventoryItem{};
-			//if there's an empty inventory slot, pick up the item
-			if (!pInterface->Inventory_GetItem(i, inventoryItem))
-			{
-				pInterface->Item_Grab(newItemEntityInfo, newItem);
-				pInterface->Inventory_AddItem(i, newItem);
-				if (newItem.Type == eItemType::PISTOL)
-				{
-					//if this is a pistol, mark it so the agent can use it
-					pBlackboard->ChangeData("WeaponInventoryIndex", int(i));
-				}
-				return;
-			}
-			else
-			{
-				//record the item type in this slot
-				invItems[i] = inventoryItem;
-			}
+			GrabInto(inventory, pInterface, newItemEntityInfo, newItem, newItemValue, freeSlot);
+			return true;
 		}
 
 		//if we've reached this point, there are no empty inventory slots
-		//we need to decide if we should drop or use another item before grabbing this one
-		for (unsigned int i{ 0 }; i < invCapacity; ++i)
+		//we need to decide if we should drop or use another item of the same type before grabbing this one
+		bool isGrabbed{ false };
+		uint32_t sameTypeSlots{ inventory.GetSlots(newItemType) };
+		for (UINT i{ 0 }; sameTypeSlots != 0; ++i, sameTypeSlots >>= 1)
 		{
-			ItemInfo invItem{ invItems[i] };
-			if (invItem.Type == newItemType)
+			if (!(sameTypeSlots & 1u))
+			{
+				continue;
+			}
+			switch (newItemType)
 			{
-				switch (newItemType)
+			case eItemType::FOOD:
+			case eItemType::MEDKIT:
+				if (newItemValue >= inventory.GetValue(i))
 				{
-				case eItemType::FOOD:
-					if (pInterface->Food_GetEnergy(newItem) >= pInterface->Food_GetEnergy(invItem))
-					{
-						pInterface->Inventory_UseItem(i);
-						pInterface->Inventory_RemoveItem(i);
-						pInterface->Item_Grab(newItemEntityInfo, newItem);
-						pInterface->Inventory_AddItem(i, newItem);
-					}
-					break;
-				case eItemType::MEDKIT:
-					if (pInterface->Medkit_GetHealth(newItem) >= pInterface->Medkit_GetHealth(invItem))
-					{
-						pInterface->Inventory_UseItem(i);
-						pInterface->Inventory_RemoveItem(i);
-						pInterface->Item_Grab(newItemEntityInfo, newItem);
-						pInterface->Inventory_AddItem(i, newItem);
-					}
-					break;
-				case eItemType::PISTOL:
-					if (pInterface->Weapon_GetAmmo(newItem) > pInterface->Weapon_GetAmmo(invItem))
-					{
-						pInterface->Inventory_RemoveItem(i);
-						pInterface->Item_Grab(newItemEntityInfo, newItem);
-						pInterface->Inventory_AddItem(i, newItem);
-						pBlackboard->ChangeData("WeaponInventoryIndex", int(i));
-					}
-					break;
-				default:
-					break;
+					inventory.UseItem(pInterface, i);
+					inventory.RemoveItem(pInterface, i);
+					GrabInto(inventory, pInterface, newItemEntityInfo, newItem, newItemValue, i);
+					isGrabbed = true;
+					//using the item changed the agent's health or energy, the cached agent info is stale now
+					pBlackboard->Get<BB::Agent>() = pInterface->Agent_GetInfo();
 				}
+				break;
+			case eItemType::PISTOL:
+				if (newItemValue > inventory.GetValue(i))
+				{
+					inventory.RemoveItem(pInterface, i);
+					GrabInto(inventory, pInterface, newItemEntityInfo, newItem, newItemValue, i);
+					isGrabbed = true;
+				}
+				break;
+			default:
+				break;
 			}
 		}
-	
+		return isGrabbed;
+	}
+
+	//the host can hand over a different item than the one asked for (AutoGrabClosestItem), item and value become the one it handed over
+	void GrabInto(InventoryMirror& inventory, IExamInterface* pInterface, const EntityInfo& itemEntityInfo, ItemInfo& item, int& value, UINT slotId) const
+	{
+		const int requestedHash{ item.ItemHash };
+		pInterface->Item_Grab(itemEntityInfo, item);
+		if (item.ItemHash != requestedHash)
+		{
+			value = InventoryMirror::GetItemValue(pInterface, item);
+		}
+		inventory.AddItem(pInterface, slotId, item, value);
 	}
 };
 
@@ -264,21 +222,11 @@ public:
 	SearchCurrentHouseState() : FSMState() {};
 	virtual void OnEnter(Blackboard* pBlackboard) override
 	{
-		SteeringController* pSteeringController{};
-		bool isDataAvailable = pBlackboard->GetData("SteeringController", pSteeringController);
-		if (!isDataAvailable)
-		{
-			return;
-		}
-
-		
-		HouseInfo houseInfo{};
-		pBlackboard->GetData("TargetHouse", houseInfo);
-
 		//move to house center
+		const HouseInfo& targetHouse{ pBlackboard->Get<BB::TargetHouse>() };
 		TargetData houseCenter{};
-		houseCenter.Position = houseInfo.Center;
-		pSteeringController->SetToSeek(houseCenter);
+		houseCenter.Position = targetHouse.Center;
+		pBlackboard->Get<BB::SteeringController>()->SetToSeek(houseCenter);
 	}
 };
 
@@ -288,19 +236,9 @@ public:
 	ExitCurrentHouseState() : FSMState() {};
 	virtual void OnEnter(Blackboard* pBlackboard) override
 	{
-		SteeringController* pSteeringController{};
-		bool isDataAvailable = pBlackboard->GetData("SteeringController", pSteeringController);
-		if (!isDataAvailable)
-		{
-			return;
-		}
-
-		Elite::Vector2 houseEntryPoint{};
-		pBlackboard->GetData("HouseEntryPoint", houseEntryPoint);
-
 		TargetData target{};
-		target.Position = houseEntryPoint;
-		pSteeringController->SetToSeek(target);
+		target.Position = pBlackboard->Get<BB::HouseEntryPoint>();
+		pBlackboard->Get<BB::SteeringController>()->SetToSeek(target);
 	}
 	virtual void OnExit(Blackboard* pBlackboard) override
 	{
@@ -310,10 +248,8 @@ public:
 		//this makes it so the agent doesn't stick near the house it just looted
 
 		TargetData target{};
-		Elite::Vector2 houseEntryPoint{};
-		pBlackboard->GetData("HouseEntryPoint", houseEntryPoint);
-		target.Position = houseEntryPoint;
-		pBlackboard->ChangeData("Target", target);
+		target.Position = pBlackboard->Get<BB::HouseEntryPoint>();
+		pBlackboard->Get<BB::Target>() = target;
 	}
 };
 
@@ -323,101 +259,45 @@ public:
 	KillZombieState() : FSMState() {};
 	virtual void OnEnter(Blackboard* pBlackboard) override
 	{
-		SteeringController* pSteeringController{};
-		bool isDataAvailable = pBlackboard->GetData("SteeringController", pSteeringController);
-		if (!isDataAvailable)
-		{
-			return;
-		}
-
-		EnemyInfo targetEnemy{};
-		pBlackboard->GetData("TargetEnemy", targetEnemy);
-
 		TargetData target{};
-		target.Position = targetEnemy.Location;
-		pSteeringController->SetToFace(target);
-		pBlackboard->ChangeData("AutoOrient", false);
+		target.Position = pBlackboard->Get<BB::TargetEnemy>().Location;
+		pBlackboard->Get<BB::SteeringController>()->SetToFace(target);
+		pBlackboard->Get<BB::AutoOrient>() = false;
 	}
 
 	virtual void Update(Blackboard* pBlackboard, float deltaTime) override
 	{
-		IExamInterface* pInterface{};
-		bool isDataAvailable = pBlackboard->GetData("Interface", pInterface);
-		if (!isDataAvailable)
-		{
-			return;
-		}
-
-		EnemyInfo targetEnemy{};
-		pBlackboard->GetData("TargetEnemy", targetEnemy);
-		AgentInfo agentInfo{ pInterface->Agent_GetInfo() };
+		IExamInterface* pInterface{ pBlackboard->Get<BB::Interface>() };
+		const AgentInfo& agentInfo{ pBlackboard->Get<BB::Agent>() };
+		InventoryMirror& inventory{ pBlackboard->Get<BB::Inventory>() };
 
 		//check if agent is aiming at the zombie
 		//Face behavior stops rotating when facing the target, so if the angular velocity is 0 that means the agent is facing the target
-		if (Elite::AreEqual(agentInfo.AngularVelocity, 0.f))
-		{			
-			IExamInterface* pInterface{};
-			bool isDataAvailable = pBlackboard->GetData("Interface", pInterface);
-			if (!isDataAvailable)
-			{
-				return;
-			}
-
+		const int weaponSlot{ inventory.GetWeaponSlot() };
+		if (weaponSlot != -1 && Elite::AreEqual(agentInfo.AngularVelocity, 0.f))
+		{
 			//shoot
-			int weaponIdx{};
-			pBlackboard->GetData("WeaponInventoryIndex", weaponIdx);
-			pInterface->Inventory_UseItem(weaponIdx);
+			inventory.UseItem(pInterface, weaponSlot);
 			//decrement shoot counter
-			int nrTimesToShoot{};
-			pBlackboard->GetData("NrTimesToShoot", nrTimesToShoot);
-			pBlackboard->ChangeData("NrTimesToShoot", nrTimesToShoot - 1);
+			--pBlackboard->Get<BB::NrTimesToShoot>();
 		}
 	}
 
 	virtual void OnExit(Blackboard* pBlackboard) override
 	{
-		pBlackboard->ChangeData("AutoOrient", true);
-
-		IExamInterface* pInterface{};
-		bool isDataAvailable = pBlackboard->GetData("Interface", pInterface);
-		if (!isDataAvailable)
-		{
-			return;
-		}
+		pBlackboard->Get<BB::AutoOrient>() = true;
 
-		int weaponIdx{};
-		pBlackboard->GetData("WeaponInventoryIndex", weaponIdx);
+		IExamInterface* pInterface{ pBlackboard->Get<BB::Interface>() };
+		InventoryMirror& inventory{ pBlackboard->Get<BB::Inventory>() };
 
-		//check if this gun has any more ammo
-		ItemInfo weaponInfo{};
-		pInterface->Inventory_GetItem(weaponIdx, weaponInfo);
-		if (pInterface->Weapon_GetAmmo(weaponInfo) <= 0)
+		//throw away the guns that are out of ammo, the mirror moves on to the next one
+		uint32_t pistols{ inventory.GetSlots(eItemType::PISTOL) };
+		for (UINT i{ 0 }; pistols != 0; ++i, pistols >>= 1)
 		{
-			//weapon is empty, throw it away
-			pInterface->Inventory_RemoveItem(weaponIdx);
-
-			//now we need to check if the agent has another gun to use
-			//check all inventory items
-			const unsigned int invCapacity{ pInterface->Inventory_GetCapacity() };
-			for (unsigned int i{ 0 }; i < invCapacity; ++i)
+			if ((pistols & 1u) && inventory.GetValue(i) <= 0)
 			{
-				ItemInfo invItem{};
-
-				if (!pInterface->Inventory_GetItem(i, invItem))
-				{
-					//if this slot is empty, continue
-					continue;
-				}
-
-				if (invItem.Type == eItemType::PISTOL)
-				{
-					//if the agent has a weapon, change weapon index data
-					pBlackboard->ChangeData("WeaponInventoryIndex", int(i));
-					return;
-				}
+				inventory.RemoveItem(pInterface, i);
 			}
-			//if the agent has no other weapon, mark this in the weapon inventory index
-			pBlackboard->ChangeData("WeaponInventoryIndex", -1);
 		}
 	}
 };
@@ -428,25 +308,19 @@ public:
 	GoToWorldCenterState() : FSMState() {};
 	virtual void OnEnter(Blackboard* pBlackboard) override
 	{
-		IExamInterface* pInterface{};
-		bool isDataAvailable = pBlackboard->GetData("Interface", pInterface);
-		if (!isDataAvailable)
+		WorldInfo worldInfo{ pBlackboard->Get<BB::Interface>()->World_GetInfo() };
+		//follow the flow field around the walls if the level has one, a straight line into them otherwise
+		const FlowField* pFlowField{ pBlackboard->Get<BB::FlowField>() };
+		const int goalIdx{ pFlowField ? pFlowField->FindGoal(worldInfo.Center) : -1 };
+		if (goalIdx != -1)
 		{
+			pBlackboard->Get<BB::SteeringController>()->SetToFollowFlow(*pFlowField, goalIdx);
 			return;
 		}
 
-		SteeringController* pSteering{};
-		isDataAvailable = pBlackboard->GetData("SteeringController", pSteering);
-		if (!isDataAvailable)
-		{
-			return;
-		}
-
-		
-		WorldInfo worldInfo{ pInterface->World_GetInfo() };
 		TargetData target{};
 		target.Position = worldInfo.Center;
-		pSteering->SetToSeek(target);
+		pBlackboard->Get<BB::SteeringController>()->SetToSeek(target);
 	}
 };
 
@@ -457,20 +331,10 @@ public:
 	FleePurgeZoneState() : FSMState() {};
 	virtual void OnEnter(Blackboard* pBlackboard) override
 	{
-		SteeringController* pSteeringController{ nullptr };
-		bool isDataAvailable{ pBlackboard->GetData("SteeringController", pSteeringController) };
-
-		if (!isDataAvailable)
-		{
-			return;
-		}
-
-		PurgeZoneInfo targetZone{};
-		pBlackboard->GetData("TargetPurgeZone", targetZone);
-
 		TargetData target{};
-		target.Position = targetZone.Center;
-		pSteeringController->SetToImperfectFlee(target);
+		target.Position = pBlackboard->Get<BB::TargetPurgeZone>().Center;
+		//out of the zone without running into the enemies on the way
+		pBlackboard->Get<BB::SteeringController>()->SetToEvade(pBlackboard->Get<BB::Enemies>(), target);
 	}
 };
 
@@ -481,21 +345,13 @@ public:
 	SeesZombieTransition() : FSMTransition() {};
 	virtual bool ToTransition(Blackboard* pBlackboard) const override
 	{
-		std::vector<EntityInfo> entitiesVect{};
-		pBlackboard->GetData("EntitiesInFOV", entitiesVect);
-
-		for (const EntityInfo& info : entitiesVect)
-		{
-			if (info.Type == eEntityType::ENEMY)
-			{
-				TargetData target{};
-				target.Position = info.Location;
-				pBlackboard->ChangeData("Target", target);
-				return true;					
-			}
-		}
-
-		return false;
+		return !pBlackboard->Get<BB::Perception>().GetEnemies().IsEmpty();
+	}
+	virtual void OnTransition(Blackboard* pBlackboard) const override
+	{
+		TargetData target{};
+		target.Position = pBlackboard->Get<BB::Perception>().GetEnemies().GetLocation(0);
+		pBlackboard->Get<BB::Target>() = target;
 	}
 };
 
@@ -505,84 +361,42 @@ public:
 	CanKillZombieTransition() : FSMTransition() {};
 	virtual bool ToTransition(Blackboard* pBlackboard) const override
 	{
-		std::vector<EntityInfo> entitiesVect{};
-		pBlackboard->GetData("EntitiesInFOV", entitiesVect);
-
-		IExamInterface* pInterface{};
-		bool isDataAvailable = pBlackboard->GetData("Interface", pInterface);
-		//check if the agent has a usable weapon
-		//weapon index of -1 means that the agent doesn't have a weapon
-		int weaponIdx{};
-		pBlackboard->GetData("WeaponInventoryIndex", weaponIdx);
-		
-		if (!isDataAvailable || weaponIdx == -1)
+		const EnemyFrame& enemies{ pBlackboard->Get<BB::Enemies>() };
+		if (enemies.IsEmpty())
 		{
+			//no zombie in view, no need to look at the inventory
 			return false;
 		}
 
-		ItemInfo weaponInfo{};
-		bool wasWeaponFound = pInterface->Inventory_GetItem(weaponIdx, weaponInfo);
-		if (!wasWeaponFound || !(weaponInfo.Type == eItemType::PISTOL))
+		//check if the agent has a weapon at all, a weapon slot of -1 means there is none
+		//the slot can hold a pistol that's out of ammo until KillZombieState throws it away,
+		//only SelectTarget's ammo <= 0 check keeps that empty gun from being chosen
+		const InventoryMirror& inventory{ pBlackboard->Get<BB::Inventory>() };
+		const int weaponSlot{ inventory.GetWeaponSlot() };
+		if (weaponSlot == -1)
 		{
-			if (!ResetWeaponIndex(pBlackboard, pInterface))
-			{
-				//there actually is no weapon in the inventory
-				return false;
-			}
+			return false;
 		}
 
-		for (const EntityInfo& info : entitiesVect)
+		//the best zombie the weapon has enough ammo to kill, only within a certain range (to improve accuracy)
+		const AgentInfo& agentInfo{ pBlackboard->Get<BB::Agent>() };
+		size_t targetIdx{};
+		if (!TargetSelection::SelectTarget(enemies, agentInfo, agentInfo.FOV_Range / 2.f, inventory.GetValue(weaponSlot), targetIdx, m_NrShots))
 		{
-			if (info.Type == eEntityType::ENEMY)
-			{			
-				EnemyInfo enemyInfo{};			
-				pInterface->Enemy_GetInfo(info, enemyInfo);
-				//only shoot when the enemy is within a certain range (to improve accuracy)
-				const float nearbyRange{ pInterface->Agent_GetInfo().FOV_Range / 2.f };
-				if (Elite::DistanceSquared(enemyInfo.Location, pInterface->Agent_GetInfo().Position) >= (nearbyRange * nearbyRange))
-				{
-					continue;
-				}
-				//check if the weapon has enough ammo to kill this zombie			
-				if (enemyInfo.Health <= pInterface->Weapon_GetAmmo(weaponInfo))
-				{
-					pBlackboard->ChangeData("TargetEnemy", enemyInfo);
-					pBlackboard->ChangeData("NrTimesToShoot", enemyInfo.Health);
-					return true;
-				}			
-			}
+			return false;
 		}
-
-		return false;
+		m_TargetEnemy = enemies.Infos[targetIdx];
+		return true;
 	}
-private:
-	//this function gets called if no valid weapon is found when there should have been one
-	//"recalibrates" the weapon index
-	bool ResetWeaponIndex(Blackboard* pBlackboard, IExamInterface* pInterface) const
-	{		
-		//check all inventory items
-		const unsigned int invCapacity{ pInterface->Inventory_GetCapacity() };
-		for (unsigned int i{ 0 }; i < invCapacity; ++i)
-		{
-			ItemInfo invItem{};
-			if (!pInterface->Inventory_GetItem(i, invItem))
-			{
-				//this slot is empty
-				continue;
-			}
-
-			if (invItem.Type == eItemType::PISTOL)
-			{
-				//the proper index for a weapon was found
-				pBlackboard->ChangeData("WeaponInventoryIndex", int(i));
-				return true;
-			}
-		}
-		//the weapon index was set by mistake at one point since there actually is no weapon in the inventory
-		//set the index properly as invalid
-		pBlackboard->ChangeData("WeaponInventoryIndex", -1);
-		return false;
+	virtual void OnTransition(Blackboard* pBlackboard) const override
+	{
+		pBlackboard->Get<BB::TargetEnemy>() = m_TargetEnemy;
+		pBlackboard->Get<BB::NrTimesToShoot>() = m_NrShots;
 	}
+private:
+	//found by ToTransition, committed to the blackboard by OnTransition
+	mutable EnemyInfo m_TargetEnemy{};
+	mutable int m_NrShots{ 0 };
 };
 
 class HasKilledZombieTransition final : public Elite::FSMTransition
@@ -592,9 +406,7 @@ public:
 	virtual bool ToTransition(Blackboard* pBlackboard) const override
 	{
 		//check if agent has finished shooting
-		int nrTimesToShoot{};
-		pBlackboard->GetData("NrTimesToShoot", nrTimesToShoot);
-		return (nrTimesToShoot == 0);
+		return (pBlackboard->Get<BB::NrTimesToShoot>() == 0);
 	}
 };
 
@@ -604,40 +416,32 @@ public:
 	SeesHouseTransition() : FSMTransition() {};
 	virtual bool ToTransition(Blackboard* pBlackboard) const override
 	{
-		std::vector<HouseInfo> housesVect{};
-		pBlackboard->GetData("HousesInFOV", housesVect);
-
-		if (!housesVect.empty())
-		{
-			//make sure not to enter the same house twice in a row
-			HouseInfo prevHouse{};
-			pBlackboard->GetData("TargetHouse", prevHouse);
-			if (housesVect[0].Center == prevHouse.Center)
-			{
-				return false;
-			}
+		const std::vector<HouseInfo>& housesVect{ pBlackboard->Get<BB::Perception>().GetHouses() };
 
-			IExamInterface* pInterface{ nullptr };
-			bool isDataAvailable = pBlackboard->GetData("Interface", pInterface);
-			if (!isDataAvailable)
-			{
-				return false;
-			}
-			//get house info
-			HouseInfo targetHouseInfo{};
-			targetHouseInfo.Center = housesVect[0].Center;
-			targetHouseInfo.Size = housesVect[0].Size;
-			//set initial seek target
-			TargetData target{};
-			target.Position = pInterface->NavMesh_GetClosestPathPoint(targetHouseInfo.Center);
-			pBlackboard->ChangeData("Target", target);
-			//set house info
-			pBlackboard->ChangeData("TargetHouse", targetHouseInfo);
-			return true;
-		}
+		//score every house in view against the ones already searched
+		//never enter the same house twice in a row, nor one that was searched recently
+		m_HouseIdx = pBlackboard->Get<BB::VisitedHouses>().FindBestHouse(housesVect, pBlackboard->Get<BB::Agent>().Position,
+			pBlackboard->Get<BB::Memory>().GetTime(), pBlackboard->Get<BB::TargetHouse>());
+		return m_HouseIdx != -1;
+	}
+	virtual void OnTransition(Blackboard* pBlackboard) const override
+	{
+		const HouseInfo& houseInfo{ pBlackboard->Get<BB::Perception>().GetHouses()[m_HouseIdx] };
 
-		return false;
+		//get house info
+		HouseInfo targetHouseInfo{};
+		targetHouseInfo.Center = houseInfo.Center;
+		targetHouseInfo.Size = houseInfo.Size;
+		//set initial seek target
+		TargetData target{};
+		target.Position = pBlackboard->Get<BB::Interface>()->NavMesh_GetClosestPathPoint(targetHouseInfo.Center);
+		pBlackboard->Get<BB::Target>() = target;
+		//set house info
+		pBlackboard->Get<BB::TargetHouse>() = targetHouseInfo;
 	}
+private:
+	//found by ToTransition, committed to the blackboard by OnTransition
+	mutable int m_HouseIdx{ -1 };
 };
 
 class SeesItemTransition final : public Elite::FSMTransition
@@ -646,22 +450,36 @@ public:
 	SeesItemTransition() : FSMTransition() {};
 	virtual bool ToTransition(Blackboard* pBlackboard) const override
 	{
-		std::vector<EntityInfo> entityVect{};
-		pBlackboard->GetData("EntitiesInFOV", entityVect);
-
-		const int size{ int(entityVect.size()) };
-		for (int i{ 0 }; i < size; ++i)
+		const EntityPartition& items{ pBlackboard->Get<BB::Perception>().GetItems() };
+		if (!items.IsEmpty())
 		{
-			EntityInfo currentInfo{ entityVect[i] };
-			if (currentInfo.Type == eEntityType::ITEM)
-			{
-				pBlackboard->ChangeData("TargetItem", currentInfo);
-				return true;
-			}
+			m_TargetItem = items.GetEntity(0, eEntityType::ITEM);
+			return true;
 		}
 
+		//nothing in view, go back for an item seen earlier in the house being searched (it went out of view while walking through the house)
+		const HouseInfo& targetHouse{ pBlackboard->Get<BB::TargetHouse>() };
+		const Elite::Vector2 halfSize{ targetHouse.Size / 2.f };
+		const RememberedEntity* pItem{ pBlackboard->Get<BB::Memory>().FindNearest(pBlackboard->Get<BB::Agent>().Position, halfSize.Magnitude() * 2.f,
+			[&targetHouse, &halfSize](const RememberedEntity& entity)
+		{
+			const Elite::Vector2 offset{ entity.Info.Location - targetHouse.Center };
+			return entity.Info.Type == eEntityType::ITEM && abs(offset.x) <= halfSize.x && abs(offset.y) <= halfSize.y;
+		}) };
+		if (pItem)
+		{
+			m_TargetItem = pItem->Info;
+			return true;
+		}
 		return false;
 	}
+	virtual void OnTransition(Blackboard* pBlackboard) const override
+	{
+		pBlackboard->Get<BB::TargetItem>() = m_TargetItem;
+	}
+private:
+	//found by ToTransition, committed to the blackboard by OnTransition
+	mutable EntityInfo m_TargetItem{};
 };
 
 class FinishedFleeingTransition final : public FSMTransition
@@ -670,18 +488,10 @@ public:
 	FinishedFleeingTransition() : FSMTransition() {};
 	virtual bool ToTransition(Blackboard* pBlackboard) const override
 	{
-		IExamInterface* pInterface{};
-		bool isDataAvailable = pBlackboard->GetData("Interface", pInterface);
-		if (!isDataAvailable)
-		{
-			return false;
-		}
-
-		TargetData fleeTarget{};
-		pBlackboard->GetData("Target", fleeTarget);
+		const TargetData& fleeTarget{ pBlackboard->Get<BB::Target>() };
 
 		const float requiredDistance{ 40.f };
-		if (DistanceSquared(fleeTarget.Position, pInterface->Agent_GetInfo().Position) >= requiredDistance * requiredDistance)
+		if (DistanceSquared(fleeTarget.Position, pBlackboard->Get<BB::Agent>().Position) >= requiredDistance * requiredDistance)
 		{
 			return true;
 		}
@@ -696,14 +506,7 @@ public:
 	IsInsideHouseTransition() : FSMTransition() {};
 	virtual bool ToTransition(Blackboard* pBlackboard) const override
 	{
-		IExamInterface* pInterface{};
-		bool isDataAvailable = pBlackboard->GetData("Interface", pInterface);
-		if (!isDataAvailable)
-		{
-			return false;
-		}
-
-		return pInterface->Agent_GetInfo().IsInHouse;
+		return pBlackboard->Get<BB::Agent>().IsInHouse;
 	}
 };
 
@@ -713,14 +516,7 @@ public:
 	IsNotInsideHouseTransition() : FSMTransition() {};
 	virtual bool ToTransition(Blackboard* pBlackboard) const override
 	{
-		IExamInterface* pInterface{};
-		bool isDataAvailable = pBlackboard->GetData("Interface", pInterface);
-		if (!isDataAvailable)
-		{
-			return false;
-		}
-
-		return !pInterface->Agent_GetInfo().IsInHouse;
+		return !pBlackboard->Get<BB::Agent>().IsInHouse;
 	}
 };
 
@@ -730,18 +526,10 @@ public:
 	FinishedSearchingHouseTransition() : FSMTransition() {};
 	virtual bool ToTransition(Blackboard* pBlackboard) const override
 	{
-		IExamInterface* pInterface{};
-		bool isDataAvailable = pBlackboard->GetData("Interface", pInterface);
-		if (!isDataAvailable)
-		{
-			return false;
-		}
+		const HouseInfo& targetHouse{ pBlackboard->Get<BB::TargetHouse>() };
 
-		HouseInfo targetHouse{};
-		pBlackboard->GetData("TargetHouse", targetHouse);
-		
 		const float nearbyRange{1.f};
-		if (DistanceSquared(targetHouse.Center, pInterface->Agent_GetInfo().Position) <= nearbyRange * nearbyRange)
+		if (DistanceSquared(targetHouse.Center, pBlackboard->Get<BB::Agent>().Position) <= nearbyRange * nearbyRange)
 		{
 			return true;
 		}
@@ -755,17 +543,9 @@ public:
 	HasGrabbedItemTransition() : FSMTransition() {};
 	virtual bool ToTransition(Blackboard* pBlackboard) const override
 	{
-		IExamInterface* pInterface{};
-		bool isDataAvailable = pBlackboard->GetData("Interface", pInterface);
-		if (!isDataAvailable)
-		{
-			return false;
-		}
+		const EntityInfo& targetItem{ pBlackboard->Get<BB::TargetItem>() };
+		const AgentInfo& agentInfo{ pBlackboard->Get<BB::Agent>() };
 
-		EntityInfo targetItem{};
-		pBlackboard->GetData("TargetItem", targetItem);	
-		AgentInfo agentInfo{ pInterface->Agent_GetInfo() };
-		
 		const float nearbyRange{ 1.f };
 		if (DistanceSquared(targetItem.Location, agentInfo.Position) <= nearbyRange * nearbyRange)
 		{
@@ -781,26 +561,21 @@ public:
 	HasLeftWorldTransition() : FSMTransition() {};
 	virtual bool ToTransition(Blackboard* pBlackboard) const override
 	{
-		IExamInterface* pInterface{};
-		bool isDataAvailable = pBlackboard->GetData("Interface", pInterface);
-		if (!isDataAvailable)
-		{
-			return false;
-		}
+		IExamInterface* pInterface{ pBlackboard->Get<BB::Interface>() };
 
 		//check if agent is outside world
 		WorldInfo worldInfo{ pInterface->World_GetInfo() };
-		Elite::Vector2 agentPos{ pInterface->Agent_GetInfo().Position };
+		const Elite::Vector2 agentPos{ pBlackboard->Get<BB::Agent>().Position };
 		const float worldSize{ 190.f }; //use a separate value because the given world dimensions are too big, agent gets lost easily
 		bool isOutsideWorldX{ agentPos.x < worldInfo.Center.x - worldSize || agentPos.x > worldInfo.Center.x + worldSize };
 		bool isOutsideWorldY{ agentPos.y < worldInfo.Center.y - worldSize || agentPos.y > worldInfo.Center.y + worldSize };
 		if (isOutsideWorldX || isOutsideWorldY)
-		{		
+		{
 			return true;
-			
+
 		}
 
-		return false;		
+		return false;
 	}
 };
 
@@ -810,15 +585,10 @@ public:
 	IsAtWorldCenterTransition() : FSMTransition() {};
 	virtual bool ToTransition(Blackboard* pBlackboard) const override
 	{
-		IExamInterface* pInterface{};
-		bool isDataAvailable = pBlackboard->GetData("Interface", pInterface);
-		if (!isDataAvailable)
-		{
-			return false;
-		}
+		IExamInterface* pInterface{ pBlackboard->Get<BB::Interface>() };
 
 		WorldInfo worldInfo{ pInterface->World_GetInfo() };
-		Elite::Vector2 agentPos{ pInterface->Agent_GetInfo().Position };
+		const Elite::Vector2 agentPos{ pBlackboard->Get<BB::Agent>().Position };
 
 		const float nearbyRange{ 10.f };
 		if (Elite::DistanceSquared(worldInfo.Center, agentPos) <= nearbyRange * nearbyRange)
@@ -835,37 +605,15 @@ public:
 	SeesPurgeZoneTransition() : FSMTransition() {};
 	virtual bool ToTransition(Blackboard* pBlackboard) const override
 	{
-		IExamInterface* pInterface{};
-		bool isDataAvailable = pBlackboard->GetData("Interface", pInterface);
-		if (!isDataAvailable)
-		{
-			return false;
-		}
-
-		std::vector<EntityInfo> entityVect{};
-		pBlackboard->GetData("EntitiesInFOV", entityVect);
-
-		if (entityVect.empty())
-		{
-			return false;
-		}
-
-		const int size{ int(entityVect.size()) };
-		for (int i{ 0 }; i < size; ++i)
-		{
-			EntityInfo currentInfo{ entityVect[i] };
-			if (currentInfo.Type == eEntityType::PURGEZONE)
-			{
-				PurgeZoneInfo zoneInfo{};
-				pInterface->PurgeZone_GetInfo(currentInfo, zoneInfo);
-				pBlackboard->ChangeData("TargetPurgeZone", zoneInfo);
-				return true;
-			}
-		}
-
-		return false;
+		return !pBlackboard->Get<BB::Perception>().GetPurgeZones().IsEmpty();
+	}
+	virtual void OnTransition(Blackboard* pBlackboard) const override
+	{
+		PurgeZoneInfo zoneInfo{};
+		pBlackboard->Get<BB::Interface>()->PurgeZone_GetInfo(pBlackboard->Get<BB::Perception>().GetPurgeZones().GetEntity(0, eEntityType::PURGEZONE), zoneInfo);
+		pBlackboard->Get<BB::TargetPurgeZone>() = zoneInfo;
 	}
-	
+
 };
 
 class HasLeftPurgeZoneTransition final : public Elite::FSMTransition
@@ -874,27 +622,16 @@ public:
 	HasLeftPurgeZoneTransition() : FSMTransition() {};
 	virtual bool ToTransition(Blackboard* pBlackboard) const override
 	{
-		IExamInterface* pInterface{};
-		bool isDataAvailable = pBlackboard->GetData("Interface", pInterface);
-		if (!isDataAvailable)
-		{
-			return false;
-		}
-		
-		PurgeZoneInfo zoneInfo{};
-		if (!pBlackboard->GetData("TargetPurgeZone", zoneInfo))
-		{
-			return false;
-		}
-		Elite::Vector2 agentPos{pInterface->Agent_GetInfo().Position};
+		const PurgeZoneInfo& zoneInfo{ pBlackboard->Get<BB::TargetPurgeZone>() };
+		Elite::Vector2 agentPos{ pBlackboard->Get<BB::Agent>().Position };
 
 		const float extraBufferDistance{ 5.f };
 		if (Elite::DistanceSquared(zoneInfo.Center, agentPos) > (zoneInfo.Radius * zoneInfo.Radius) + 5.f)
 		{
 			return true;
 		}
-		
+
 		return false;
 	}
 };
-#endif
\ No newline at end of file
+#endif
@@ -0,0 +1,241 @@
+#include "stdafx.h"
+#include "SteeringBatch.h"
+#include "SteeringBatchKernels.h"
+#if defined(STEERING_BATCH_X86) && defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+namespace
+{
+	SteeringLanes GetLanes(SteeringBatch& batch)
+	{
+		SteeringLanes lanes{};
+		lanes.Count = batch.Size();
+		lanes.pPositionX = batch.PositionX.data();
+		lanes.pPositionY = batch.PositionY.data();
+		lanes.pVelocityX = batch.VelocityX.data();
+		lanes.pVelocityY = batch.VelocityY.data();
+		lanes.pOrientation = batch.Orientation.data();
+		lanes.pMaxLinearSpeed = batch.MaxLinearSpeed.data();
+		lanes.pMaxAngularSpeed = batch.MaxAngularSpeed.data();
+		lanes.pTargetX = batch.TargetX.data();
+		lanes.pTargetY = batch.TargetY.data();
+		lanes.pWanderAngle = batch.WanderAngle.data();
+		lanes.pWanderAngleDelta = batch.WanderAngleDelta.data();
+		lanes.pLinearVelocityX = batch.LinearVelocityX.data();
+		lanes.pLinearVelocityY = batch.LinearVelocityY.data();
+		lanes.pAngularVelocity = batch.AngularVelocity.data();
+		return lanes;
+	}
+
+#ifdef STEERING_BATCH_X86
+#ifdef _MSC_VER
+	struct CpuFeatures
+	{
+		bool HasAVX2 = false;
+		bool HasAVX512 = false;
+
+		CpuFeatures()
+		{
+			int info[4]{};
+			__cpuid(info, 0);
+			if (info[0] < 7)
+				return;
+
+			__cpuid(info, 1);
+			const bool hasOSXSave{ (info[2] & (1 << 27)) != 0 };
+			const bool hasFMA{ (info[2] & (1 << 12)) != 0 };
+			if (!hasOSXSave)
+				return;
+			//the OS has to save the ymm (and zmm) registers on a context switch
+			const unsigned long long xcr0{ _xgetbv(0) };
+			__cpuidex(info, 7, 0);
+			HasAVX2 = hasFMA && (info[1] & (1 << 5)) != 0 && (xcr0 & 0x6) == 0x6;
+			HasAVX512 = (info[1] & (1 << 16)) != 0 && (xcr0 & 0xE6) == 0xE6;
+		}
+	};
+#else
+	struct CpuFeatures
+	{
+		bool HasAVX2 = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+		bool HasAVX512 = __builtin_cpu_supports("avx512f");
+	};
+#endif
+#endif
+}
+
+#pragma region SteeringBatch
+void SteeringBatch::Resize(size_t nrAgents)
+{
+	for (std::vector<float>* pField : { &PositionX, &PositionY, &VelocityX, &VelocityY, &Orientation, &MaxLinearSpeed, &MaxAngularSpeed,
+		&TargetX, &TargetY, &WanderAngle, &WanderAngleDelta, &LinearVelocityX, &LinearVelocityY, &AngularVelocity })
+	{
+		pField->resize(nrAgents);
+	}
+}
+
+void SteeringBatch::SetAgent(size_t idx, const AgentInfo& agentInfo)
+{
+	PositionX[idx] = agentInfo.Position.x;
+	PositionY[idx] = agentInfo.Position.y;
+	VelocityX[idx] = agentInfo.LinearVelocity.x;
+	VelocityY[idx] = agentInfo.LinearVelocity.y;
+	Orientation[idx] = agentInfo.Orientation;
+	MaxLinearSpeed[idx] = agentInfo.MaxLinearSpeed;
+	MaxAngularSpeed[idx] = agentInfo.MaxAngularSpeed;
+}
+
+void SteeringBatch::SetTarget(size_t idx, const Elite::Vector2& target)
+{
+	TargetX[idx] = target.x;
+	TargetY[idx] = target.y;
+}
+
+SteeringPlugin_Output SteeringBatch::GetSteering(size_t idx) const
+{
+	SteeringPlugin_Output steering{};
+	steering.LinearVelocity = Elite::Vector2{ LinearVelocityX[idx], LinearVelocityY[idx] };
+	steering.AngularVelocity = AngularVelocity[idx];
+	return steering;
+}
+#pragma endregion
+
+#pragma region ScalarKernels
+//the same operations in the same order as Seek, Flee, Face and Wander in SteeringBehaviors.cpp
+size_t SteeringKernels::SeekScalar(const SteeringLanes& lanes, size_t first, float sign)
+{
+	for (size_t i{ first }; i < lanes.Count; ++i)
+	{
+		Elite::Vector2 vectToTarget{ lanes.pTargetX[i] - lanes.pPositionX[i], lanes.pTargetY[i] - lanes.pPositionY[i] };
+		vectToTarget.Normalize();
+		const Elite::Vector2 linearVelocity{ (sign * lanes.pMaxLinearSpeed[i]) * vectToTarget };
+		lanes.pLinearVelocityX[i] = linearVelocity.x;
+		lanes.pLinearVelocityY[i] = linearVelocity.y;
+	}
+	return lanes.Count - first;
+}
+
+size_t SteeringKernels::FaceScalar(const SteeringLanes& lanes, size_t first)
+{
+	const float epsilon{ 0.1f };
+	for (size_t i{ first }; i < lanes.Count; ++i)
+	{
+		const float angleToTarget{ atan2f(lanes.pTargetX[i] - lanes.pPositionX[i], -(lanes.pTargetY[i] - lanes.pPositionY[i])) };
+		const float currentRotation{ lanes.pOrientation[i] };
+		if (currentRotation + epsilon > angleToTarget && currentRotation - epsilon < angleToTarget)
+			lanes.pAngularVelocity[i] = 0.f;
+		else
+			lanes.pAngularVelocity[i] = (int(angleToTarget > currentRotation) * 2 - 1) * lanes.pMaxAngularSpeed[i];
+	}
+	return lanes.Count - first;
+}
+
+size_t SteeringKernels::WanderScalar(const SteeringLanes& lanes, size_t first, float offset, float radius)
+{
+	for (size_t i{ first }; i < lanes.Count; ++i)
+	{
+		const Elite::Vector2 directionVect{ Elite::Vector2{ lanes.pVelocityX[i], lanes.pVelocityY[i] }.GetNormalized() };
+		const Elite::Vector2 circleCenter{ Elite::Vector2{ lanes.pPositionX[i], lanes.pPositionY[i] } + directionVect * offset };
+
+		lanes.pWanderAngle[i] += lanes.pWanderAngleDelta[i];
+		lanes.pTargetX[i] = circleCenter.x + radius * cos(lanes.pWanderAngle[i]);
+		lanes.pTargetY[i] = circleCenter.y + radius * sin(lanes.pWanderAngle[i]);
+	}
+	return SeekScalar(lanes, first, 1.f);
+}
+#pragma endregion
+
+#pragma region BatchSteering
+BatchSteering::BatchSteering(eSteeringKernel kernel)
+	: m_Kernel{ IsKernelSupported(kernel) ? kernel : eSteeringKernel::SCALAR }
+{
+}
+
+void BatchSteering::Seek(SteeringBatch& batch) const
+{
+	const SteeringLanes lanes{ GetLanes(batch) };
+	size_t nrDone{ 0 };
+#ifdef STEERING_BATCH_X86
+	if (m_Kernel == eSteeringKernel::AVX512)
+		nrDone = SteeringKernels::SeekAVX512(lanes, 1.f);
+	else if (m_Kernel == eSteeringKernel::AVX2)
+		nrDone = SteeringKernels::SeekAVX2(lanes, 1.f);
+#endif
+	SteeringKernels::SeekScalar(lanes, nrDone, 1.f);
+}
+
+void BatchSteering::Flee(SteeringBatch& batch) const
+{
+	const SteeringLanes lanes{ GetLanes(batch) };
+	size_t nrDone{ 0 };
+#ifdef STEERING_BATCH_X86
+	if (m_Kernel == eSteeringKernel::AVX512)
+		nrDone = SteeringKernels::SeekAVX512(lanes, -1.f);
+	else if (m_Kernel == eSteeringKernel::AVX2)
+		nrDone = SteeringKernels::SeekAVX2(lanes, -1.f);
+#endif
+	SteeringKernels::SeekScalar(lanes, nrDone, -1.f);
+}
+
+void BatchSteering::Face(SteeringBatch& batch) const
+{
+	const SteeringLanes lanes{ GetLanes(batch) };
+	size_t nrDone{ 0 };
+#ifdef STEERING_BATCH_X86
+	if (m_Kernel == eSteeringKernel::AVX512)
+		nrDone = SteeringKernels::FaceAVX512(lanes);
+	else if (m_Kernel == eSteeringKernel::AVX2)
+		nrDone = SteeringKernels::FaceAVX2(lanes);
+#endif
+	SteeringKernels::FaceScalar(lanes, nrDone);
+}
+
+void BatchSteering::Wander(SteeringBatch& batch, float offset, float radius) const
+{
+	const SteeringLanes lanes{ GetLanes(batch) };
+	size_t nrDone{ 0 };
+#ifdef STEERING_BATCH_X86
+	if (m_Kernel == eSteeringKernel::AVX512)
+		nrDone = SteeringKernels::WanderAVX512(lanes, offset, radius);
+	else if (m_Kernel == eSteeringKernel::AVX2)
+		nrDone = SteeringKernels::WanderAVX2(lanes, offset, radius);
+#endif
+	SteeringKernels::WanderScalar(lanes, nrDone, offset, radius);
+}
+
+bool BatchSteering::IsKernelSupported(eSteeringKernel kernel)
+{
+#ifdef STEERING_BATCH_X86
+	static const CpuFeatures features{};
+	switch (kernel)
+	{
+	case eSteeringKernel::SCALAR: return true;
+	case eSteeringKernel::AVX2: return features.HasAVX2;
+	case eSteeringKernel::AVX512: return features.HasAVX512;
+	default: return false;
+	}
+#else
+	return kernel == eSteeringKernel::SCALAR;
+#endif
+}
+
+eSteeringKernel BatchSteering::GetBestKernel()
+{
+	if (IsKernelSupported(eSteeringKernel::AVX512))
+		return eSteeringKernel::AVX512;
+	if (IsKernelSupported(eSteeringKernel::AVX2))
+		return eSteeringKernel::AVX2;
+	return eSteeringKernel::SCALAR;
+}
+
+const char* BatchSteering::GetKernelName(eSteeringKernel kernel)
+{
+	switch (kernel)
+	{
+	case eSteeringKernel::SCALAR: return "Scalar";
+	case eSteeringKernel::AVX2: return "AVX2";
+	case eSteeringKernel::AVX512: return "AVX-512";
+	default: return "Unknown";
+	}
+}
+#pragma endregion
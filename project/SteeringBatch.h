@@ -0,0 +1,67 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+
+enum class eSteeringKernel
+{
+	SCALAR, //same math as the per agent behaviors, bit for bit
+	AVX2, //8 agents per instruction
+	AVX512, //16 agents per instruction
+
+	//@END
+	_COUNT
+};
+
+//Many agents at once, one array per field, index i is agent i
+//the SIMD kernels use polynomial atan2/sin/cos, they match the per agent behaviors up to float rounding
+//(face can only turn the other way when the angle to the target lies right on its 0.1 rad threshold)
+struct SteeringBatch
+{
+	//input
+	std::vector<float> PositionX;
+	std::vector<float> PositionY;
+	std::vector<float> VelocityX; //wander only
+	std::vector<float> VelocityY; //wander only
+	std::vector<float> Orientation; //face only
+	std::vector<float> MaxLinearSpeed;
+	std::vector<float> MaxAngularSpeed;
+	std::vector<float> TargetX; //wander writes the point it seeks here
+	std::vector<float> TargetY;
+
+	//wander state, the caller draws the random change per agent so the kernels stay branch and rng free
+	std::vector<float> WanderAngle;
+	std::vector<float> WanderAngleDelta;
+
+	//output
+	std::vector<float> LinearVelocityX;
+	std::vector<float> LinearVelocityY;
+	std::vector<float> AngularVelocity;
+
+	size_t Size() const { return PositionX.size(); }
+	void Resize(size_t nrAgents);
+
+	void SetAgent(size_t idx, const AgentInfo& agentInfo);
+	void SetTarget(size_t idx, const Elite::Vector2& target);
+	SteeringPlugin_Output GetSteering(size_t idx) const;
+};
+
+//Seek, Flee, Face and Wander over a SteeringBatch, only the outputs of the behavior that ran are written
+class BatchSteering final
+{
+public:
+	explicit BatchSteering(eSteeringKernel kernel = GetBestKernel());
+
+	void Seek(SteeringBatch& batch) const;
+	void Flee(SteeringBatch& batch) const;
+	void Face(SteeringBatch& batch) const;
+	//offset and radius as in the Wander behavior
+	void Wander(SteeringBatch& batch, float offset = 9.f, float radius = 4.f) const;
+
+	eSteeringKernel GetKernel() const { return m_Kernel; }
+
+	static bool IsKernelSupported(eSteeringKernel kernel);
+	static eSteeringKernel GetBestKernel();
+	static const char* GetKernelName(eSteeringKernel kernel);
+
+private:
+	eSteeringKernel m_Kernel;
+};
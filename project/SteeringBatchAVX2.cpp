@@ -0,0 +1,63 @@
+#include "stdafx.h"
+#include "SteeringBatchKernels.h"
+
+#ifdef STEERING_BATCH_X86
+//only this unit is compiled for AVX2 + FMA, BatchSteering only calls into it after checking the cpu supports them
+#if defined(__GNUC__)
+#pragma GCC target("avx2,fma")
+#endif
+#include <immintrin.h>
+
+namespace
+{
+	struct Avx2Ops
+	{
+		using Float = __m256;
+		using Mask = __m256;
+		static const size_t Width{ 8 };
+
+		static Float Load(const float* pData) { return _mm256_loadu_ps(pData); }
+		static void Store(float* pData, Float value) { _mm256_storeu_ps(pData, value); }
+		static Float Set(float value) { return _mm256_set1_ps(value); }
+
+		static Float Add(Float a, Float b) { return _mm256_add_ps(a, b); }
+		static Float Sub(Float a, Float b) { return _mm256_sub_ps(a, b); }
+		static Float Mul(Float a, Float b) { return _mm256_mul_ps(a, b); }
+		static Float Div(Float a, Float b) { return _mm256_div_ps(a, b); }
+		//a * b + c
+		static Float MulAdd(Float a, Float b, Float c) { return _mm256_fmadd_ps(a, b, c); }
+		static Float Sqrt(Float a) { return _mm256_sqrt_ps(a); }
+		static Float Abs(Float a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.f), a); }
+		static Float Min(Float a, Float b) { return _mm256_min_ps(a, b); }
+		static Float Max(Float a, Float b) { return _mm256_max_ps(a, b); }
+		static Float Round(Float a) { return _mm256_round_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+		static Float Floor(Float a) { return _mm256_floor_ps(a); }
+
+		static Mask GreaterThan(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+		static Mask LessThan(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+		static Mask LessEqual(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_LE_OQ); }
+		static Mask Equal(Float a, Float b) { return _mm256_cmp_ps(a, b, _CMP_EQ_OQ); }
+		static Mask And(Mask a, Mask b) { return _mm256_and_ps(a, b); }
+		static Mask Or(Mask a, Mask b) { return _mm256_or_ps(a, b); }
+		//a where the mask is set, b elsewhere
+		static Float Select(Mask mask, Float a, Float b) { return _mm256_blendv_ps(b, a, mask); }
+	};
+
+#include "SteeringBatchSIMD.inl"
+}
+
+size_t SteeringKernels::SeekAVX2(const SteeringLanes& lanes, float sign)
+{
+	return SeekLanes<Avx2Ops>(lanes, sign);
+}
+
+size_t SteeringKernels::FaceAVX2(const SteeringLanes& lanes)
+{
+	return FaceLanes<Avx2Ops>(lanes);
+}
+
+size_t SteeringKernels::WanderAVX2(const SteeringLanes& lanes, float offset, float radius)
+{
+	return WanderLanes<Avx2Ops>(lanes, offset, radius);
+}
+#endif
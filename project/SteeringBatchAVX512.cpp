@@ -0,0 +1,65 @@
+#include "stdafx.h"
+#include "SteeringBatchKernels.h"
+
+#ifdef STEERING_BATCH_X86
+//only this unit is compiled for AVX-512F, BatchSteering only calls into it after checking the cpu supports it
+#if defined(__GNUC__)
+#pragma GCC target("avx512f")
+//the unmasked intrinsics start from _mm512_undefined_ps(), which some gcc versions report as uninitialized
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#endif
+#include <immintrin.h>
+
+namespace
+{
+	struct Avx512Ops
+	{
+		using Float = __m512;
+		using Mask = __mmask16;
+		static const size_t Width{ 16 };
+
+		static Float Load(const float* pData) { return _mm512_loadu_ps(pData); }
+		static void Store(float* pData, Float value) { _mm512_storeu_ps(pData, value); }
+		static Float Set(float value) { return _mm512_set1_ps(value); }
+
+		static Float Add(Float a, Float b) { return _mm512_add_ps(a, b); }
+		static Float Sub(Float a, Float b) { return _mm512_sub_ps(a, b); }
+		static Float Mul(Float a, Float b) { return _mm512_mul_ps(a, b); }
+		static Float Div(Float a, Float b) { return _mm512_div_ps(a, b); }
+		//a * b + c
+		static Float MulAdd(Float a, Float b, Float c) { return _mm512_fmadd_ps(a, b, c); }
+		static Float Sqrt(Float a) { return _mm512_sqrt_ps(a); }
+		static Float Abs(Float a) { return _mm512_abs_ps(a); }
+		static Float Min(Float a, Float b) { return _mm512_min_ps(a, b); }
+		static Float Max(Float a, Float b) { return _mm512_max_ps(a, b); }
+		static Float Round(Float a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEAREST_INT | _MM_FROUND_NO_EXC); }
+		static Float Floor(Float a) { return _mm512_roundscale_ps(a, _MM_FROUND_TO_NEG_INF | _MM_FROUND_NO_EXC); }
+
+		static Mask GreaterThan(Float a, Float b) { return _mm512_cmp_ps_mask(a, b, _CMP_GT_OQ); }
+		static Mask LessThan(Float a, Float b) { return _mm512_cmp_ps_mask(a, b, _CMP_LT_OQ); }
+		static Mask LessEqual(Float a, Float b) { return _mm512_cmp_ps_mask(a, b, _CMP_LE_OQ); }
+		static Mask Equal(Float a, Float b) { return _mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+		static Mask And(Mask a, Mask b) { return static_cast<Mask>(a & b); }
+		static Mask Or(Mask a, Mask b) { return static_cast<Mask>(a | b); }
+		//a where the mask is set, b elsewhere
+		static Float Select(Mask mask, Float a, Float b) { return _mm512_mask_blend_ps(mask, b, a); }
+	};
+
+#include "SteeringBatchSIMD.inl"
+}
+
+size_t SteeringKernels::SeekAVX512(const SteeringLanes& lanes, float sign)
+{
+	return SeekLanes<Avx512Ops>(lanes, sign);
+}
+
+size_t SteeringKernels::FaceAVX512(const SteeringLanes& lanes)
+{
+	return FaceLanes<Avx512Ops>(lanes);
+}
+
+size_t SteeringKernels::WanderAVX512(const SteeringLanes& lanes, float offset, float radius)
+{
+	return WanderLanes<Avx512Ops>(lanes, offset, radius);
+}
+#endif
@@ -0,0 +1,47 @@
+#pragma once
+//Internal to SteeringBatch, shared by the kernel translation units
+//plain pointers only: the SIMD units are compiled for another instruction set and mustn't instantiate any std templates
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define STEERING_BATCH_X86
+#endif
+
+struct SteeringLanes
+{
+	size_t Count = 0;
+
+	const float* pPositionX = nullptr;
+	const float* pPositionY = nullptr;
+	const float* pVelocityX = nullptr;
+	const float* pVelocityY = nullptr;
+	const float* pOrientation = nullptr;
+	const float* pMaxLinearSpeed = nullptr;
+	const float* pMaxAngularSpeed = nullptr;
+	float* pTargetX = nullptr;
+	float* pTargetY = nullptr;
+	float* pWanderAngle = nullptr;
+	const float* pWanderAngleDelta = nullptr;
+
+	float* pLinearVelocityX = nullptr;
+	float* pLinearVelocityY = nullptr;
+	float* pAngularVelocity = nullptr;
+};
+
+//every kernel returns how many agents it did, always a multiple of its width, the caller does the rest with the scalar kernel
+//sign is 1 for seek and -1 for flee
+namespace SteeringKernels
+{
+	size_t SeekScalar(const SteeringLanes& lanes, size_t first, float sign);
+	size_t FaceScalar(const SteeringLanes& lanes, size_t first);
+	size_t WanderScalar(const SteeringLanes& lanes, size_t first, float offset, float radius);
+
+#ifdef STEERING_BATCH_X86
+	size_t SeekAVX2(const SteeringLanes& lanes, float sign);
+	size_t FaceAVX2(const SteeringLanes& lanes);
+	size_t WanderAVX2(const SteeringLanes& lanes, float offset, float radius);
+
+	size_t SeekAVX512(const SteeringLanes& lanes, float sign);
+	size_t FaceAVX512(const SteeringLanes& lanes);
+	size_t WanderAVX512(const SteeringLanes& lanes, float offset, float radius);
+#endif
+}
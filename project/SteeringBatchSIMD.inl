@@ -0,0 +1,141 @@
+//Internal to SteeringBatch: the SIMD kernels written once against an instruction set wrapper (TOps)
+//included by SteeringBatchAVX2.cpp and SteeringBatchAVX512.cpp inside an anonymous namespace, after their target pragma
+//TOps provides Float, Mask, Width and the operations used below
+
+//atan2(y, x), max error about 1e-7 rad plus float rounding
+template<typename TOps>
+typename TOps::Float Atan2(typename TOps::Float y, typename TOps::Float x)
+{
+	using Float = typename TOps::Float;
+	const Float absX{ TOps::Abs(x) };
+	const Float absY{ TOps::Abs(y) };
+	const Float maxXY{ TOps::Max(absX, absY) };
+	const Float minXY{ TOps::Min(absX, absY) };
+	const Float zero{ TOps::Set(0.f) };
+	const Float one{ TOps::Set(1.f) };
+	//atan of the ratio in [0, 1], both zero gives 0 / 1
+	Float ratio{ TOps::Div(minXY, TOps::Select(TOps::GreaterThan(maxXY, zero), maxXY, one)) };
+
+	//above tan(pi/8) use atan(r) = pi/4 + atan((r - 1) / (r + 1)), so the polynomial only covers [-0.42, 0.42] (cephes atanf)
+	const typename TOps::Mask isAboveEighth{ TOps::GreaterThan(ratio, TOps::Set(0.41421356f)) };
+	ratio = TOps::Select(isAboveEighth, TOps::Div(TOps::Sub(ratio, one), TOps::Add(ratio, one)), ratio);
+	const Float ratioSq{ TOps::Mul(ratio, ratio) };
+	Float poly{ TOps::MulAdd(ratioSq, TOps::Set(8.05374449538e-2f), TOps::Set(-1.38776856032e-1f)) };
+	poly = TOps::MulAdd(poly, ratioSq, TOps::Set(1.99777106478e-1f));
+	poly = TOps::MulAdd(poly, ratioSq, TOps::Set(-3.33329491539e-1f));
+	Float angle{ TOps::MulAdd(TOps::Mul(poly, ratioSq), ratio, ratio) };
+	angle = TOps::Select(isAboveEighth, TOps::Add(angle, TOps::Set(b2_pi / 4.f)), angle);
+
+	angle = TOps::Select(TOps::GreaterThan(absY, absX), TOps::Sub(TOps::Set(b2_pi / 2.f), angle), angle);
+	angle = TOps::Select(TOps::LessThan(x, zero), TOps::Sub(TOps::Set(b2_pi), angle), angle);
+	return TOps::Select(TOps::LessThan(y, zero), TOps::Sub(zero, angle), angle);
+}
+
+//sin and cos together, reduced to [-pi/4, pi/4] per quadrant, max error about 1e-7 for angles up to a few thousand rad
+template<typename TOps>
+void SinCos(typename TOps::Float angle, typename TOps::Float& sinOut, typename TOps::Float& cosOut)
+{
+	using Float = typename TOps::Float;
+	const Float quadrant{ TOps::Round(TOps::Mul(angle, TOps::Set(2.f / b2_pi))) };
+	//pi/2 split in three parts (Cody-Waite), so the reduction stays exact
+	Float r{ TOps::MulAdd(quadrant, TOps::Set(-1.5703125f), angle) };
+	r = TOps::MulAdd(quadrant, TOps::Set(-4.837512969970703125e-4f), r);
+	r = TOps::MulAdd(quadrant, TOps::Set(-7.54978995489188216e-8f), r);
+
+	const Float rSq{ TOps::Mul(r, r) };
+	Float sinR{ TOps::MulAdd(rSq, TOps::Set(-1.9515295891e-4f), TOps::Set(8.3321608736e-3f)) };
+	sinR = TOps::MulAdd(sinR, rSq, TOps::Set(-1.6666654611e-1f));
+	sinR = TOps::MulAdd(TOps::Mul(sinR, rSq), r, r);
+	Float cosR{ TOps::MulAdd(rSq, TOps::Set(2.443315711809948e-5f), TOps::Set(-1.388731625493765e-3f)) };
+	cosR = TOps::MulAdd(cosR, rSq, TOps::Set(4.166664568298827e-2f));
+	cosR = TOps::MulAdd(cosR, TOps::Mul(rSq, rSq), TOps::MulAdd(rSq, TOps::Set(-0.5f), TOps::Set(1.f)));
+
+	//quadrant modulo 4, as a float so no integer lanes are needed
+	const Float quadrantMod{ TOps::Sub(quadrant, TOps::Mul(TOps::Set(4.f), TOps::Floor(TOps::Mul(quadrant, TOps::Set(0.25f))))) };
+	const typename TOps::Mask isOdd{ TOps::Or(TOps::Equal(quadrantMod, TOps::Set(1.f)), TOps::Equal(quadrantMod, TOps::Set(3.f))) };
+	const typename TOps::Mask isSinNegative{ TOps::GreaterThan(quadrantMod, TOps::Set(1.5f)) };
+	const typename TOps::Mask isCosNegative{ TOps::Or(TOps::Equal(quadrantMod, TOps::Set(1.f)), TOps::Equal(quadrantMod, TOps::Set(2.f))) };
+
+	const Float sinAbs{ TOps::Select(isOdd, cosR, sinR) };
+	const Float cosAbs{ TOps::Select(isOdd, sinR, cosR) };
+	const Float zero{ TOps::Set(0.f) };
+	sinOut = TOps::Select(isSinNegative, TOps::Sub(zero, sinAbs), sinAbs);
+	cosOut = TOps::Select(isCosNegative, TOps::Sub(zero, cosAbs), cosAbs);
+}
+
+//v / |v|, zero if |v| <= FLT_EPSILON (Vector2::Normalize)
+template<typename TOps>
+void Normalize(typename TOps::Float& x, typename TOps::Float& y)
+{
+	using Float = typename TOps::Float;
+	const Float length{ TOps::Sqrt(TOps::Add(TOps::Mul(x, x), TOps::Mul(y, y))) };
+	const typename TOps::Mask isZero{ TOps::LessEqual(length, TOps::Set(FLT_EPSILON)) };
+	const Float invLength{ TOps::Div(TOps::Set(1.f), TOps::Select(isZero, TOps::Set(1.f), length)) };
+	x = TOps::Select(isZero, TOps::Set(0.f), TOps::Mul(x, invLength));
+	y = TOps::Select(isZero, TOps::Set(0.f), TOps::Mul(y, invLength));
+}
+
+template<typename TOps>
+size_t SeekLanes(const SteeringLanes& lanes, float sign)
+{
+	using Float = typename TOps::Float;
+	const size_t nrFull{ lanes.Count - lanes.Count % TOps::Width };
+	const Float signVect{ TOps::Set(sign) };
+	for (size_t i{ 0 }; i < nrFull; i += TOps::Width)
+	{
+		Float dirX{ TOps::Sub(TOps::Load(lanes.pTargetX + i), TOps::Load(lanes.pPositionX + i)) };
+		Float dirY{ TOps::Sub(TOps::Load(lanes.pTargetY + i), TOps::Load(lanes.pPositionY + i)) };
+		Normalize<TOps>(dirX, dirY);
+		const Float speed{ TOps::Mul(signVect, TOps::Load(lanes.pMaxLinearSpeed + i)) };
+		TOps::Store(lanes.pLinearVelocityX + i, TOps::Mul(speed, dirX));
+		TOps::Store(lanes.pLinearVelocityY + i, TOps::Mul(speed, dirY));
+	}
+	return nrFull;
+}
+
+template<typename TOps>
+size_t FaceLanes(const SteeringLanes& lanes)
+{
+	using Float = typename TOps::Float;
+	const size_t nrFull{ lanes.Count - lanes.Count % TOps::Width };
+	const Float epsilon{ TOps::Set(0.1f) };
+	for (size_t i{ 0 }; i < nrFull; i += TOps::Width)
+	{
+		const Float dirX{ TOps::Sub(TOps::Load(lanes.pTargetX + i), TOps::Load(lanes.pPositionX + i)) };
+		const Float dirY{ TOps::Sub(TOps::Load(lanes.pTargetY + i), TOps::Load(lanes.pPositionY + i)) };
+		const Float angleToTarget{ Atan2<TOps>(dirX, TOps::Sub(TOps::Set(0.f), dirY)) };
+		const Float currentRotation{ TOps::Load(lanes.pOrientation + i) };
+
+		const typename TOps::Mask isFacing{ TOps::And(TOps::GreaterThan(TOps::Add(currentRotation, epsilon), angleToTarget),
+			TOps::LessThan(TOps::Sub(currentRotation, epsilon), angleToTarget)) };
+		const Float maxAngularSpeed{ TOps::Load(lanes.pMaxAngularSpeed + i) };
+		const Float turn{ TOps::Select(TOps::GreaterThan(angleToTarget, currentRotation), maxAngularSpeed, TOps::Sub(TOps::Set(0.f), maxAngularSpeed)) };
+		TOps::Store(lanes.pAngularVelocity + i, TOps::Select(isFacing, TOps::Set(0.f), turn));
+	}
+	return nrFull;
+}
+
+template<typename TOps>
+size_t WanderLanes(const SteeringLanes& lanes, float offset, float radius)
+{
+	using Float = typename TOps::Float;
+	const size_t nrFull{ lanes.Count - lanes.Count % TOps::Width };
+	const Float offsetVect{ TOps::Set(offset) };
+	const Float radiusVect{ TOps::Set(radius) };
+	for (size_t i{ 0 }; i < nrFull; i += TOps::Width)
+	{
+		Float dirX{ TOps::Load(lanes.pVelocityX + i) };
+		Float dirY{ TOps::Load(lanes.pVelocityY + i) };
+		Normalize<TOps>(dirX, dirY);
+		const Float centerX{ TOps::Add(TOps::Load(lanes.pPositionX + i), TOps::Mul(dirX, offsetVect)) };
+		const Float centerY{ TOps::Add(TOps::Load(lanes.pPositionY + i), TOps::Mul(dirY, offsetVect)) };
+
+		const Float wanderAngle{ TOps::Add(TOps::Load(lanes.pWanderAngle + i), TOps::Load(lanes.pWanderAngleDelta + i)) };
+		TOps::Store(lanes.pWanderAngle + i, wanderAngle);
+		Float sinAngle{}, cosAngle{};
+		SinCos<TOps>(wanderAngle, sinAngle, cosAngle);
+		TOps::Store(lanes.pTargetX + i, TOps::Add(centerX, TOps::Mul(radiusVect, cosAngle)));
+		TOps::Store(lanes.pTargetY + i, TOps::Add(centerY, TOps::Mul(radiusVect, sinAngle)));
+	}
+	return SeekLanes<TOps>(lanes, 1.f);
+}
@@ -15,6 +15,41 @@
 
 using namespace Elite;
 
+#pragma region **STEERING MATH**
+//The math of the behaviors as plain functions, shared with the fused blends in SteeringController
+inline Elite::Vector2 GetSeekVelocity(const Elite::Vector2& target, const AgentInfo& agentInfo)
+{
+	Elite::Vector2 vectToTarget{ target - agentInfo.Position }; //vector from agent to target
+	vectToTarget.Normalize();
+	return agentInfo.MaxLinearSpeed * vectToTarget; //rescale vect to max speed
+}
+
+inline Elite::Vector2 GetFleeVelocity(const Elite::Vector2& target, const AgentInfo& agentInfo)
+{
+	Elite::Vector2 vectToTarget{ target - agentInfo.Position }; //vector from agent to target
+	vectToTarget.Normalize();
+	return -agentInfo.MaxLinearSpeed * vectToTarget; //rescale vect to max speed
+}
+
+inline float GetFaceAngularVelocity(const Elite::Vector2& target, const AgentInfo& agentInfo)
+{
+	const Elite::Vector2 vectToTarget{ target - agentInfo.Position }; //vector from agent to target
+
+	const float angleToTarget{ atan2f(vectToTarget.x, -vectToTarget.y) }; //get angle between target and x axis
+	const float currentRotation{ agentInfo.Orientation };
+
+	//check if agent is facing the target, if so then stop rotating
+	const float epsilon{ 0.1f };
+	if (currentRotation + epsilon > angleToTarget && currentRotation - epsilon < angleToTarget)
+	{
+		return 0.f;
+	}
+	//set angular velocity correctly
+	//1 if true, -1 if false
+	return (int(angleToTarget > currentRotation) * 2 - 1) * agentInfo.MaxAngularSpeed;
+}
+#pragma endregion
+
 #pragma region **ISTEERINGBEHAVIOR** (BASE)
 class ISteeringBehavior
 {
@@ -86,11 +121,17 @@ public:
 
 	//Wander Behavior
 	SteeringPlugin_Output CalculateSteering(float deltaT, const AgentInfo& agentInfo) override;
+	//turns the wander angle and returns the point on the circle to seek this frame
+	Elite::Vector2 GetNextTarget(const AgentInfo& agentInfo);
+	void SetSeed(unsigned int seed) { m_Rng.seed(seed); }
 protected:
 	float m_Offset = 9.f; //distance from agent to circle center
 	float m_Radius = 4.f;
 	float m_AngleChange = ToRadians(45); //max WanderAngle change per frame
 	float m_WanderAngle = 0.f;
+	std::minstd_rand m_Rng{}; //per instance instead of rand(), so agents on different threads don't share state
+
+	float RandomFloat(float max) { return std::uniform_real_distribution<float>{ 0.f, max }(m_Rng); }
 
 	void SetTarget(const TargetData* pTarget) {};//no need to set target, hide this function
 };
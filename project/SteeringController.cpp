@@ -1,58 +1,164 @@
 #include "stdafx.h"
 #include "SteeringController.h"
-#include "SteeringBehaviors.h"
-#include "BlendedSteering.h"
+#include "EProfiler.h"
+#include "FlowField.h"
+#include "EnemyEvasion.h"
 
-SteeringController::SteeringController()
-	:m_pWander{new Wander()}
-	, m_pFlee{new Flee()}
-	, m_pSeek{new Seek()}
-	, m_pFace{new Face()}
-	, m_pImperfectFlee{nullptr}
-	, m_pCurrentSteering{nullptr}
+SteeringPlugin_Output SteeringController::CalculateSteering(const float deltaTime, const AgentInfo& agentInfo)
 {
-	m_pImperfectFlee = new BlendedSteering({ {m_pFlee, 0.8f}, {m_pWander, 0.2f} });
+	ELITE_PROFILE_SCOPE("SteeringController::CalculateSteering");
+	return std::visit([this, &agentInfo](const auto& mode) { return Calculate(mode, agentInfo); }, m_Mode);
 }
 
-SteeringController::~SteeringController()
+void SteeringController::SetRandomSeed(unsigned int seed)
 {
-	delete m_pWander;
-	delete m_pFlee;
-	delete m_pSeek;
-	delete m_pFace;
-	delete m_pImperfectFlee;
-}
-
-SteeringPlugin_Output SteeringController::CalculateSteering(const float deltaTime, const AgentInfo& agentInfo) const
-{
-	return m_pCurrentSteering->CalculateSteering(deltaTime, agentInfo);
+	m_Wander.SetSeed(seed);
 }
 
 void SteeringController::SetToWander()
 {
-	m_pCurrentSteering = m_pWander;
+	m_Mode = WanderMode{};
 }
 
 void SteeringController::SetToFlee(const TargetData& target)
 {
-	m_pCurrentSteering = m_pFlee;
-	m_pFlee->SetTarget(target);
+	m_Mode = FleeMode{ target.Position };
 }
 
 void SteeringController::SetToImperfectFlee(const TargetData& target)
 {
-	m_pCurrentSteering = m_pImperfectFlee;
-	m_pFlee->SetTarget(target);
+	m_Mode = ImperfectFleeMode{ target.Position };
+}
+
+void SteeringController::SetToEvade(const EnemyFrame& enemies, const TargetData& target)
+{
+	m_Mode = EvadeMode{ &enemies, target.Position };
 }
 
 void SteeringController::SetToSeek(const TargetData& target)
 {
-	m_pCurrentSteering = m_pSeek;
-	m_pSeek->SetTarget(target);
+	m_Mode = SeekMode{ target.Position };
 }
 
 void SteeringController::SetToFace(const TargetData& target)
 {
-	m_pCurrentSteering = m_pFace;
-	m_pFace->SetTarget(target);
-}
\ No newline at end of file
+	m_Mode = FaceMode{ target.Position };
+}
+
+void SteeringController::SetToFollowFlow(const FlowField& flowField, int goalIdx)
+{
+	m_Mode = FollowFlowMode{ &flowField, goalIdx };
+}
+
+void SteeringController::SetToContextSeek(const SteeringContext& context, const TargetData& target)
+{
+	m_Mode = ContextMode{ &context, target.Position, false, nullptr };
+}
+
+void SteeringController::SetToContextFlee(const SteeringContext& context, const TargetData& target)
+{
+	m_Mode = ContextMode{ &context, target.Position, true, nullptr };
+}
+
+void SteeringController::SetToContextEvade(const SteeringContext& context, const EnemyFrame& enemies, const TargetData& target)
+{
+	m_Mode = ContextMode{ &context, target.Position, true, &enemies };
+}
+
+SteeringPlugin_Output SteeringController::Calculate(const WanderMode& mode, const AgentInfo& agentInfo)
+{
+	SteeringPlugin_Output steering{};
+	steering.LinearVelocity = GetSeekVelocity(m_Wander.GetNextTarget(agentInfo), agentInfo);
+	return steering;
+}
+
+SteeringPlugin_Output SteeringController::Calculate(const SeekMode& mode, const AgentInfo& agentInfo)
+{
+	SteeringPlugin_Output steering{};
+	steering.LinearVelocity = GetSeekVelocity(mode.Target, agentInfo);
+	return steering;
+}
+
+SteeringPlugin_Output SteeringController::Calculate(const FleeMode& mode, const AgentInfo& agentInfo)
+{
+	SteeringPlugin_Output steering{};
+	steering.LinearVelocity = GetFleeVelocity(mode.Target, agentInfo);
+	return steering;
+}
+
+SteeringPlugin_Output SteeringController::Calculate(const FaceMode& mode, const AgentInfo& agentInfo)
+{
+	SteeringPlugin_Output steering{};
+	steering.AngularVelocity = GetFaceAngularVelocity(mode.Target, agentInfo);
+	return steering;
+}
+
+SteeringPlugin_Output SteeringController::Calculate(const ImperfectFleeMode& mode, const AgentInfo& agentInfo)
+{
+	//what BlendedSteering computed for { Flee, 0.8 }, { Wander, 0.2 }, in the same order so runs stay reproducible
+	//neither behavior turns and the weights add up to 1, so the angular part and the division by the total weight fold away
+	static_assert(ImperfectFleeRecipe::FleeWeight + ImperfectFleeRecipe::WanderWeight == 1.f, "Imperfect flee weights should add up to 1");
+	SteeringPlugin_Output steering{};
+	steering.LinearVelocity = ImperfectFleeRecipe::FleeWeight * GetFleeVelocity(mode.Target, agentInfo);
+	steering.LinearVelocity += ImperfectFleeRecipe::WanderWeight * GetSeekVelocity(m_Wander.GetNextTarget(agentInfo), agentInfo);
+	return steering;
+}
+
+SteeringPlugin_Output SteeringController::Calculate(const EvadeMode& mode, const AgentInfo& agentInfo)
+{
+	SteeringPlugin_Output steering{ Calculate(ImperfectFleeMode{ mode.Target }, agentInfo) };
+	//every enemy on a collision course adds up to a push at full speed
+	steering.LinearVelocity += EnemyEvasion::GetAvoidance(*mode.pEnemies, agentInfo, m_EvadeClearance, m_EvadeHorizon) * agentInfo.MaxLinearSpeed;
+	const float speed{ steering.LinearVelocity.Magnitude() };
+	if (speed > agentInfo.MaxLinearSpeed)
+	{
+		steering.LinearVelocity *= agentInfo.MaxLinearSpeed / speed;
+	}
+	return steering;
+}
+
+SteeringPlugin_Output SteeringController::Calculate(const FollowFlowMode& mode, const AgentInfo& agentInfo)
+{
+	SteeringPlugin_Output steering{};
+	Elite::Vector2 direction{};
+	if (mode.pFlowField->GetDirection(mode.GoalIdx, agentInfo.Position, direction))
+	{
+		steering.LinearVelocity = direction * agentInfo.MaxLinearSpeed;
+	}
+	else
+	{
+		//off the grid or already in the goal's cell
+		steering.LinearVelocity = GetSeekVelocity(mode.pFlowField->GetGoal(mode.GoalIdx), agentInfo);
+	}
+	return steering;
+}
+
+SteeringPlugin_Output SteeringController::Calculate(const ContextMode& mode, const AgentInfo& agentInfo)
+{
+	//the dangers are filled in once per tick by the plugin, the interest is this mode's own
+	SteeringContext context{ *mode.pContext };
+	context.ClearInterest();
+
+	Elite::Vector2 toTarget{ mode.Target - agentInfo.Position };
+	toTarget.Normalize();
+	Elite::Vector2 targetDirection{ mode.IsFleeing ? -toTarget : toTarget };
+	if (mode.pEnemies)
+	{
+		//turned by the push away from every closest approach, the context still keeps it out of the dangerous slots
+		const Elite::Vector2 evadeDirection{ targetDirection + m_ContextEvadeWeight * EnemyEvasion::GetAvoidance(*mode.pEnemies, agentInfo, m_EvadeClearance, m_EvadeHorizon) };
+		if (evadeDirection.SqrtMagnitude() > 1e-4f)
+		{
+			targetDirection = evadeDirection.GetNormalized();
+		}
+	}
+	context.AddInterest(targetDirection, 1.f);
+	Elite::Vector2 wanderDirection{ m_Wander.GetNextTarget(agentInfo) - agentInfo.Position };
+	wanderDirection.Normalize();
+	context.AddInterest(wanderDirection, m_ContextWanderWeight);
+
+	SteeringPlugin_Output steering{};
+	Elite::Vector2 direction{};
+	//every safe slot faces away from where it should go, plain seek or flee then
+	steering.LinearVelocity = (context.ChooseDirection(direction) ? direction : targetDirection) * agentInfo.MaxLinearSpeed;
+	return steering;
+}
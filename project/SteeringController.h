@@ -1,37 +1,80 @@
 #pragma once
+#include <variant>
 #include "Exam_HelperStructs.h"
 #include "SteeringHelpers.h"
+#include "SteeringBehaviors.h"
+#include "ContextSteering.h"
 
-class ISteeringBehavior;
-class Wander;
-class Flee;
-class Seek;
-class Face;
-class BlendedSteering;
+class FlowField;
+struct EnemyFrame;
 
-class SteeringController
+//Blend of flee and wander, the weights are fixed at compile time so the blend is one fused function
+struct ImperfectFleeRecipe
+{
+	static constexpr float FleeWeight{ 0.8f };
+	static constexpr float WanderWeight{ 0.2f };
+};
+
+//Holds the active behavior by value, CalculateSteering dispatches on the variant instead of through ISteeringBehavior pointers
+class SteeringController final
 {
 public:
-	SteeringController();
-	~SteeringController();
+	SteeringController() = default;
+	~SteeringController() = default;
 
 	void SetToWander();
 	void SetToFlee(const TargetData& target);
 	void SetToImperfectFlee(const TargetData& target);
+	//the imperfect flee, pushed aside by every enemy in the frame that's on a collision course with the agent
+	//the frame is read every tick, so it has to outlive this mode
+	void SetToEvade(const EnemyFrame& enemies, const TargetData& target);
 	void SetToSeek(const TargetData& target);
 	void SetToFace(const TargetData& target);
-	SteeringPlugin_Output CalculateSteering(const float deltaTime, const AgentInfo& agentInfo) const;
+	//walks along the field towards one of its goals, the field has to outlive this mode
+	void SetToFollowFlow(const FlowField& flowField, int goalIdx);
+	//towards (or away from) the target with a bit of wander, through the least dangerous slots of the context
+	//the context is read every tick, so it has to outlive this mode, its interest is ignored
+	void SetToContextSeek(const SteeringContext& context, const TargetData& target);
+	void SetToContextFlee(const SteeringContext& context, const TargetData& target);
+	//the context flee, its flee direction turned aside by the enemies in the frame on a collision course like the evade mode's
+	//both are read every tick, so they have to outlive this mode
+	void SetToContextEvade(const SteeringContext& context, const EnemyFrame& enemies, const TargetData& target);
+	SteeringPlugin_Output CalculateSteering(const float deltaTime, const AgentInfo& agentInfo);
+	void SetRandomSeed(unsigned int seed);
 
 	SteeringController(const SteeringController& other) = delete;
 	SteeringController& operator=(const SteeringController& rhs) = delete;
 	SteeringController(SteeringController&& other) = delete;
 	SteeringController& operator=(SteeringController&& rhs) = delete;
 private:
-	Wander* m_pWander;
-	Flee* m_pFlee;
-	Seek* m_pSeek;
-	Face* m_pFace;
-	BlendedSteering* m_pImperfectFlee;
-	ISteeringBehavior* m_pCurrentSteering;
-};
+	struct WanderMode {};
+	struct SeekMode { Elite::Vector2 Target; };
+	struct FleeMode { Elite::Vector2 Target; };
+	struct FaceMode { Elite::Vector2 Target; };
+	struct ImperfectFleeMode { Elite::Vector2 Target; };
+	struct EvadeMode { const EnemyFrame* pEnemies; Elite::Vector2 Target; };
+	struct FollowFlowMode { const FlowField* pFlowField; int GoalIdx; };
+	struct ContextMode { const SteeringContext* pContext; Elite::Vector2 Target; bool IsFleeing; const EnemyFrame* pEnemies; };
+	using SteeringMode = std::variant<WanderMode, SeekMode, FleeMode, FaceMode, ImperfectFleeMode, EvadeMode, FollowFlowMode, ContextMode>;
 
+	//interest of the wander direction next to the target's 1, enough to pick between equally good slots
+	static constexpr float m_ContextWanderWeight{ 0.25f };
+	//how far the context evade mode turns its flee direction per unit of avoidance, the plain evade mode pushes at full speed
+	static constexpr float m_ContextEvadeWeight{ 0.5f };
+	//how far ahead and how wide a berth the evade mode gives the enemies
+	static constexpr float m_EvadeHorizon{ 1.5f };
+	static constexpr float m_EvadeClearance{ 1.f };
+
+	SteeringPlugin_Output Calculate(const WanderMode& mode, const AgentInfo& agentInfo);
+	SteeringPlugin_Output Calculate(const SeekMode& mode, const AgentInfo& agentInfo);
+	SteeringPlugin_Output Calculate(const FleeMode& mode, const AgentInfo& agentInfo);
+	SteeringPlugin_Output Calculate(const FaceMode& mode, const AgentInfo& agentInfo);
+	SteeringPlugin_Output Calculate(const ImperfectFleeMode& mode, const AgentInfo& agentInfo);
+	SteeringPlugin_Output Calculate(const EvadeMode& mode, const AgentInfo& agentInfo);
+	SteeringPlugin_Output Calculate(const FollowFlowMode& mode, const AgentInfo& agentInfo);
+	SteeringPlugin_Output Calculate(const ContextMode& mode, const AgentInfo& agentInfo);
+
+	//the only behavior with state, it keeps its wander angle across mode switches (also while fleeing imperfectly)
+	Wander m_Wander;
+	SteeringMode m_Mode;
+};
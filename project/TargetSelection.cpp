@@ -0,0 +1,160 @@
+#include "stdafx.h"
+#include "TargetSelection.h"
+
+//without SSE2, a 32 bit build without /arch:SSE2, every enemy is scored one at a time
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define TARGET_SELECTION_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace
+{
+	//each term is between -1 and 1 (or 0 and 1), the weights say what it's worth against the others
+	const float g_ProximityWeight{ 1.f }; //1 on top of the agent, 0 at the edge of the range
+	const float g_CostWeight{ 1.f }; //health over ammo, subtracted
+	const float g_FacingWeight{ 0.5f }; //cosine between the agent's forward and the enemy
+	const float g_ClosingWeight{ 0.5f }; //speed towards the agent, over the agent's max speed
+
+	//an enemy closer than this is right on top of the agent, any direction will do
+	const float g_MinDistanceSq{ 1e-4f };
+
+	//what the scoring needs from the agent, worked out once per selection
+	struct ScoreParams
+	{
+		float AgentX, AgentY;
+		float ForwardX, ForwardY;
+		float RangeSq;
+		float InvRange;
+		float Ammo;
+		float InvAmmo;
+		float InvMaxSpeed;
+	};
+
+	//score of one enemy, lowest() if it's out of range or the ammo can't kill it, the SSE path does the same per lane
+	float GetScore(const ScoreParams& params, float x, float y, float velocityX, float velocityY, float health)
+	{
+		const float dx{ x - params.AgentX };
+		const float dy{ y - params.AgentY };
+		const float distanceSq{ dx * dx + dy * dy };
+		if (!(distanceSq < params.RangeSq && health <= params.Ammo))
+		{
+			return std::numeric_limits<float>::lowest();
+		}
+		const float distance{ sqrtf((std::max)(distanceSq, g_MinDistanceSq)) };
+		const float invDistance{ 1.f / distance };
+		const float facing{ (params.ForwardX * dx + params.ForwardY * dy) * invDistance };
+		const float closing{ Elite::Clamp(-(velocityX * dx + velocityY * dy) * invDistance * params.InvMaxSpeed, -1.f, 1.f) };
+		return g_ProximityWeight * (1.f - distance * params.InvRange) - g_CostWeight * (health * params.InvAmmo)
+			+ g_FacingWeight * facing + g_ClosingWeight * closing;
+	}
+}
+
+bool TargetSelection::SelectTarget(const EnemyFrame& enemies, const AgentInfo& agentInfo, float range, int ammo, size_t& targetIdx, int& nrShots)
+{
+	if (ammo <= 0 || range <= 0.f)
+	{
+		return false;
+	}
+
+	const Elite::Vector2 forward{ Elite::OrientationToVector(agentInfo.Orientation) };
+	ScoreParams params{};
+	params.AgentX = agentInfo.Position.x;
+	params.AgentY = agentInfo.Position.y;
+	params.ForwardX = forward.x;
+	params.ForwardY = forward.y;
+	params.RangeSq = range * range;
+	params.InvRange = 1.f / range;
+	params.Ammo = float(ammo);
+	params.InvAmmo = 1.f / float(ammo);
+	params.InvMaxSpeed = agentInfo.MaxLinearSpeed > 0.f ? 1.f / agentInfo.MaxLinearSpeed : 0.f;
+
+	const size_t nrEnemies{ enemies.Size() };
+	float bestScore{ std::numeric_limits<float>::lowest() };
+	size_t bestIdx{ nrEnemies };
+	size_t idx{ 0 };
+#ifdef TARGET_SELECTION_SSE2
+	const __m128 agentX{ _mm_set1_ps(params.AgentX) };
+	const __m128 agentY{ _mm_set1_ps(params.AgentY) };
+	const __m128 forwardX{ _mm_set1_ps(params.ForwardX) };
+	const __m128 forwardY{ _mm_set1_ps(params.ForwardY) };
+	const __m128 rangeSq{ _mm_set1_ps(params.RangeSq) };
+	const __m128 invRange{ _mm_set1_ps(params.InvRange) };
+	const __m128 ammo4{ _mm_set1_ps(params.Ammo) };
+	const __m128 invAmmo{ _mm_set1_ps(params.InvAmmo) };
+	const __m128 invMaxSpeed{ _mm_set1_ps(params.InvMaxSpeed) };
+	const __m128 minDistanceSq{ _mm_set1_ps(g_MinDistanceSq) };
+	const __m128 one4{ _mm_set1_ps(1.f) };
+	const __m128 minusOne4{ _mm_set1_ps(-1.f) };
+	const __m128 proximityWeight{ _mm_set1_ps(g_ProximityWeight) };
+	const __m128 costWeight{ _mm_set1_ps(g_CostWeight) };
+	const __m128 facingWeight{ _mm_set1_ps(g_FacingWeight) };
+	const __m128 closingWeight{ _mm_set1_ps(g_ClosingWeight) };
+	const __m128 lowest4{ _mm_set1_ps(std::numeric_limits<float>::lowest()) };
+	//the best score and its index per lane, the indices as floats are exact far beyond any number of enemies
+	__m128 bestScore4{ lowest4 };
+	__m128 bestIdx4{ _mm_set1_ps(float(nrEnemies)) };
+	__m128 idx4{ _mm_setr_ps(0.f, 1.f, 2.f, 3.f) };
+	const __m128 four4{ _mm_set1_ps(4.f) };
+	for (; idx + 4 <= nrEnemies; idx += 4, idx4 = _mm_add_ps(idx4, four4))
+	{
+		const __m128 dx{ _mm_sub_ps(_mm_loadu_ps(enemies.X.data() + idx), agentX) };
+		const __m128 dy{ _mm_sub_ps(_mm_loadu_ps(enemies.Y.data() + idx), agentY) };
+		const __m128 health{ _mm_loadu_ps(enemies.Health.data() + idx) };
+		const __m128 distanceSq{ _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)) };
+		const __m128 isCandidate{ _mm_and_ps(_mm_cmplt_ps(distanceSq, rangeSq), _mm_cmple_ps(health, ammo4)) };
+		if (_mm_movemask_ps(isCandidate) == 0)
+		{
+			continue;
+		}
+
+		const __m128 distance{ _mm_sqrt_ps(_mm_max_ps(distanceSq, minDistanceSq)) };
+		const __m128 invDistance{ _mm_div_ps(one4, distance) };
+		const __m128 facing{ _mm_mul_ps(_mm_add_ps(_mm_mul_ps(forwardX, dx), _mm_mul_ps(forwardY, dy)), invDistance) };
+		const __m128 velocityX{ _mm_loadu_ps(enemies.VelocityX.data() + idx) };
+		const __m128 velocityY{ _mm_loadu_ps(enemies.VelocityY.data() + idx) };
+		const __m128 towards{ _mm_sub_ps(_mm_setzero_ps(), _mm_add_ps(_mm_mul_ps(velocityX, dx), _mm_mul_ps(velocityY, dy))) };
+		const __m128 closing{ _mm_min_ps(_mm_max_ps(_mm_mul_ps(_mm_mul_ps(towards, invDistance), invMaxSpeed), minusOne4), one4) };
+		__m128 score{ _mm_sub_ps(
+			_mm_mul_ps(proximityWeight, _mm_sub_ps(one4, _mm_mul_ps(distance, invRange))),
+			_mm_mul_ps(costWeight, _mm_mul_ps(health, invAmmo))) };
+		score = _mm_add_ps(_mm_add_ps(score, _mm_mul_ps(facingWeight, facing)), _mm_mul_ps(closingWeight, closing));
+		score = _mm_or_ps(_mm_and_ps(isCandidate, score), _mm_andnot_ps(isCandidate, lowest4));
+
+		//strictly better only, so within a lane the first of equal scores stays
+		const __m128 isBetter{ _mm_cmpgt_ps(score, bestScore4) };
+		bestScore4 = _mm_or_ps(_mm_and_ps(isBetter, score), _mm_andnot_ps(isBetter, bestScore4));
+		bestIdx4 = _mm_or_ps(_mm_and_ps(isBetter, idx4), _mm_andnot_ps(isBetter, bestIdx4));
+	}
+	alignas(16) float laneScores[4];
+	alignas(16) float laneIndices[4];
+	_mm_store_ps(laneScores, bestScore4);
+	_mm_store_ps(laneIndices, bestIdx4);
+	for (int lane{ 0 }; lane < 4; ++lane)
+	{
+		const size_t laneIdx{ size_t(laneIndices[lane]) };
+		if (laneIdx < nrEnemies && (laneScores[lane] > bestScore || (laneScores[lane] == bestScore && laneIdx < bestIdx)))
+		{
+			bestScore = laneScores[lane];
+			bestIdx = laneIdx;
+		}
+	}
+#endif
+	//the enemies past the last full register, strictly better only so a tie with a lane keeps the lane's earlier enemy
+	for (; idx < nrEnemies; ++idx)
+	{
+		const float score{ GetScore(params, enemies.X[idx], enemies.Y[idx], enemies.VelocityX[idx], enemies.VelocityY[idx], enemies.Health[idx]) };
+		if (score > bestScore)
+		{
+			bestScore = score;
+			bestIdx = idx;
+		}
+	}
+
+	if (bestIdx == nrEnemies)
+	{
+		return false;
+	}
+	targetIdx = bestIdx;
+	nrShots = enemies.Infos[bestIdx].Health;
+	return true;
+}
@@ -0,0 +1,12 @@
+#pragma once
+#include "EnemyFrame.h"
+
+//Picking the enemy to shoot, scoring 4 enemies at a time
+//the best target is the one within range the ammo can kill with the highest score, a mix of
+//how close it is, how few shots it takes, how much it's in front of the agent and how straight it's coming at it
+namespace TargetSelection
+{
+	//the best enemy closer than range whose health the ammo covers, and the shots it takes (one per health point)
+	//false if there's no such enemy, ties go to the one added first
+	bool SelectTarget(const EnemyFrame& enemies, const AgentInfo& agentInfo, float range, int ammo, size_t& targetIdx, int& nrShots);
+}
@@ -0,0 +1,364 @@
+#include "stdafx.h"
+#include "ThreatMap.h"
+#include "ThreatMapKernels.h"
+#include "SteeringBatch.h"
+
+//SSE2 is part of every x64 cpu, no dispatch needed like the AVX steering kernels
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define THREAT_MAP_SSE2
+#include <emmintrin.h>
+#endif
+//AVX2 is checked for once in Initialize, with the same cpu check as the steering kernels
+#if defined(__x86_64__) || defined(_M_X64)
+#define THREAT_MAP_AVX2
+#endif
+
+static_assert(ThreatMap::TileSize % 4 == 0, "a tile row is a whole number of SSE registers");
+
+void ThreatMap::Initialize(const WorldInfo& worldInfo, float cellSize, float margin)
+{
+	m_InvCellSize = 1.f / cellSize;
+	m_NrTilesX = int(ceilf((worldInfo.Dimensions.x + 2.f * margin) * m_InvCellSize / TileSize));
+	m_NrTilesY = int(ceilf((worldInfo.Dimensions.y + 2.f * margin) * m_InvCellSize / TileSize));
+	m_Width = m_NrTilesX * TileSize;
+	m_Height = m_NrTilesY * TileSize;
+	m_Stride = m_Width + 2;
+	m_Origin = worldInfo.Center - Elite::Vector2{ float(m_Width), float(m_Height) } * (cellSize / 2.f);
+	m_IsAVX2Supported = BatchSteering::IsKernelSupported(eSteeringKernel::AVX2);
+
+	for (std::vector<float>& buffer : m_Buffers)
+	{
+		buffer.assign(size_t(m_Stride) * (m_Height + 2), 0.f);
+	}
+	m_pFront = m_Buffers[0].data();
+	m_pBack = m_Buffers[1].data();
+
+	const size_t nrTiles{ size_t(m_NrTilesX) * m_NrTilesY };
+	m_DirtyTiles.clear();
+	m_DirtyTiles.reserve(nrTiles);
+	m_UpdatedTiles.clear();
+	m_UpdatedTiles.reserve(nrTiles);
+	m_TileFlags.assign(nrTiles, 0);
+}
+
+void ThreatMap::Clear()
+{
+	for (const Tile& tile : m_DirtyTiles)
+	{
+		ClearTile(m_pFront, tile.X, tile.Y);
+		ClearTile(m_pBack, tile.X, tile.Y);
+		m_TileFlags[tile.Idx] = 0;
+	}
+	m_DirtyTiles.clear();
+}
+
+void ThreatMap::Update(float deltaTime)
+{
+	if (m_DirtyTiles.empty())
+	{
+		return;
+	}
+
+	//the frame time hardly ever changes, expf is a good part of a tick with few dirty tiles
+	if (deltaTime != m_DecayDeltaTime || m_FadeTime != m_DecayFadeTime)
+	{
+		m_Decay = expf(-deltaTime / m_FadeTime);
+		m_DecayDeltaTime = deltaTime;
+		m_DecayFadeTime = m_FadeTime;
+	}
+	const float decay{ m_Decay };
+	const float spread{ (std::min)(m_SpreadRate * deltaTime, 1.f) };
+
+	//the tiles updated now are marked again if they still hold threat, together with the neighbours it spreads into
+	m_UpdatedTiles.swap(m_DirtyTiles);
+	m_DirtyTiles.clear();
+	for (const Tile& tile : m_UpdatedTiles)
+	{
+		m_TileFlags[tile.Idx] &= ~m_DirtyFlag;
+	}
+
+	for (const Tile& tile : m_UpdatedTiles)
+	{
+		const int tileIdx{ tile.Idx };
+		const int tileX{ tile.X };
+		const int tileY{ tile.Y };
+		//a tile splatted since the last update is kept, however little it got, or an enemy that's always in view would never build up
+		const bool isSplatted{ (m_TileFlags[tileIdx] & m_SplattedFlag) != 0 };
+		m_TileFlags[tileIdx] &= ~m_SplattedFlag;
+		float edgeMax[4]{};
+		if (UpdateTile(tileX, tileY, decay, spread, edgeMax) < m_MinTileThreat && !isSplatted)
+		{
+			//faded out, unless a neighbour still spreads into it
+			continue;
+		}
+
+		MarkDirty(tileX, tileY);
+		if (edgeMax[0] >= m_MinTileThreat && tileX + 1 < m_NrTilesX)
+		{
+			MarkDirty(tileX + 1, tileY);
+		}
+		if (edgeMax[1] >= m_MinTileThreat && tileY + 1 < m_NrTilesY)
+		{
+			MarkDirty(tileX, tileY + 1);
+		}
+		if (edgeMax[2] >= m_MinTileThreat && tileX > 0)
+		{
+			MarkDirty(tileX - 1, tileY);
+		}
+		if (edgeMax[3] >= m_MinTileThreat && tileY > 0)
+		{
+			MarkDirty(tileX, tileY - 1);
+		}
+	}
+
+	//every tile that isn't dirty is zero in both buffers, the spread reads across tile borders without checking
+	//the tiles that faded out are only cleared now, their neighbours were still reading them
+	for (const Tile& tile : m_UpdatedTiles)
+	{
+		if (!(m_TileFlags[tile.Idx] & m_DirtyFlag))
+		{
+			ClearTile(m_pFront, tile.X, tile.Y);
+			ClearTile(m_pBack, tile.X, tile.Y);
+		}
+	}
+	std::swap(m_pFront, m_pBack);
+}
+
+void ThreatMap::Splat(const EnemyInfo& enemyInfo, float deltaTime)
+{
+	//framerate independent, the decay takes off deltaTime / m_FadeTime of the threat every tick as well
+	const float threat{ deltaTime / m_FadeTime };
+	AddThreat(enemyInfo.Location, threat * 0.5f);
+	AddThreat(enemyInfo.Location + enemyInfo.LinearVelocity * m_PredictionTime, threat * 0.5f);
+}
+
+float ThreatMap::Sample(const Elite::Vector2& position) const
+{
+	const Elite::Vector2 gridPos{ ToGrid(position) };
+	const int cellX{ int(floorf(gridPos.x)) };
+	const int cellY{ int(floorf(gridPos.y)) };
+	//the border cells are readable, so a position up to half a cell outside the grid still interpolates
+	if (cellX < -1 || cellX >= m_Width || cellY < -1 || cellY >= m_Height)
+	{
+		return 0.f;
+	}
+
+	const float tX{ gridPos.x - cellX };
+	const float tY{ gridPos.y - cellY };
+	const float* pCell{ m_pFront + GetIdx(cellX, cellY) };
+	const float bottom{ pCell[0] + (pCell[1] - pCell[0]) * tX };
+	const float top{ pCell[m_Stride] + (pCell[m_Stride + 1] - pCell[m_Stride]) * tX };
+	return bottom + (top - bottom) * tY;
+}
+
+bool ThreatMap::GetFleeDirection(const Elite::Vector2& position, Elite::Vector2& direction) const
+{
+	const Elite::Vector2 gridPos{ ToGrid(position) };
+	const int cellX{ int(floorf(gridPos.x)) };
+	const int cellY{ int(floorf(gridPos.y)) };
+	if (cellX < -1 || cellX >= m_Width || cellY < -1 || cellY >= m_Height)
+	{
+		return false;
+	}
+
+	//the gradient of the bilinear interpolation between the 4 cell centers around position
+	const float tX{ gridPos.x - cellX };
+	const float tY{ gridPos.y - cellY };
+	const float* pCell{ m_pFront + GetIdx(cellX, cellY) };
+	const float bottomLeft{ pCell[0] };
+	const float bottomRight{ pCell[1] };
+	const float topLeft{ pCell[m_Stride] };
+	const float topRight{ pCell[m_Stride + 1] };
+	if ((std::max)((std::max)(bottomLeft, bottomRight), (std::max)(topLeft, topRight)) < m_MinFleeThreat)
+	{
+		return false;
+	}
+
+	const Elite::Vector2 gradient
+	{
+		(bottomRight - bottomLeft) * (1.f - tY) + (topRight - topLeft) * tY,
+		(topLeft - bottomLeft) * (1.f - tX) + (topRight - bottomRight) * tX
+	};
+	if (gradient.SqrtMagnitude() < FLT_EPSILON * FLT_EPSILON)
+	{
+		return false;
+	}
+	direction = -gradient.GetNormalized();
+	return true;
+}
+
+Elite::Vector2 ThreatMap::ToGrid(const Elite::Vector2& position) const
+{
+	return Elite::Vector2{ (position.x - m_Origin.x) * m_InvCellSize - 0.5f, (position.y - m_Origin.y) * m_InvCellSize - 0.5f };
+}
+
+void ThreatMap::AddThreat(const Elite::Vector2& position, float threat)
+{
+	//split over the 4 cells around position, the same weights Sample reads back with
+	const Elite::Vector2 gridPos{ ToGrid(position) };
+	const int cellX{ int(floorf(gridPos.x)) };
+	const int cellY{ int(floorf(gridPos.y)) };
+	if (cellX < -1 || cellX >= m_Width || cellY < -1 || cellY >= m_Height)
+	{
+		return;
+	}
+
+	const float tX{ gridPos.x - cellX };
+	const float tY{ gridPos.y - cellY };
+	for (int offsetY{ 0 }; offsetY < 2; ++offsetY)
+	{
+		const int y{ cellY + offsetY };
+		if (y < 0 || y >= m_Height)
+		{
+			continue;
+		}
+		for (int offsetX{ 0 }; offsetX < 2; ++offsetX)
+		{
+			const int x{ cellX + offsetX };
+			if (x < 0 || x >= m_Width)
+			{
+				continue;
+			}
+			const float weight{ (offsetX ? tX : 1.f - tX) * (offsetY ? tY : 1.f - tY) };
+			m_pFront[GetIdx(x, y)] += threat * weight;
+		}
+	}
+
+	//the next update spreads the 4 cells into their neighbours, those can lie in the next tile
+	const int firstTileX{ (std::max)(cellX - 1, 0) / TileSize };
+	const int lastTileX{ (std::min)(cellX + 2, m_Width - 1) / TileSize };
+	const int firstTileY{ (std::max)(cellY - 1, 0) / TileSize };
+	const int lastTileY{ (std::min)(cellY + 2, m_Height - 1) / TileSize };
+	for (int tileY{ firstTileY }; tileY <= lastTileY; ++tileY)
+	{
+		for (int tileX{ firstTileX }; tileX <= lastTileX; ++tileX)
+		{
+			MarkDirty(tileX, tileY);
+			m_TileFlags[tileY * m_NrTilesX + tileX] |= m_SplattedFlag;
+		}
+	}
+}
+
+void ThreatMap::MarkDirty(int tileX, int tileY)
+{
+	const int tileIdx{ tileY * m_NrTilesX + tileX };
+	if (!(m_TileFlags[tileIdx] & m_DirtyFlag))
+	{
+		m_TileFlags[tileIdx] |= m_DirtyFlag;
+		m_DirtyTiles.push_back(Tile{ tileX, tileY, tileIdx });
+	}
+}
+
+float ThreatMap::UpdateTile(int tileX, int tileY, float decay, float spread, float edgeMax[4])
+{
+	//every cell moves spread of the way towards the average of its 4 neighbours, then decays
+	const float keep{ decay * (1.f - spread) };
+	const float share{ decay * spread * 0.25f };
+	//locals, the stores through pOut could alias the members as far as the compiler knows
+	const int stride{ m_Stride };
+	const int firstIdx{ GetIdx(tileX * TileSize, tileY * TileSize) };
+	const float* pIn{ m_pFront + firstIdx };
+	float* pOut{ m_pBack + firstIdx };
+
+#ifdef THREAT_MAP_AVX2
+	static_assert(TileSize == 8, "the AVX2 kernel does a tile row per register");
+	if (m_IsAVX2Supported)
+	{
+		return ThreatMapKernels::UpdateTileAVX2(pIn, pOut, stride, keep, share, m_MinCellThreat, edgeMax);
+	}
+#endif
+
+#ifdef THREAT_MAP_SSE2
+	const __m128 keep4{ _mm_set1_ps(keep) };
+	const __m128 share4{ _mm_set1_ps(share) };
+	const __m128 minCellThreat4{ _mm_set1_ps(m_MinCellThreat) };
+	//a column of 4 cells wide at a time, walking up the rows, a row's cells are the one above's neighbours below
+	//so every step only loads the row above and the left and right neighbours
+	//per column the maximum over the rows, lane 0 of the first one is the left edge and lane 3 of the last one the right edge
+	__m128 columnMax4[TileSize / 4];
+	__m128 bottom4{ _mm_setzero_ps() };
+	__m128 top4{ _mm_setzero_ps() };
+	for (int column{ 0 }; column < TileSize / 4; ++column)
+	{
+		const float* pColumnIn{ pIn + 4 * column };
+		float* pColumnOut{ pOut + 4 * column };
+		__m128 below4{ _mm_loadu_ps(pColumnIn - stride) };
+		__m128 center4{ _mm_loadu_ps(pColumnIn) };
+		__m128 max4{ _mm_setzero_ps() };
+		for (int row{ 0 }; row < TileSize; ++row)
+		{
+			const int idx{ row * stride };
+			const __m128 above4{ _mm_loadu_ps(pColumnIn + idx + stride) };
+			const __m128 neighbours{ _mm_add_ps(
+				_mm_add_ps(_mm_loadu_ps(pColumnIn + idx - 1), _mm_loadu_ps(pColumnIn + idx + 1)),
+				_mm_add_ps(below4, above4)) };
+			__m128 threat{ _mm_add_ps(_mm_mul_ps(keep4, center4), _mm_mul_ps(share4, neighbours)) };
+			threat = _mm_and_ps(threat, _mm_cmpge_ps(threat, minCellThreat4));
+			_mm_storeu_ps(pColumnOut + idx, threat);
+			max4 = _mm_max_ps(max4, threat);
+			if (row == 0)
+			{
+				bottom4 = _mm_max_ps(bottom4, threat);
+			}
+			below4 = center4;
+			center4 = above4;
+		}
+		top4 = _mm_max_ps(top4, _mm_loadu_ps(pColumnOut + (TileSize - 1) * stride));
+		columnMax4[column] = max4;
+	}
+	__m128 max4{ columnMax4[0] };
+	for (int column{ 1 }; column < TileSize / 4; ++column)
+	{
+		max4 = _mm_max_ps(max4, columnMax4[column]);
+	}
+
+	//the horizontal maximum of each, in every lane
+	const auto getMax{ [](__m128 value4)
+	{
+		value4 = _mm_max_ps(value4, _mm_shuffle_ps(value4, value4, _MM_SHUFFLE(1, 0, 3, 2)));
+		return _mm_cvtss_f32(_mm_max_ps(value4, _mm_shuffle_ps(value4, value4, _MM_SHUFFLE(2, 3, 0, 1))));
+	} };
+	const __m128 lastColumn4{ columnMax4[TileSize / 4 - 1] };
+	edgeMax[0] = _mm_cvtss_f32(_mm_shuffle_ps(lastColumn4, lastColumn4, _MM_SHUFFLE(3, 3, 3, 3)));
+	edgeMax[1] = getMax(top4);
+	edgeMax[2] = _mm_cvtss_f32(columnMax4[0]);
+	edgeMax[3] = getMax(bottom4);
+	return getMax(max4);
+#else
+	float tileMax{ 0.f };
+	for (int row{ 0 }; row < TileSize; ++row)
+	{
+		for (int column{ row * stride }; column < row * stride + TileSize; ++column)
+		{
+			const float neighbours{ pIn[column - 1] + pIn[column + 1] + pIn[column - stride] + pIn[column + stride] };
+			const float threat{ keep * pIn[column] + share * neighbours };
+			pOut[column] = threat >= m_MinCellThreat ? threat : 0.f;
+			tileMax = (std::max)(tileMax, pOut[column]);
+		}
+	}
+
+	const int last{ TileSize - 1 };
+	float right{ 0.f }, top{ 0.f }, left{ 0.f }, bottom{ 0.f };
+	for (int i{ 0 }; i < TileSize; ++i)
+	{
+		right = (std::max)(right, pOut[i * stride + last]);
+		top = (std::max)(top, pOut[last * stride + i]);
+		left = (std::max)(left, pOut[i * stride]);
+		bottom = (std::max)(bottom, pOut[i]);
+	}
+	edgeMax[0] = right;
+	edgeMax[1] = top;
+	edgeMax[2] = left;
+	edgeMax[3] = bottom;
+	return tileMax;
+#endif
+}
+
+void ThreatMap::ClearTile(float* pBuffer, int tileX, int tileY)
+{
+	float* pRow{ pBuffer + GetIdx(tileX * TileSize, tileY * TileSize) };
+	for (int row{ 0 }; row < TileSize; ++row, pRow += m_Stride)
+	{
+		std::fill(pRow, pRow + TileSize, 0.f);
+	}
+}
@@ -0,0 +1,92 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+
+//How dangerous every spot of the level is, as a grid of floats covering the world
+//every enemy seen is splatted where it is and where its velocity takes it, every tick the whole map decays and spreads out to the neighbouring cells
+//so an enemy that went out of view keeps fading and blurring around where it was last seen, without having to be splatted again
+//the grid is split into tiles of TileSize x TileSize cells, only tiles with threat in them (dirty) are decayed and spread, the rest is all zeros
+//a tile is updated with AVX2 when the cpu has it and SSE2 otherwise, both give the same map
+//sized once by Initialize, it never allocates after that
+class ThreatMap final
+{
+public:
+	static const int TileSize{ 8 };
+
+	//covers the world plus margin on every side
+	void Initialize(const WorldInfo& worldInfo, float cellSize = 4.f, float margin = 20.f);
+	void Clear();
+
+	//seconds for the threat of an enemy that's no longer seen to fade to a third
+	void SetFadeTime(float fadeTime) { m_FadeTime = fadeTime; }
+	//fraction of the difference with the average of its 4 neighbours a cell takes over per second
+	void SetSpreadRate(float spreadRate) { m_SpreadRate = spreadRate; }
+	//how far ahead an enemy's velocity is followed
+	void SetPredictionTime(float predictionTime) { m_PredictionTime = predictionTime; }
+
+	//decays and spreads the dirty tiles, call once per tick before splatting the enemies seen in it
+	void Update(float deltaTime);
+	//adds an enemy seen this tick, half at its location and half at the predicted one
+	//an enemy standing in view builds up to about 0.1 at its cell, the spread carries the rest around it
+	void Splat(const EnemyInfo& enemyInfo, float deltaTime);
+
+	//threat at position, interpolated between the cell centers
+	float Sample(const Elite::Vector2& position) const;
+	//downhill direction of the threat at position, false if there's (next to) no threat there or it's flat
+	bool GetFleeDirection(const Elite::Vector2& position, Elite::Vector2& direction) const;
+
+	size_t GetNrDirtyTiles() const { return m_DirtyTiles.size(); }
+
+private:
+	//below this a tile counts as empty and is cleared, well below what a single tick of an enemy adds
+	static constexpr float m_MinTileThreat{ 1e-4f };
+	//and a cell below this is flushed to zero, a long tail of ever smaller values would end in denormals, which are very slow to compute with
+	static constexpr float m_MinCellThreat{ 1e-7f };
+	//less than this isn't worth fleeing from
+	static constexpr float m_MinFleeThreat{ 1e-3f };
+
+	//index into the buffers of grid cell (cellX, cellY), the buffers have a border of one zero cell all around
+	int GetIdx(int cellX, int cellY) const { return (cellY + 1) * m_Stride + cellX + 1; }
+	//position in cell units, relative to the center of cell (0, 0)
+	Elite::Vector2 ToGrid(const Elite::Vector2& position) const;
+	void AddThreat(const Elite::Vector2& position, float threat);
+	void MarkDirty(int tileX, int tileY);
+	//writes the decayed and spread tile into m_pBack, returns its maximum and the maximum along each of its edges (right, top, left, bottom)
+	float UpdateTile(int tileX, int tileY, float decay, float spread, float edgeMax[4]);
+	void ClearTile(float* pBuffer, int tileX, int tileY);
+
+	Elite::Vector2 m_Origin{}; //lower left corner of the grid
+	float m_InvCellSize{ 1.f };
+	int m_Width{ 0 }; //in cells, a multiple of TileSize
+	int m_Height{ 0 };
+	int m_Stride{ 0 };
+	int m_NrTilesX{ 0 };
+	int m_NrTilesY{ 0 };
+
+	float m_FadeTime{ 2.f };
+	float m_SpreadRate{ 4.f };
+	float m_PredictionTime{ 0.5f };
+	bool m_IsAVX2Supported{ false };
+	//expf(-m_DecayDeltaTime / m_DecayFadeTime)
+	float m_Decay{ 1.f };
+	float m_DecayDeltaTime{ 0.f };
+	float m_DecayFadeTime{ 0.f };
+
+	//double buffered, a tick reads m_pFront and writes m_pBack, then swaps them
+	std::vector<float> m_Buffers[2];
+	float* m_pFront{ nullptr };
+	float* m_pBack{ nullptr };
+
+	//the coordinates are kept next to the index, getting them back out of it costs a division per tile
+	struct Tile
+	{
+		int X;
+		int Y;
+		int Idx; //Y * m_NrTilesX + X
+	};
+	std::vector<Tile> m_DirtyTiles;
+	std::vector<Tile> m_UpdatedTiles;
+	//per tile, m_DirtyFlag while it's in m_DirtyTiles, m_SplattedFlag once an enemy was splatted into it since the last update
+	static const uint8_t m_DirtyFlag{ 1 };
+	static const uint8_t m_SplattedFlag{ 2 };
+	std::vector<uint8_t> m_TileFlags;
+};
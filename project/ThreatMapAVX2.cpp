@@ -0,0 +1,62 @@
+#include "stdafx.h"
+#include "ThreatMapKernels.h"
+
+#if defined(__x86_64__) || defined(_M_X64)
+//only this unit is compiled for AVX2, ThreatMap only calls into it after checking the cpu supports it
+//no FMA on purpose, a fused multiply-add rounds differently from the SSE2 loop
+#if defined(__GNUC__)
+#pragma GCC target("avx2")
+#endif
+#include <immintrin.h>
+
+namespace
+{
+	float GetMax(__m256 value8)
+	{
+		__m128 value4{ _mm_max_ps(_mm256_castps256_ps128(value8), _mm256_extractf128_ps(value8, 1)) };
+		value4 = _mm_max_ps(value4, _mm_shuffle_ps(value4, value4, _MM_SHUFFLE(1, 0, 3, 2)));
+		return _mm_cvtss_f32(_mm_max_ps(value4, _mm_shuffle_ps(value4, value4, _MM_SHUFFLE(2, 3, 0, 1))));
+	}
+}
+
+float ThreatMapKernels::UpdateTileAVX2(const float* pIn, float* pOut, int stride, float keep, float share, float minCellThreat, float edgeMax[4])
+{
+	const __m256 keep8{ _mm256_set1_ps(keep) };
+	const __m256 share8{ _mm256_set1_ps(share) };
+	const __m256 minCellThreat8{ _mm256_set1_ps(minCellThreat) };
+
+	//walking up the rows, a row's cells are the one above's neighbours below, so every row only loads the row above and its left and right neighbours
+	__m256 below8{ _mm256_loadu_ps(pIn - stride) };
+	__m256 center8{ _mm256_loadu_ps(pIn) };
+	__m256 bottom8{};
+	__m256 top8{};
+	__m256 columnMax8{ _mm256_setzero_ps() };
+	for (int row{ 0 }; row < 8; ++row)
+	{
+		const int idx{ row * stride };
+		const __m256 above8{ _mm256_loadu_ps(pIn + idx + stride) };
+		const __m256 neighbours{ _mm256_add_ps(
+			_mm256_add_ps(_mm256_loadu_ps(pIn + idx - 1), _mm256_loadu_ps(pIn + idx + 1)),
+			_mm256_add_ps(below8, above8)) };
+		__m256 threat{ _mm256_add_ps(_mm256_mul_ps(keep8, center8), _mm256_mul_ps(share8, neighbours)) };
+		threat = _mm256_and_ps(threat, _mm256_cmp_ps(threat, minCellThreat8, _CMP_GE_OQ));
+		_mm256_storeu_ps(pOut + idx, threat);
+		columnMax8 = _mm256_max_ps(columnMax8, threat);
+		if (row == 0)
+		{
+			bottom8 = threat;
+		}
+		top8 = threat;
+		below8 = center8;
+		center8 = above8;
+	}
+
+	//lane 0 of the column maxima is the left edge, lane 7 the right one
+	const __m128 highColumns4{ _mm256_extractf128_ps(columnMax8, 1) };
+	edgeMax[0] = _mm_cvtss_f32(_mm_shuffle_ps(highColumns4, highColumns4, _MM_SHUFFLE(3, 3, 3, 3)));
+	edgeMax[1] = GetMax(top8);
+	edgeMax[2] = _mm_cvtss_f32(_mm256_castps256_ps128(columnMax8));
+	edgeMax[3] = GetMax(bottom8);
+	return GetMax(columnMax8);
+}
+#endif
@@ -0,0 +1,10 @@
+#pragma once
+//Internal to ThreatMap, shared with the AVX2 translation unit
+//plain pointers only, like the steering kernels: that unit is compiled for another instruction set and mustn't instantiate any std templates
+
+namespace ThreatMapKernels
+{
+	//decays and spreads an 8x8 tile from pIn into pOut, one tile row per register, returns the tile's maximum and the maximum along each edge (right, top, left, bottom)
+	//the same math as the SSE2 loop in ThreatMap::UpdateTile, bit for bit, so the map doesn't depend on which cpu ran it
+	float UpdateTileAVX2(const float* pIn, float* pOut, int stride, float keep, float share, float minCellThreat, float edgeMax[4]);
+}
@@ -0,0 +1,229 @@
+#include "stdafx.h"
+#include "WorldMemory.h"
+#include "PerceptionFrame.h"
+#include "EProfiler.h"
+
+namespace
+{
+	void RememberPartition(WorldMemory& memory, const EntityPartition& partition, eEntityType type)
+	{
+		for (size_t i{ 0 }; i < partition.Size(); ++i)
+		{
+			memory.Remember(partition.GetEntity(i, type));
+		}
+	}
+}
+
+WorldMemory::WorldMemory(float cellSize)
+	: m_CellSize{ cellSize }
+	, m_InvCellSize{ 1.f / cellSize }
+{
+	//enemies walk around, after a few seconds their position says little
+	m_Lifetimes[int(eEntityType::ENEMY)] = 5.f;
+	m_Lifetimes[int(eEntityType::ITEM)] = 600.f;
+	m_Lifetimes[int(eEntityType::PURGEZONE)] = 30.f;
+	ResizeBuckets(64);
+}
+
+void WorldMemory::Reserve(size_t nrEntities)
+{
+	m_Entries.reserve(nrEntities);
+	m_EntryIndices.Reserve(nrEntities);
+	//about two entries per bucket when full
+	size_t nrBuckets{ 64 };
+	while (2 * nrBuckets < nrEntities)
+	{
+		nrBuckets *= 2;
+	}
+	if (nrBuckets > m_Buckets.size())
+	{
+		ResizeBuckets(nrBuckets);
+	}
+}
+
+void WorldMemory::Clear()
+{
+	m_Entries.clear();
+	m_EntryIndices.Clear();
+	std::fill(m_Buckets.begin(), m_Buckets.end(), -1);
+	m_SweepCursor = 0;
+	m_Time = 0.f;
+}
+
+void WorldMemory::Update(const PerceptionFrame& perception, const AgentInfo& agentInfo, float deltaTime)
+{
+	ELITE_PROFILE_SCOPE("WorldMemory::Update");
+	m_Time += deltaTime;
+
+	RememberPartition(*this, perception.GetEnemies(), eEntityType::ENEMY);
+	RememberPartition(*this, perception.GetItems(), eEntityType::ITEM);
+	RememberPartition(*this, perception.GetPurgeZones(), eEntityType::PURGEZONE);
+
+	ForgetUnseenInFront(agentInfo);
+	SweepExpired();
+}
+
+void WorldMemory::Remember(const EntityInfo& entityInfo)
+{
+	bool isAdded{};
+	int& entryIdx{ m_EntryIndices.FindOrAdd(GetKey(entityInfo), isAdded) };
+	if (isAdded)
+	{
+		entryIdx = int(m_Entries.size());
+		RememberedEntity entity{};
+		entity.Info = entityInfo;
+		entity.LastSeenTime = m_Time;
+		entity.CellX = GetCellCoordinate(entityInfo.Location.x);
+		entity.CellY = GetCellCoordinate(entityInfo.Location.y);
+		m_Entries.push_back(entity);
+		Link(entryIdx);
+
+		//keep the buckets at about two entries each, doubling keeps the rehash cost amortized O(1)
+		if (m_Entries.size() > 2 * m_Buckets.size())
+		{
+			ResizeBuckets(2 * m_Buckets.size());
+		}
+		return;
+	}
+
+	RememberedEntity& entity{ m_Entries[entryIdx] };
+	entity.Info.Location = entityInfo.Location;
+	entity.LastSeenTime = m_Time;
+	const int cellX{ GetCellCoordinate(entityInfo.Location.x) };
+	const int cellY{ GetCellCoordinate(entityInfo.Location.y) };
+	if (cellX != entity.CellX || cellY != entity.CellY)
+	{
+		Unlink(entryIdx);
+		entity.CellX = cellX;
+		entity.CellY = cellY;
+		Link(entryIdx);
+	}
+}
+
+void WorldMemory::Forget(const EntityInfo& entityInfo)
+{
+	const int* pEntryIdx{ m_EntryIndices.Find(GetKey(entityInfo)) };
+	if (pEntryIdx)
+	{
+		Remove(*pEntryIdx);
+	}
+}
+
+const RememberedEntity* WorldMemory::Find(const EntityInfo& entityInfo) const
+{
+	const int* pEntryIdx{ m_EntryIndices.Find(GetKey(entityInfo)) };
+	return pEntryIdx ? &m_Entries[*pEntryIdx] : nullptr;
+}
+
+void WorldMemory::Link(int entryIdx)
+{
+	RememberedEntity& entity{ m_Entries[entryIdx] };
+	int& bucketHead{ m_Buckets[GetBucket(entity.CellX, entity.CellY)] };
+	entity.PrevInBucket = -1;
+	entity.NextInBucket = bucketHead;
+	if (bucketHead != -1)
+	{
+		m_Entries[bucketHead].PrevInBucket = entryIdx;
+	}
+	bucketHead = entryIdx;
+}
+
+void WorldMemory::Unlink(int entryIdx)
+{
+	const RememberedEntity& entity{ m_Entries[entryIdx] };
+	if (entity.PrevInBucket != -1)
+	{
+		m_Entries[entity.PrevInBucket].NextInBucket = entity.NextInBucket;
+	}
+	else
+	{
+		m_Buckets[GetBucket(entity.CellX, entity.CellY)] = entity.NextInBucket;
+	}
+	if (entity.NextInBucket != -1)
+	{
+		m_Entries[entity.NextInBucket].PrevInBucket = entity.PrevInBucket;
+	}
+}
+
+void WorldMemory::Remove(int entryIdx)
+{
+	Unlink(entryIdx);
+	m_EntryIndices.Erase(GetKey(m_Entries[entryIdx].Info));
+
+	//move the last entry into the gap, so the entries stay dense
+	const int lastIdx{ int(m_Entries.size()) - 1 };
+	if (entryIdx != lastIdx)
+	{
+		Unlink(lastIdx);
+		m_Entries[entryIdx] = m_Entries[lastIdx];
+		Link(entryIdx);
+		*m_EntryIndices.Find(GetKey(m_Entries[entryIdx].Info)) = entryIdx;
+	}
+	m_Entries.pop_back();
+}
+
+void WorldMemory::ResizeBuckets(size_t nrBuckets)
+{
+	m_Buckets.assign(nrBuckets, -1);
+	for (int entryIdx{ 0 }; entryIdx < int(m_Entries.size()); ++entryIdx)
+	{
+		Link(entryIdx);
+	}
+}
+
+void WorldMemory::SweepExpired()
+{
+	//a few entries per update, so forgetting never costs a spike
+	for (size_t i{ 0 }; i < m_NrSweptPerUpdate && !m_Entries.empty(); ++i)
+	{
+		if (m_SweepCursor >= m_Entries.size())
+		{
+			m_SweepCursor = 0;
+		}
+		if (IsExpired(m_Entries[m_SweepCursor]))
+		{
+			//the last entry moves into this slot, check it next
+			Remove(int(m_SweepCursor));
+			continue;
+		}
+		++m_SweepCursor;
+	}
+}
+
+void WorldMemory::ForgetUnseenInFront(const AgentInfo& agentInfo)
+{
+	//close by and inside the view cone a wall rarely blocks the view, so an entity that isn't seen there is taken to be gone (grabbed, destroyed or walked off)
+	const float checkedRange{ (std::min)(5.f, agentInfo.FOV_Range) };
+	const Elite::Vector2 lookDirection{ Elite::OrientationToVector(agentInfo.Orientation) };
+	const float cosHalfAngle{ cosf(agentInfo.FOV_Angle / 2.f) };
+	const size_t maxForgotten{ 8 };
+	int forgottenIndices[maxForgotten];
+	size_t nrForgotten{ 0 };
+	QueryRadius(agentInfo.Position, checkedRange, [&](const RememberedEntity& entity)
+	{
+		if (IsSeenThisFrame(entity))
+		{
+			return true;
+		}
+		const Elite::Vector2 toEntity{ entity.Info.Location - agentInfo.Position };
+		const float distance{ toEntity.Magnitude() };
+		if (distance > 0.f && Elite::Dot(lookDirection, toEntity) < cosHalfAngle * distance)
+		{
+			return true;
+		}
+		//removing moves entries around, keep the indices sorted from high to low so they're removed from the back first
+		const int entryIdx{ int(&entity - m_Entries.data()) };
+		size_t insertIdx{ nrForgotten++ };
+		for (; insertIdx > 0 && forgottenIndices[insertIdx - 1] < entryIdx; --insertIdx)
+		{
+			forgottenIndices[insertIdx] = forgottenIndices[insertIdx - 1];
+		}
+		forgottenIndices[insertIdx] = entryIdx;
+		return nrForgotten < maxForgotten;
+	});
+
+	for (size_t i{ 0 }; i < nrForgotten; ++i)
+	{
+		Remove(forgottenIndices[i]);
+	}
+}
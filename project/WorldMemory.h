@@ -0,0 +1,188 @@
+#pragma once
+#include "Exam_HelperStructs.h"
+#include "EOpenHashMap.h"
+
+class PerceptionFrame;
+
+//An entity the agent has seen, where and when it was seen last
+struct RememberedEntity
+{
+	EntityInfo Info;
+	float LastSeenTime;
+
+	//spatial hash bookkeeping, the entries of a grid bucket form a doubly linked list through the entry array
+	int CellX;
+	int CellY;
+	int PrevInBucket;
+	int NextInBucket;
+};
+
+//Everything the agent has seen and not forgotten yet, keyed by entity type + hash
+//entries are stored densely and linked into a uniform grid of cellSize x cellSize cells, the cells are hashed into a fixed bucket array
+//so the world doesn't need to be bounded, remembering, moving and forgetting an entity are O(1)
+//entries expire after the lifetime of their type, expired entries are skipped by the queries and swept out a few per update
+class WorldMemory final
+{
+public:
+	explicit WorldMemory(float cellSize = 16.f);
+
+	//after this, remembering up to nrEntities entities doesn't allocate
+	void Reserve(size_t nrEntities);
+	void Clear();
+
+	//seconds an entity of this type is remembered after it was last seen, items lie still so they're kept a lot longer than enemies
+	void SetLifetime(eEntityType type, float lifetime) { m_Lifetimes[int(type)] = lifetime; }
+	float GetLifetime(eEntityType type) const { return m_Lifetimes[int(type)]; }
+
+	//advances the clock, remembers everything in the frame and forgets what should have been seen right in front of the agent but wasn't
+	void Update(const PerceptionFrame& perception, const AgentInfo& agentInfo, float deltaTime);
+	void Remember(const EntityInfo& entityInfo);
+	void Forget(const EntityInfo& entityInfo);
+
+	float GetTime() const { return m_Time; }
+	//includes expired entries that weren't swept out yet
+	size_t Size() const { return m_Entries.size(); }
+	const RememberedEntity* Find(const EntityInfo& entityInfo) const;
+	bool IsExpired(const RememberedEntity& entity) const { return m_Time - entity.LastSeenTime > m_Lifetimes[int(entity.Info.Type)]; }
+	bool IsSeenThisFrame(const RememberedEntity& entity) const { return entity.LastSeenTime == m_Time; }
+
+	//calls visitor(entity) for every entity that hasn't expired within radius of center, stops early when the visitor returns false
+	template<typename Visitor>
+	void QueryRadius(const Elite::Vector2& center, float radius, Visitor visitor) const;
+	//closest entity within maxDistance that hasn't expired and for which filter(entity) returns true, nullptr if there is none
+	template<typename Filter>
+	const RememberedEntity* FindNearest(const Elite::Vector2& position, float maxDistance, Filter filter) const;
+
+private:
+	static uint64_t GetKey(const EntityInfo& entityInfo) { return (uint64_t(entityInfo.Type) << 32) | uint32_t(entityInfo.EntityHash); }
+	int GetCellCoordinate(float position) const { return int(floorf(position * m_InvCellSize)); }
+	size_t GetBucket(int cellX, int cellY) const
+	{
+		//two large primes, so neighbouring cells land in unrelated buckets
+		return (uint32_t(cellX) * 73856093u ^ uint32_t(cellY) * 19349663u) & (m_Buckets.size() - 1);
+	}
+
+	void Link(int entryIdx);
+	void Unlink(int entryIdx);
+	void Remove(int entryIdx);
+	void ResizeBuckets(size_t nrBuckets);
+	void SweepExpired();
+	void ForgetUnseenInFront(const AgentInfo& agentInfo);
+
+	//visits the entries linked into every cell overlapping the box, stops early when the visitor returns false
+	template<typename Visitor>
+	bool VisitCells(int minCellX, int minCellY, int maxCellX, int maxCellY, Visitor visitor) const;
+
+	const float m_CellSize;
+	const float m_InvCellSize;
+	float m_Time{ 0.f };
+	float m_Lifetimes[int(eEntityType::_LAST) + 1];
+
+	std::vector<RememberedEntity> m_Entries;
+	std::vector<int> m_Buckets; //first entry in each bucket, -1 if empty
+	Elite::OpenHashMap<uint64_t, int> m_EntryIndices; //key to index in m_Entries
+	size_t m_SweepCursor{ 0 };
+
+	static const size_t m_NrSweptPerUpdate{ 32 };
+};
+
+#pragma region WorldMemory Templates
+template<typename Visitor>
+bool WorldMemory::VisitCells(int minCellX, int minCellY, int maxCellX, int maxCellY, Visitor visitor) const
+{
+	//a box spanning more cells than there are buckets would visit buckets more than once, then one pass over all entries is cheaper
+	const int64_t nrCells{ (int64_t(maxCellX) - minCellX + 1) * (int64_t(maxCellY) - minCellY + 1) };
+	if (nrCells > int64_t(m_Buckets.size()))
+	{
+		for (const RememberedEntity& entity : m_Entries)
+		{
+			const bool isInBox{ entity.CellX >= minCellX && entity.CellX <= maxCellX && entity.CellY >= minCellY && entity.CellY <= maxCellY };
+			if (isInBox && !visitor(entity))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	for (int cellY{ minCellY }; cellY <= maxCellY; ++cellY)
+	{
+		for (int cellX{ minCellX }; cellX <= maxCellX; ++cellX)
+		{
+			for (int entryIdx{ m_Buckets[GetBucket(cellX, cellY)] }; entryIdx != -1; entryIdx = m_Entries[entryIdx].NextInBucket)
+			{
+				//other cells can share the bucket
+				const RememberedEntity& entity{ m_Entries[entryIdx] };
+				if (entity.CellX == cellX && entity.CellY == cellY && !visitor(entity))
+				{
+					return false;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+template<typename Visitor>
+void WorldMemory::QueryRadius(const Elite::Vector2& center, float radius, Visitor visitor) const
+{
+	const float radiusSq{ radius * radius };
+	VisitCells(GetCellCoordinate(center.x - radius), GetCellCoordinate(center.y - radius), GetCellCoordinate(center.x + radius), GetCellCoordinate(center.y + radius),
+		[this, &center, radiusSq, &visitor](const RememberedEntity& entity)
+	{
+		if (IsExpired(entity) || Elite::DistanceSquared(entity.Info.Location, center) > radiusSq)
+		{
+			return true;
+		}
+		return bool(visitor(entity));
+	});
+}
+
+template<typename Filter>
+const RememberedEntity* WorldMemory::FindNearest(const Elite::Vector2& position, float maxDistance, Filter filter) const
+{
+	const RememberedEntity* pNearest{ nullptr };
+	float nearestDistanceSq{ maxDistance * maxDistance };
+	const auto visitEntity = [this, &position, &pNearest, &nearestDistanceSq, &filter](const RememberedEntity& entity)
+	{
+		const float distanceSq{ Elite::DistanceSquared(entity.Info.Location, position) };
+		if (distanceSq <= nearestDistanceSq && !IsExpired(entity) && filter(entity))
+		{
+			pNearest = &entity;
+			nearestDistanceSq = distanceSq;
+		}
+		return true;
+	};
+
+	//grow square rings of cells around the position, every cell of ring n+1 is at least n cells away
+	//so once something is found closer than that, the search can stop
+	const int centerX{ GetCellCoordinate(position.x) };
+	const int centerY{ GetCellCoordinate(position.y) };
+	const int maxRing{ int(ceilf(maxDistance * m_InvCellSize)) };
+	for (int ring{ 0 }; ring <= maxRing; ++ring)
+	{
+		if (pNearest && nearestDistanceSq <= (ring - 1) * m_CellSize * (ring - 1) * m_CellSize)
+		{
+			break;
+		}
+		if ((2 * ring + 1) * (2 * ring + 1) > int(m_Buckets.size()))
+		{
+			//the rings have become larger than the bucket array, finish with one pass over everything that's left
+			VisitCells(centerX - maxRing, centerY - maxRing, centerX + maxRing, centerY + maxRing, visitEntity);
+			break;
+		}
+
+		if (ring == 0)
+		{
+			VisitCells(centerX, centerY, centerX, centerY, visitEntity);
+			continue;
+		}
+		//top and bottom rows, then the left and right columns without their corners
+		VisitCells(centerX - ring, centerY - ring, centerX + ring, centerY - ring, visitEntity);
+		VisitCells(centerX - ring, centerY + ring, centerX + ring, centerY + ring, visitEntity);
+		VisitCells(centerX - ring, centerY - ring + 1, centerX - ring, centerY + ring - 1, visitEntity);
+		VisitCells(centerX + ring, centerY - ring + 1, centerX + ring, centerY + ring - 1, visitEntity);
+	}
+	return pNearest;
+}
+#pragma endregion
@@ -30,10 +30,16 @@ using namespace std;
 #pragma endregion
 
 #pragma region //Third-Pary Includes
+#ifndef GPP_HEADLESS
 #include <GL/gl3w.h>
 #include <ImGui/imgui.h>
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_syswm.h>
+#else
+//headless builds have no window or renderer, only pull in what the interfaces need
+#include <Box2D/Common/b2Math.h>
+typedef unsigned int UINT;
+#endif
 
 #include "EliteMath/EMath.h"
 #include "EliteInput/EInputCodes.h"